@@ -0,0 +1,245 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN host bus model
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : bench_bus.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file bench_bus.c
+ *
+ * @brief Host model of a CAN bus joining controllers, in virtual time
+ *
+ * See \ref bench_bus.h.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "bench_bus.h"
+#include "ISCA_CAN_API.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if (BUS_RX_DEPTH & (BUS_RX_DEPTH - 1U)) != 0
+#error "BUS_RX_DEPTH must be a power of two"
+#endif
+
+/// Node state
+typedef struct bench_bus_node_s {
+	uint8_t     tx_busy;             /*!<TX buffer holds a frame*/
+	can_frame_s tx;                  /*!<TX buffer*/
+	can_frame_s rx[BUS_RX_DEPTH];    /*!<RX queue*/
+	uint32_t    rx_head;             /*!<Next frame read*/
+	uint32_t    rx_tail;             /*!<Next frame written*/
+} bench_bus_node_s;
+
+/******
+ * VARIABLES
+ ******/
+static can_ctrl_s        bus_ctrl[BUS_MAX_NODES];
+static bench_bus_node_s  bus_node[BUS_MAX_NODES];
+static bench_bus_stats_s bus_stats;
+static uint32_t          bus_nodes;
+static uint32_t          bus_now;  /*!<Virtual time, us*/
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static uint32_t bench_bus_arb(can_frame_s const *frame);
+
+/******
+ * DRIVER REPLACEMENTS
+ ******/
+uint32_t ISCA_TIME_Us(void) {
+
+	return bus_now;
+
+}
+
+int isca_can_transmit_frame(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint8_t req_type) {
+
+	bench_bus_node_s *node = &bus_node[can_ctrl - bus_ctrl];
+
+	(void)req_type;
+
+	if ( node->tx_busy ) {
+		return ISCA_CAN_BUSY;
+	}
+
+	node->tx      = *tx_frame;
+	node->tx_busy = 1U;
+
+	return ISCA_CAN_OK;
+}
+
+int lbr_isca_can_receive_pkt_tmo(can_ctrl_s *can_ctrl, can_frame_s *rx_pkt, uint32_t timeout_us) {
+
+	bench_bus_node_s *node = &bus_node[can_ctrl - bus_ctrl];
+
+	(void)timeout_us;
+
+	if ( node->rx_head == node->rx_tail ) {
+		return ISCA_CAN_TIMEOUT;
+	}
+
+	*rx_pkt = node->rx[node->rx_head++ & (BUS_RX_DEPTH - 1U)];
+
+	return ISCA_CAN_OK;
+}
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Empty the bus and reset virtual time and statistics
+ * @param[in]  n_nodes  Nodes on the bus, up to \ref BUS_MAX_NODES
+ */
+void bench_bus_init(uint32_t n_nodes) {
+
+	memset(bus_ctrl, 0, sizeof(bus_ctrl));
+	memset(bus_node, 0, sizeof(bus_node));
+	memset(&bus_stats, 0, sizeof(bus_stats));
+	bus_nodes = (n_nodes > BUS_MAX_NODES) ? BUS_MAX_NODES : n_nodes;
+	bus_now   = 0U;
+
+}
+
+/**
+ * @brief      Controller of a node
+ * @param[in]  n  Node index
+ * @return     Controller to hand to the driver's software layers
+ */
+can_ctrl_s *bench_bus_node(uint32_t n) {
+
+	return &bus_ctrl[n];
+
+}
+
+/**
+ * @brief      Bit times of a frame on the bus, without stuff bits
+ * @param[in]  frame  Frame
+ * @return     Bit times, i.e., us at 1 Mbit/s
+ */
+uint32_t bench_bus_frame_bits(can_frame_s const *frame) {
+
+	uint32_t dlc = (frame->DLC > 8U) ? 8U : frame->DLC;
+
+	if ( frame->RTR ) {
+		dlc = 0U;
+	} /*No data field*/
+
+	return ((frame->IDE == CAN_FRAME_EXT) ? BUS_EXT_BITS : BUS_STD_BITS) + 8U * dlc;
+}
+
+/**
+ * @brief      Send the frame winning arbitration, or idle one bit time
+ * @return     Bit times the frame took, 0 if the bus idled
+ */
+uint32_t bench_bus_step(void) {
+
+	bench_bus_node_s *node;
+	uint32_t win = BUS_MAX_NODES;
+	uint32_t bits;
+	uint32_t n;
+
+	for ( n = 0U; n < bus_nodes; n++ ) {
+		if ( bus_node[n].tx_busy &&
+		     (win == BUS_MAX_NODES || bench_bus_arb(&bus_node[n].tx) < bench_bus_arb(&bus_node[win].tx)) ) {
+			win = n;
+		}
+	} /*Arbitration*/
+
+	if ( win == BUS_MAX_NODES ) {
+		bus_now++;
+		return 0U;
+	} /*Idle*/
+
+	bits     = bench_bus_frame_bits(&bus_node[win].tx);
+	bus_now += bits;
+
+	for ( n = 0U; n < bus_nodes; n++ ) {
+
+		if ( n == win ) {
+			continue;
+		}
+
+		node = &bus_node[n];
+		if ( node->rx_tail - node->rx_head == BUS_RX_DEPTH ) {
+			bus_stats.overruns++;
+			continue;
+		} /*Overrun*/
+
+		node->rx[node->rx_tail++ & (BUS_RX_DEPTH - 1U)] = bus_node[win].tx;
+	} /*Every other node receives*/
+
+	bus_node[win].tx_busy = 0U;
+	bus_stats.frames++;
+	bus_stats.busy_us += bits;
+
+	return bits;
+}
+
+/**
+ * @brief      Bus statistics since \ref bench_bus_init
+ * @return     Statistics
+ */
+bench_bus_stats_s const *bench_bus_stats(void) {
+
+	return &bus_stats;
+
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Arbitration field as sent, lower wins: base ID, then SRR/IDE recessive for extended frames, then the ID extension*/
+static uint32_t bench_bus_arb(can_frame_s const *frame) {
+
+	if ( frame->IDE == CAN_FRAME_EXT ) {
+		return (((frame->ID >> 18) & 0x7FFU) << 19) | (1UL << 18) | (frame->ID & 0x3FFFFU);
+	}
+
+	return (frame->ID & 0x7FFU) << 19;
+}
@@ -0,0 +1,110 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN host bus model
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : bench_bus.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file bench_bus.h
+ *
+ * @brief Host model of a CAN bus joining controllers, in virtual time
+ *
+ * Links in place of the driver's \ref isca_can_transmit_frame,
+ * \ref lbr_isca_can_receive_pkt_tmo and \ref ISCA_TIME_Us, so the driver's
+ * software layers run unchanged on a host. Every node has a single TX
+ * buffer, as the controller, and an RX queue of \ref BUS_RX_DEPTH frames.
+ *
+ * \ref bench_bus_step sends one frame: the pending frame of the lowest
+ * arbitration field wins, takes its length in bit times at 1 Mbit/s,
+ * i.e., one bit per us of virtual time, and reaches every other node.
+ * Software takes no virtual time, so a benchmark measures the protocol
+ * against the bus alone. Frames are counted without stuff bits, i.e., the
+ * best case; worst-case stuffing adds up to 24 bits to an 8-byte frame.
+ *
+ * Non-blocking calls only: requests are not queued and timeouts are ignored.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef BENCH_BUS_H
+#define BENCH_BUS_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#ifndef BUS_MAX_NODES
+#define BUS_MAX_NODES     (4U)    /*!<Nodes on the bus*/
+#endif
+
+#ifndef BUS_RX_DEPTH
+#define BUS_RX_DEPTH      (256U)  /*!<RX queue frames per node, a power of two*/
+#endif
+
+#define BUS_STD_BITS      (47U)   /*!<Bits of a base frame without data, stuffing and with a 3-bit interframe space*/
+#define BUS_EXT_BITS      (67U)   /*!<Bits of an extended frame without data, as above*/
+
+/// Bus statistics
+typedef struct bench_bus_stats_s {
+	uint32_t frames;     /*!<Frames sent*/
+	uint32_t busy_us;    /*!<Bus time spent sending*/
+	uint32_t overruns;   /*!<Frames lost to a full RX queue*/
+} bench_bus_stats_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void bench_bus_init(uint32_t n_nodes);
+
+can_ctrl_s *bench_bus_node(uint32_t n);
+
+uint32_t bench_bus_frame_bits(can_frame_s const *frame);
+
+uint32_t bench_bus_step(void);
+
+bench_bus_stats_s const *bench_bus_stats(void);
+
+#endif /* BENCH_BUS_H */
@@ -0,0 +1,287 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA MPMC queue benchmark
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : bench_mpmc.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file bench_mpmc.c
+ *
+ * @brief Host benchmark of \ref ISCA_MPMC_QUEUE.h against a mutex
+ * protected ring
+ *
+ * 1 to 8 producer threads push frames that as many consumer threads pop,
+ * through a queue of \ref BENCH_Q_SIZE cells, first the lock-free MPMC
+ * queue, then a ring guarded by a pthread mutex. Every frame carries a
+ * unique number; the run fails unless each one is popped exactly once.
+ *
+ * Usage: bench_mpmc [frames per run]
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note Timings are only meaningful on a host with at least twice as many
+ * cores as threads; on fewer cores they measure the OS scheduler
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_MPMC_QUEUE.h"
+#include "ISCA_QUEUE_INDEXER.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define BENCH_Q_SIZE      (1024U)    /*!<Queue cells, a power of two*/
+#define BENCH_FRAMES      (2000000U) /*!<Default frames per run*/
+#define BENCH_MAX_THREADS (8U)       /*!<Most producers, and consumers*/
+
+/// Queue under test
+typedef struct bench_q_s {
+	const char *name;
+	void (*init)(void);
+	int  (*push)(can_cframe_s const *frame);
+	int  (*pop)(can_cframe_s *frame);
+} bench_q_s;
+
+/// Thread work
+typedef struct bench_job_s {
+	bench_q_s const *q;
+	uint32_t first;    /*!<First frame number, producers*/
+	uint32_t count;    /*!<Frames to push or pop*/
+	uint64_t sum;      /*!<Sum of the frame numbers popped, consumers*/
+} bench_job_s;
+
+/******
+ * VARIABLES
+ ******/
+static isca_mpmc_cell_s mpmc_cells[BENCH_Q_SIZE];
+static isca_mpmc_s mpmc;
+
+static can_cframe_s mtx_ring[BENCH_Q_SIZE];
+static uint32_t mtx_head;
+static uint32_t mtx_tail;
+static pthread_mutex_t mtx = PTHREAD_MUTEX_INITIALIZER;
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+static void mpmc_init(void) {
+
+	isca_mpmc_init(&mpmc, mpmc_cells, BENCH_Q_SIZE);
+
+}
+
+static int mpmc_push(can_cframe_s const *frame) {
+
+	return isca_mpmc_push(&mpmc, frame);
+
+}
+
+static int mpmc_pop(can_cframe_s *frame) {
+
+	return isca_mpmc_pop(&mpmc, frame);
+
+}
+
+static void mtx_init(void) {
+
+	mtx_head = 0U;
+	mtx_tail = 0U;
+
+}
+
+static int mtx_push(can_cframe_s const *frame) {
+
+	int ret = DQ_FULL;
+
+	pthread_mutex_lock(&mtx);
+	if ( mtx_head - mtx_tail < BENCH_Q_SIZE ) {
+		mtx_ring[mtx_head++ & (BENCH_Q_SIZE - 1U)] = *frame;
+		ret = DQ_OK;
+	}
+	pthread_mutex_unlock(&mtx);
+
+	return ret;
+}
+
+static int mtx_pop(can_cframe_s *frame) {
+
+	int ret = DQ_EMPTY;
+
+	pthread_mutex_lock(&mtx);
+	if ( mtx_head != mtx_tail ) {
+		*frame = mtx_ring[mtx_tail++ & (BENCH_Q_SIZE - 1U)];
+		ret = DQ_OK;
+	}
+	pthread_mutex_unlock(&mtx);
+
+	return ret;
+}
+
+static const bench_q_s queues[] = {
+	{ "mpmc",  mpmc_init, mpmc_push, mpmc_pop },
+	{ "mutex", mtx_init,  mtx_push,  mtx_pop  },
+};
+
+static void *producer(void *arg) {
+
+	bench_job_s *job = (bench_job_s *)arg;
+	can_cframe_s frame;
+	uint32_t i;
+
+	memset(&frame, 0, sizeof(frame));
+	frame.dlc = 8U;
+
+	for ( i = 0U; i < job->count; i++ ) {
+		frame.hdr = job->first + i;
+		memcpy(frame.data, &frame.hdr, sizeof(frame.hdr));
+		while ( job->q->push(&frame) != DQ_OK ) {
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+static void *consumer(void *arg) {
+
+	bench_job_s *job = (bench_job_s *)arg;
+	can_cframe_s frame;
+	uint32_t i;
+	uint32_t n;
+
+	for ( i = 0U; i < job->count; i++ ) {
+		while ( job->q->pop(&frame) != DQ_OK ) {
+			sched_yield();
+		}
+		memcpy(&n, frame.data, sizeof(n));
+		if ( n != frame.hdr ) {
+			job->sum = ~(uint64_t)0;
+			return NULL;
+		} /*Torn frame*/
+		job->sum += n;
+	}
+
+	return NULL;
+}
+
+/*Run threads producers and threads consumers over frames frames; returns
+ *the time taken in seconds, negative if a frame was lost or duplicated*/
+static double run(bench_q_s const *q, uint32_t threads, uint32_t frames) {
+
+	pthread_t prod[BENCH_MAX_THREADS];
+	pthread_t cons[BENCH_MAX_THREADS];
+	bench_job_s pjob[BENCH_MAX_THREADS];
+	bench_job_s cjob[BENCH_MAX_THREADS];
+	struct timespec t0;
+	struct timespec t1;
+	uint64_t sum = 0U;
+	uint32_t per = frames / threads;
+	uint32_t i;
+
+	q->init();
+	memset(pjob, 0, sizeof(pjob));
+	memset(cjob, 0, sizeof(cjob));
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+
+	for ( i = 0U; i < threads; i++ ) {
+		pjob[i].q     = q;
+		pjob[i].first = 1U + i * per;
+		pjob[i].count = per;
+		cjob[i].q     = q;
+		cjob[i].count = per;
+		pthread_create(&cons[i], NULL, consumer, &cjob[i]);
+		pthread_create(&prod[i], NULL, producer, &pjob[i]);
+	}
+
+	for ( i = 0U; i < threads; i++ ) {
+		pthread_join(prod[i], NULL);
+		pthread_join(cons[i], NULL);
+		sum += cjob[i].sum;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	frames = per * threads;
+	if ( sum != (uint64_t)frames * (frames + 1U) / 2U ) {
+		return -1.0;
+	} /*Frame numbers 1 to frames, each popped once*/
+
+	return (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+}
+
+/******
+ * MAIN
+ ******/
+int main(int argc, char *argv[]) {
+
+	uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_FRAMES;
+	uint32_t threads;
+	uint32_t k;
+	double   secs;
+	int      fail = 0;
+
+	printf("%-6s %8s %12s %10s\n", "queue", "threads", "Mframes/s", "ns/frame");
+
+	for ( threads = 1U; threads <= BENCH_MAX_THREADS; threads <<= 1 ) {
+		for ( k = 0U; k < sizeof(queues) / sizeof(queues[0]); k++ ) {
+
+			secs = run(&queues[k], threads, frames);
+			if ( secs < 0.0 ) {
+				printf("%-6s %8u FAILED: frames lost or duplicated\n", queues[k].name, threads);
+				fail = 1;
+				continue;
+			}
+
+			printf("%-6s %8u %12.2f %10.1f\n", queues[k].name, threads,
+			       frames / secs * 1e-6, secs * 1e9 / frames);
+		}
+	}
+
+	return fail;
+}
@@ -0,0 +1,231 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA ISO-TP throughput benchmark
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : bench_tp.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file bench_tp.c
+ *
+ * @brief Host benchmark of \ref ISCA_CAN_TP.h against the bus limit
+ *
+ * Two endpoints on the \ref bench_bus.h model exchange messages over one
+ * or more concurrent sessions. Every transfer is verified byte for byte
+ * and goodput, i.e., message bytes over bus time, is reported against two
+ * limits at 1 Mbit/s: the bus payload limit of back-to-back 8-byte base
+ * frames, 64 of 111 bits, and the ISO-TP limit of consecutive frames
+ * carrying 7 of those 8 bytes. A block size of BS costs one flow control
+ * frame per BS consecutive frames. Fails if a transfer of 4 KiB or more,
+ * with neither block size nor STmin, stays under 95% of the ISO-TP limit.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "bench_bus.h"
+#include "ISCA_CAN_TP.h"
+#include "ISCA_CAN_API.h"
+#include <stdio.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define BENCH_SESS        (4U)          /*!<Concurrent sessions, at most*/
+#define BENCH_MSG_MAX     (65536U)      /*!<Message bytes, at most*/
+#define BENCH_TMO_US      (60000000U)   /*!<Virtual time a run may take*/
+#define BENCH_MIN_EFF     (95U)         /*!<Goodput floor without BS and STmin, % of the ISO-TP limit*/
+#define BENCH_STD8_BITS   (BUS_STD_BITS + 64U)
+
+/// Benchmark run
+typedef struct bench_run_s {
+	uint32_t n_sess;     /*!<Concurrent sessions*/
+	uint32_t len;        /*!<Message bytes per session*/
+	uint8_t  bs;         /*!<Block size granted*/
+	uint8_t  stmin;      /*!<STmin granted*/
+} bench_run_s;
+
+/// Session outcome
+typedef struct bench_done_s {
+	uint8_t  tx_done;    /*!<Sender reported*/
+	uint8_t  rx_done;    /*!<Receiver reported*/
+	int      tx_res;     /*!<Sender result*/
+	int      rx_res;     /*!<Receiver result*/
+	uint32_t rx_len;     /*!<Bytes received*/
+} bench_done_s;
+
+/******
+ * VARIABLES
+ ******/
+static isca_tp_s      tp_a;
+static isca_tp_s      tp_b;
+static isca_tp_sess_s sess_a[BENCH_SESS];
+static isca_tp_sess_s sess_b[BENCH_SESS];
+static bench_done_s   done[BENCH_SESS];
+static uint8_t        msg[BENCH_SESS][BENCH_MSG_MAX];
+static uint8_t        buf[BENCH_SESS][BENCH_MSG_MAX];
+
+static bench_run_s const runs[] = {
+	{ 1U,     7U, 0U, 0U },
+	{ 1U,  4095U, 0U, 0U },
+	{ 1U, 65536U, 0U, 0U },
+	{ 1U, 65536U, 8U, 0U },
+	{ 4U, 16384U, 8U, 0U },
+	{ 1U,  4095U, 0U, 1U },
+};
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Transfer done callback*/
+static void bench_cb(isca_tp_sess_s *sess, uint8_t event, int res, uint32_t len) {
+
+	bench_done_s *d = (bench_done_s *)sess->arg;
+
+	if ( event == ISCA_TP_EV_TX_DONE ) {
+		d->tx_done = 1U;
+		d->tx_res  = res;
+	}
+	else {
+		d->rx_done = 1U;
+		d->rx_res  = res;
+		d->rx_len  = len;
+	}
+
+}
+
+/*Run one transfer set to completion; 0 on success*/
+static int bench_run(bench_run_s const *run, uint32_t *us) {
+
+	uint32_t t0;
+	uint32_t s;
+	uint32_t i;
+	uint32_t left;
+
+	bench_bus_init(2U);
+	isca_tp_init(&tp_a, bench_bus_node(0U));
+	isca_tp_init(&tp_b, bench_bus_node(1U));
+	memset(done, 0, sizeof(done));
+
+	for ( s = 0U; s < run->n_sess; s++ ) {
+
+		isca_tp_sess_init(&sess_a[s], 0x700U + s, 0x780U + s, CAN_FRAME_STD, bench_cb, &done[s]);
+		isca_tp_sess_init(&sess_b[s], 0x780U + s, 0x700U + s, CAN_FRAME_STD, bench_cb, &done[s]);
+		sess_b[s].bs    = run->bs;
+		sess_b[s].stmin = run->stmin;
+
+		if ( isca_tp_open(&tp_a, &sess_a[s]) != ISCA_CAN_OK || isca_tp_open(&tp_b, &sess_b[s]) != ISCA_CAN_OK ) {
+			return -1;
+		}
+
+		for ( i = 0U; i < run->len; i++ ) {
+			msg[s][i] = (uint8_t)(i * 7U + s);
+		}
+		memset(buf[s], 0, run->len);
+		isca_tp_recv(&sess_b[s], buf[s], BENCH_MSG_MAX);
+	}
+
+	t0 = ISCA_TIME_Us();
+	for ( s = 0U; s < run->n_sess; s++ ) {
+		if ( isca_tp_send(&sess_a[s], msg[s], run->len) != ISCA_CAN_OK ) {
+			return -1;
+		}
+	}
+
+	do {
+		isca_tp_poll(&tp_a, 64U);
+		isca_tp_poll(&tp_b, 64U);
+		bench_bus_step();
+
+		left = 0U;
+		for ( s = 0U; s < run->n_sess; s++ ) {
+			left += (done[s].tx_done && done[s].rx_done) ? 0U : 1U;
+		}
+	} while ( left != 0U && ISCA_TIME_Us() - t0 < BENCH_TMO_US );
+
+	*us = ISCA_TIME_Us() - t0;
+
+	for ( s = 0U; s < run->n_sess; s++ ) {
+		if ( !done[s].tx_done || !done[s].rx_done || done[s].tx_res != ISCA_CAN_OK || done[s].rx_res != ISCA_CAN_OK ||
+		     done[s].rx_len != run->len || memcmp(msg[s], buf[s], run->len) != 0 ) {
+			return -1;
+		}
+	}
+
+	return (bench_bus_stats()->overruns == 0U) ? 0 : -1;
+}
+
+/******
+ * MAIN
+ ******/
+int main(void) {
+
+	double bus_kbps = 64000.0 / BENCH_STD8_BITS;
+	double tp_kbps  = 56000.0 / BENCH_STD8_BITS;
+	double kbps;
+	uint32_t us;
+	uint32_t r;
+
+	printf("bus payload limit %.1f kbit/s, ISO-TP limit %.1f kbit/s, 1 Mbit/s, no stuff bits\n", bus_kbps, tp_kbps);
+	printf("sess    bytes  bs stmin   frames    bus ms   kbit/s  %%bus  %%iso-tp\n");
+
+	for ( r = 0U; r < sizeof(runs) / sizeof(runs[0]); r++ ) {
+
+		if ( bench_run(&runs[r], &us) != 0 ) {
+			printf("FAILED: run %u, transfer incomplete or corrupted\n", r);
+			return 1;
+		}
+
+		kbps = (double)runs[r].n_sess * runs[r].len * 8000.0 / us;
+		printf("%4u %8u %3u %5u %8u %9.2f %8.1f %5.1f %8.1f\n",
+		       runs[r].n_sess, runs[r].len, runs[r].bs, runs[r].stmin, bench_bus_stats()->frames,
+		       us / 1000.0, kbps, 100.0 * kbps / bus_kbps, 100.0 * kbps / tp_kbps);
+
+		if ( runs[r].bs == 0U && runs[r].stmin == 0U && runs[r].len >= 4096U && kbps * 100.0 < tp_kbps * BENCH_MIN_EFF ) {
+			printf("FAILED: run %u under %u%% of the ISO-TP limit\n", r, BENCH_MIN_EFF);
+			return 1;
+		}
+	}
+
+	return 0;
+}
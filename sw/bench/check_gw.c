@@ -0,0 +1,222 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN-to-CAN gateway check
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : check_gw.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file check_gw.c
+ *
+ * @brief Host check of the routing engine of \ref ISCA_CAN_GW.h and its
+ * destination TX queues
+ *
+ * Checks that the first matching rule wins whether it is an exact or a
+ * masked 29-bit rule, that a gateway with 32 destinations accepts rules
+ * naming the last one, and that a routed burst drains completely through
+ * the destination controller's TX hook, with no later frame routed to push
+ * its tail out. The controllers are stubs with a single TX buffer that the
+ * check releases, as the bus would, and then runs the TX hook, as the
+ * interrupt bottom half would.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_GW.h"
+#include <stdio.h>
+#include <string.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define CHECK_DST        (32U)  /*!<Destination controllers*/
+#define CHECK_BURST      (12U)  /*!<Frames routed back to back*/
+#define CHECK(c, msg)    do { if ( !(c) ) { printf("FAILED: %s\n", msg); return 1; } } while (0)
+
+/// Stub controller state
+typedef struct check_ctrl_s {
+	uint8_t  busy;       /*!<TX buffer holds a frame*/
+	uint32_t sent;       /*!<Frames written*/
+	uint32_t last_id;    /*!<ID of the frame last written*/
+} check_ctrl_s;
+
+/******
+ * VARIABLES
+ ******/
+static can_ctrl_s   ctrl[CHECK_DST + 1U];  /*!<Destinations, then the source*/
+static check_ctrl_s st[CHECK_DST + 1U];
+static isca_txq_s   txq[CHECK_DST];
+static isca_txq_item_s items[CHECK_DST][CHECK_BURST + 1U];
+static isca_gw_s    gw;
+
+/******
+ * CONTROLLER STUBS
+ ******/
+uint32_t ISCA_TIME_Us(void) {
+
+	return 0U;
+
+}
+
+uint8_t isca_can_tx_status(can_ctrl_s *can_ctrl) {
+
+	return st[can_ctrl - ctrl].busy ? 0U : (CAN_TX_ST_BUF_FREE | CAN_TX_ST_COMPLETE);
+
+}
+
+int isca_can_transmit_frame(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint8_t req_type) {
+
+	check_ctrl_s *c = &st[can_ctrl - ctrl];
+
+	(void)req_type;
+
+	if ( c->busy ) {
+		return ISCA_CAN_BUSY;
+	}
+
+	c->busy    = 1U;
+	c->last_id = tx_frame->ID;
+	c->sent++;
+
+	return ISCA_CAN_OK;
+}
+
+void isca_can_abort_tx(can_ctrl_s *can_ctrl) {
+
+	(void)can_ctrl;
+
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Offer a frame to the source controller's RX hook*/
+static int check_rx(can_ctrl_s *src, uint32_t id, uint8_t ide) {
+
+	can_frame_s frame;
+
+	memset(&frame, 0, sizeof(frame));
+	frame.ID  = id;
+	frame.IDE = ide;
+	frame.DLC = 8U;
+
+	return src->rx_hook(src, &frame, 0U, src->rx_hook_arg);
+}
+
+/*The bus sends the frame in the TX buffer; the bottom half runs the TX hook*/
+static void check_tx_done(uint32_t d) {
+
+	st[d].busy = 0U;
+	if ( ctrl[d].tx_hook != NULL ) {
+		ctrl[d].tx_hook(&ctrl[d], ctrl[d].tx_hook_arg);
+	}
+
+}
+
+/******
+ * MAIN
+ ******/
+int main(void) {
+
+	isca_txq_s *dst[CHECK_DST];
+	isca_gw_rule_s rules[4];
+	can_ctrl_s *src = &ctrl[CHECK_DST];
+	uint32_t i;
+
+	for ( i = 0U; i < CHECK_DST; i++ ) {
+		isca_txq_init(&txq[i], &ctrl[i], items[i], CHECK_BURST + 1U, ISCA_TXQ_PREEMPT_OFF);
+		dst[i] = &txq[i];
+	}
+
+	isca_gw_init(&gw, dst, CHECK_DST);
+	CHECK(isca_gw_attach(&gw, src) == 0, "attach");
+	CHECK(ctrl[CHECK_DST - 1U].tx_hook == &isca_txq_tx_hook, "destination TX hook installed");
+
+	memset(rules, 0, sizeof(rules));
+	rules[0].ide = CAN_FRAME_EXT; rules[0].id = 0x18FF0000U; rules[0].mask = 0x1FFF0000U; rules[0].dst_set = 1UL << 0;
+	rules[1].ide = CAN_FRAME_EXT; rules[1].id = 0x18FF1234U; rules[1].mask = 0x1FFFFFFFU; rules[1].dst_set = 1UL << 1;
+	rules[2].ide = CAN_FRAME_EXT; rules[2].id = 0x0CF00400U; rules[2].mask = 0x1FFFFFFFU; rules[2].dst_set = 1UL << 2;
+	rules[3].ide = CAN_FRAME_EXT; rules[3].id = 0x0CF00000U; rules[3].mask = 0x1FFF0000U; rules[3].dst_set = 1UL << 31;
+
+	CHECK(isca_gw_compile(&gw, rules, 4U) == ISCA_CAN_OK, "rule naming destination 31 of 32 rejected");
+
+	CHECK(check_rx(src, 0x18FF1234U, CAN_FRAME_EXT) == 1 && st[0].sent == 1U && st[1].sent == 0U,
+	      "earlier masked rule must beat a later exact rule");
+	CHECK(check_rx(src, 0x0CF00400U, CAN_FRAME_EXT) == 1 && st[2].sent == 1U && st[31].sent == 0U,
+	      "earlier exact rule must beat a later masked rule");
+	CHECK(check_rx(src, 0x0CF0AAAAU, CAN_FRAME_EXT) == 1 && st[31].sent == 1U, "masked rule");
+	CHECK(check_rx(src, 0x00000001U, CAN_FRAME_EXT) == 0, "unrouted frame consumed");
+
+	rules[0].dst_set = 1UL << 0;
+	isca_gw_init(&gw, dst, 31U);
+	isca_gw_attach(&gw, src);
+	CHECK(isca_gw_compile(&gw, rules, 4U) == ISCA_GW_INV_RULE, "rule naming an unknown destination accepted");
+
+	memset(st, 0, sizeof(st));
+	for ( i = 0U; i < CHECK_DST; i++ ) {
+		isca_txq_init(&txq[i], &ctrl[i], items[i], CHECK_BURST + 1U, ISCA_TXQ_PREEMPT_OFF);
+	}
+	isca_gw_init(&gw, dst, CHECK_DST);
+	isca_gw_attach(&gw, src);
+	isca_gw_compile(&gw, rules, 4U);
+
+	for ( i = 0U; i < CHECK_BURST; i++ ) {
+		check_rx(src, 0x18FF0000U + i, CAN_FRAME_EXT);
+	} /*Back to back; only the first finds the TX buffer free*/
+
+	CHECK(st[0].sent == 1U, "burst head");
+
+	for ( i = 1U; i < CHECK_BURST; i++ ) {
+		check_tx_done(0U);
+		CHECK(st[0].sent == i + 1U && st[0].last_id == 0x18FF0000U + i, "burst not drained by the TX hook in order");
+	}
+
+	check_tx_done(0U);
+	CHECK(txq[0].count == 0U && txq[0].stats.sent == CHECK_BURST, "burst tail left queued");
+	CHECK(isca_gw_stats(&gw, 0U)->forwarded == CHECK_BURST && isca_gw_stats(&gw, 0U)->dropped == 0U, "statistics");
+
+	printf("gateway: rule priority, 32 destinations, burst drained by the TX hook: ok\n");
+
+	return 0;
+}
@@ -0,0 +1,330 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA frame pool check
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : check_pool.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file check_pool.c
+ *
+ * @brief Host check of the buddy allocator of \ref ISCA_FRAME_POOL.h
+ *
+ * Random allocations and releases of 1 to 64 frames; every block is
+ * filled with its owner's tag and verified on release, so overlapping
+ * blocks are caught. Once all blocks are back the pool must hand out a
+ * single block of all \ref FRAME_POOL_FRAMES frames again, i.e., every
+ * buddy was merged.
+ *
+ * Then a controller goes through init, stop, init, stop, init and
+ * deinit; its RX queue storage must be held once at a time and the pool
+ * whole again at the end. The controller's register level functions are
+ * stubs.
+ *
+ * Usage: check_pool [iterations]
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_FRAME_POOL.h"
+#include "ISCA_CAN_API.h"
+#include "ISCA_CAN_IRQ.h"
+#include <stdio.h>
+#include <string.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define CHECK_BLOCKS     (32U)     /*!<Blocks held at once, at most*/
+#define CHECK_ITER       (200000U) /*!<Default iterations*/
+#define CHECK_Q_SLOTS    (64U)     /*!<RX queue slots of the controller*/
+
+/// Block held by the check
+typedef struct check_blk_s {
+	can_cframe_s *ptr;
+	uint32_t frames;   /*!<Frames asked for*/
+	uint32_t tag;
+} check_blk_s;
+
+/******
+ * VARIABLES
+ ******/
+static check_blk_s held[CHECK_BLOCKS];
+static uint32_t rnd = 0x12345678U;
+static can_ctrl_s ctrl;
+
+/******
+ * CONTROLLER STUBS
+ ******/
+uint32_t ISCA_TIME_Us(void) {
+
+	return 0U;
+
+}
+
+void ISCA_CAN_IntrHandler(void *can_ctrl) {
+
+	(void)can_ctrl;
+
+}
+
+uint32_t isca_can_bh_run(can_ctrl_s *can_ctrl, uint32_t budget) {
+
+	(void)can_ctrl; (void)budget;
+
+	return 0U;
+}
+
+int isca_can_init(can_ctrl_s *can_ctrl) {
+
+	(void)can_ctrl;
+
+	return ISCA_CAN_OK;
+}
+
+int isca_can_switch_mode(can_ctrl_s *can_ctrl, uint8_t reset_mode) {
+
+	(void)can_ctrl; (void)reset_mode;
+
+	return 0;
+}
+
+void isca_can_rx_irq_enable(can_ctrl_s *can_ctrl, uint8_t irq) {
+
+	(void)can_ctrl; (void)irq;
+
+}
+
+int isca_can_receive_frame(can_ctrl_s *can_ctrl, can_frame_s *rx_frame, uint8_t req_type) {
+
+	(void)can_ctrl; (void)rx_frame; (void)req_type;
+
+	return ISCA_CAN_BUSY;
+}
+
+int isca_can_transmit_frame(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint8_t req_type) {
+
+	(void)can_ctrl; (void)tx_frame; (void)req_type;
+
+	return ISCA_CAN_OK;
+}
+
+int isca_can_transmit_frame_dl(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint32_t deadline) {
+
+	(void)can_ctrl; (void)tx_frame; (void)deadline;
+
+	return ISCA_CAN_OK;
+}
+
+int isca_can_tx_wait_done(can_ctrl_s *can_ctrl, uint32_t deadline) {
+
+	(void)can_ctrl; (void)deadline;
+
+	return ISCA_CAN_OK;
+}
+
+int isca_can_transmit_img(can_ctrl_s *can_ctrl, can_tx_img_s const *tx_img, uint8_t req_type) {
+
+	(void)can_ctrl; (void)tx_img; (void)req_type;
+
+	return ISCA_CAN_OK;
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+static uint32_t check_rand(void) {
+
+	rnd ^= rnd << 13;
+	rnd ^= rnd >> 17;
+	rnd ^= rnd << 5;
+
+	return rnd;
+}
+
+/*Rounded up block size in frames*/
+static uint32_t check_order(uint32_t frames) {
+
+	uint32_t n = 1U;
+
+	while ( n < frames ) {
+		n <<= 1;
+	}
+
+	return n;
+}
+
+static int check_release(check_blk_s *b) {
+
+	uint32_t i;
+
+	for ( i = 0U; i < b->frames; i++ ) {
+		if ( b->ptr[i].hdr != b->tag + i ) {
+			printf("block %p frame %u overwritten\n", (void *)b->ptr, i);
+			return 1;
+		}
+	}
+
+	isca_frame_pool_free(b->ptr);
+	b->ptr = NULL;
+
+	return 0;
+}
+
+/*Pool whole: nothing in use and a single block of all frames*/
+static int check_whole(void) {
+
+	isca_frame_pool_stats_s st;
+	can_cframe_s *all;
+
+	isca_frame_pool_stats(&st);
+	all = isca_frame_pool_alloc(FRAME_POOL_FRAMES);
+
+	if ( st.in_use != 0U || all == NULL ) {
+		printf("pool not whole after release: in_use %u\n", st.in_use);
+		return 1;
+	}
+	isca_frame_pool_free(all);
+
+	return 0;
+}
+
+/*Controller re-initialized, stopped or not, holds a single RX queue block*/
+static int check_reinit(void) {
+
+	isca_frame_pool_stats_s st;
+	uint32_t n;
+
+	ctrl.can_mode = CAN_2A;
+	ctrl.irq      = CAN_IRQ_OFF;
+
+	for ( n = 0U; n < 3U; n++ ) {
+
+		if ( lbr_isca_can_init(&ctrl, CHECK_Q_SLOTS) != ISCA_CAN_OK ) {
+			printf("init %u failed\n", n);
+			return 1;
+		}
+
+		isca_frame_pool_stats(&st);
+		if ( st.in_use != CHECK_Q_SLOTS ) {
+			printf("init %u after stop: in_use %u, expected %u\n", n, st.in_use, CHECK_Q_SLOTS);
+			return 1;
+		}
+
+		if ( n < 2U ) {
+			lbr_isca_can_stop(&ctrl);
+		}
+	}
+
+	lbr_isca_can_deinit(&ctrl);
+
+	return check_whole();
+}
+
+/******
+ * MAIN
+ ******/
+int main(int argc, char *argv[]) {
+
+	uint32_t iter = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : CHECK_ITER;
+	isca_frame_pool_stats_s st;
+	check_blk_s *b;
+	uint32_t in_use = 0U;
+	uint32_t granted = 0U;
+	uint32_t n;
+	uint32_t i;
+
+	for ( n = 0U; n < iter; n++ ) {
+
+		b = &held[check_rand() % CHECK_BLOCKS];
+
+		if ( b->ptr != NULL ) {
+			in_use -= check_order(b->frames);
+			if ( check_release(b) != 0 ) {
+				return 1;
+			}
+			continue;
+		}
+
+		b->frames = 1U + check_rand() % 64U;
+		b->ptr    = isca_frame_pool_alloc(b->frames);
+		if ( b->ptr == NULL ) {
+			continue;
+		} /*Exhausted or fragmented; may happen*/
+
+		if ( b->frames >= 4U && ((size_t)b->ptr % CACHE_LINE_SIZE) != 0U ) {
+			printf("block %p of %u frames not cache line aligned\n", (void *)b->ptr, b->frames);
+			return 1;
+		}
+
+		b->tag = check_rand();
+		for ( i = 0U; i < b->frames; i++ ) {
+			b->ptr[i].hdr = b->tag + i;
+		}
+		in_use += check_order(b->frames);
+		granted++;
+
+		isca_frame_pool_stats(&st);
+		if ( st.in_use != in_use ) {
+			printf("in_use %u, expected %u\n", st.in_use, in_use);
+			return 1;
+		}
+	}
+
+	for ( i = 0U; i < CHECK_BLOCKS; i++ ) {
+		if ( held[i].ptr != NULL && check_release(&held[i]) != 0 ) {
+			return 1;
+		}
+	}
+
+	isca_frame_pool_stats(&st);
+	if ( check_whole() != 0 || check_reinit() != 0 ) {
+		return 1;
+	}
+
+	printf("frame pool: %u allocations, high water %u of %u frames, %u refused, controller re-init: ok\n",
+	       granted, st.high_water, st.size, st.failed);
+
+	return 0;
+}
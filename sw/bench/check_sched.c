@@ -0,0 +1,209 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA cyclic TX scheduler check
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : check_sched.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file check_sched.c
+ *
+ * @brief Host check of the timer wheel of \ref ISCA_CAN_SCHED.h
+ *
+ * Frames with periods covering all wheel levels run across a 32-bit tick
+ * wrap. With the TX buffer always free, every frame must leave exactly at
+ * offset + k * period. With the TX buffer busy on some ticks, releases
+ * must add up to frames sent, missed and pending. A removed frame must
+ * never be sent again. The controller is replaced by stubs that record
+ * the frames written.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_SCHED.h"
+#include <stdio.h>
+#include <string.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define CHECK_T0         (0xFFFF0000U) /*!<First tick, wraps soon*/
+#define CHECK_TICKS      (600000U)     /*!<Ticks per phase*/
+
+/******
+ * VARIABLES
+ ******/
+static const uint32_t period[] = { 1U, 7U, 64U, 100U, 4095U, 4096U, 5000U, 70000U, 262143U };
+static const uint32_t offset[] = { 0U, 3U, 0U,  63U,  1U,    4095U, 4999U, 12345U, 262143U };
+
+#define CHECK_FRAMES     (sizeof(period) / sizeof(period[0]))
+
+static isca_sched_entry_s entry[CHECK_FRAMES];
+static uint32_t next_tx[CHECK_FRAMES];   /*!<Tick the frame is expected on next*/
+static uint8_t  removed[CHECK_FRAMES];
+static uint32_t tick;
+static int      tx_busy;
+static int      strict;                  /*!<Check the send ticks*/
+static int      errors;
+
+/******
+ * CONTROLLER STUBS
+ ******/
+int isca_can_tx_img_compile(can_ctrl_s const *can_ctrl, can_tx_img_s *tx_img, can_frame_s const *tx_frame) {
+
+	(void)can_ctrl;
+	memset(tx_img, 0, sizeof(can_tx_img_s));
+	tx_img->data[0] = (uint8_t)tx_frame->ID;
+	tx_img->hdr_len = 1U;
+	tx_img->len     = 1U;
+
+	return ISCA_CAN_OK;
+}
+
+int isca_can_tx_img_payload(can_tx_img_s *tx_img, uint8_t const *data, uint8_t len) {
+
+	(void)tx_img;
+	(void)data;
+
+	return (len == 0U) ? ISCA_CAN_OK : ISCA_CAN_INV_DLC;
+}
+
+int isca_can_transmit_img(can_ctrl_s *can_ctrl, can_tx_img_s const *tx_img, uint8_t req_type) {
+
+	uint8_t i = tx_img->data[0];
+
+	(void)can_ctrl;
+	(void)req_type;
+
+	if ( tx_busy ) {
+		return ISCA_CAN_BUSY;
+	}
+
+	if ( i >= CHECK_FRAMES || removed[i] || (strict && tick != next_tx[i]) ) {
+		if ( errors++ < 10 ) {
+			printf("frame %u sent on tick %u, expected on %u\n", i, tick - CHECK_T0, next_tx[i] - CHECK_T0);
+		}
+	}
+	next_tx[i] += period[i];
+
+	return ISCA_CAN_OK;
+}
+
+/******
+ * MAIN
+ ******/
+int main(void) {
+
+	isca_sched_s sched;
+	can_ctrl_s   can_ctrl;
+	can_frame_s  frame;
+	uint32_t releases;
+	uint32_t expected;
+	uint32_t t;
+	uint32_t i;
+
+	memset(&can_ctrl, 0, sizeof(can_ctrl));
+	memset(&frame, 0, sizeof(frame));
+	isca_sched_init(&sched, &can_ctrl, CHECK_T0);
+	strict = 1;
+
+	for ( i = 0U; i < CHECK_FRAMES; i++ ) {
+		frame.ID   = i;
+		next_tx[i] = CHECK_T0 + offset[i];
+		if ( isca_sched_add(&sched, &entry[i], &frame, period[i], offset[i]) != ISCA_CAN_OK ) {
+			printf("frame %u rejected\n", i);
+			return 1;
+		}
+	}
+
+	for ( t = 0U; t < CHECK_TICKS; t++ ) {
+		tick = CHECK_T0 + t;
+		isca_sched_run(&sched, tick);
+	} /*Phase 1: TX buffer always free, every release on time*/
+
+	for ( i = 0U; i < CHECK_FRAMES; i++ ) {
+		if ( entry[i].stats.sent != (CHECK_TICKS - 1U - offset[i]) / period[i] + 1U || entry[i].stats.misses != 0U ) {
+			printf("frame %u: sent %u, missed %u\n", i, entry[i].stats.sent, entry[i].stats.misses);
+			errors++;
+		}
+		memset(&entry[i].stats, 0, sizeof(isca_sched_stats_s));
+	}
+
+	isca_sched_remove(&sched, &entry[2]);
+	removed[2] = 1U;
+	strict = 0;
+
+	for ( t = 0U; t < CHECK_TICKS; t++ ) {
+		tick++;
+		tx_busy = ((tick / 3U) % 5U) == 0U;
+		isca_sched_run(&sched, tick);
+	} /*Phase 2: TX buffer busy one tick triplet out of five*/
+
+	for ( i = 0U; i < CHECK_FRAMES; i++ ) {
+		if ( removed[i] ) {
+			continue;
+		}
+		releases = entry[i].stats.sent + entry[i].stats.misses + entry[i].pending;
+		expected = (2U * CHECK_TICKS - 1U - offset[i]) / period[i] - (CHECK_TICKS - 1U - offset[i]) / period[i];
+		if ( releases != expected || entry[i].stats.jitter_max > 3U ) {
+			printf("frame %u: %u releases, expected %u, jitter %u\n", i, releases, expected, entry[i].stats.jitter_max);
+			errors++;
+		}
+	}
+
+	if ( entry[0].stats.misses == 0U ) {
+		printf("1-tick frame never missed with a busy TX buffer\n");
+		errors++;
+	}
+
+	if ( errors != 0 ) {
+		printf("cyclic scheduler: %d errors\n", errors);
+		return 1;
+	}
+
+	printf("cyclic scheduler: %u frames over %u ticks, across a tick wrap: ok\n",
+	       (unsigned)CHECK_FRAMES, 2U * CHECK_TICKS);
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN TX queue check
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : check_txq.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file check_txq.c
+ *
+ * @brief Host check of the TX queue of \ref ISCA_CAN_TXQ.h sharing its
+ * controller with another writer
+ *
+ * The TX buffer reads free, but another writer, e.g., the scheduler,
+ * takes it before the queue's write. The queued frame must stay queued,
+ * the other writer's completion must not count as sent, and the frame
+ * must go out on the next service. The controller is a stub with a
+ * single TX buffer.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_TXQ.h"
+#include <stdio.h>
+#include <string.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define CHECK(c, msg)    do { if ( !(c) ) { printf("FAILED: %s\n", msg); return 1; } } while (0)
+
+/******
+ * VARIABLES
+ ******/
+static can_ctrl_s      ctrl;
+static isca_txq_s      txq;
+static isca_txq_item_s items[4];
+static uint8_t         busy;     /*!<TX buffer holds a frame*/
+static uint8_t         steal;    /*!<Another writer takes the TX buffer on the next write*/
+static uint32_t        written;  /*!<Frames the queue wrote*/
+static uint32_t        last_id;  /*!<ID of the frame the queue wrote last*/
+
+/******
+ * CONTROLLER STUBS
+ ******/
+uint32_t ISCA_TIME_Us(void) {
+
+	return 0U;
+
+}
+
+uint8_t isca_can_tx_status(can_ctrl_s *can_ctrl) {
+
+	(void)can_ctrl;
+
+	return busy ? 0U : (CAN_TX_ST_BUF_FREE | CAN_TX_ST_COMPLETE);
+}
+
+int isca_can_transmit_frame(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint8_t req_type) {
+
+	(void)can_ctrl;
+	(void)req_type;
+
+	if ( steal ) {
+		steal = 0U;
+		busy  = 1U;
+	} /*Taken between the status read and the write*/
+
+	if ( busy ) {
+		return ISCA_CAN_BUSY;
+	}
+
+	busy    = 1U;
+	last_id = tx_frame->ID;
+	written++;
+
+	return ISCA_CAN_OK;
+}
+
+void isca_can_abort_tx(can_ctrl_s *can_ctrl) {
+
+	(void)can_ctrl;
+
+}
+
+/******
+ * MAIN
+ ******/
+int main(void) {
+
+	can_frame_s frame;
+
+	isca_txq_init(&txq, &ctrl, items, 4U, ISCA_TXQ_PREEMPT_OFF);
+
+	memset(&frame, 0, sizeof(frame));
+	frame.ID  = 0x100U;
+	frame.DLC = 8U;
+
+	steal = 1U;
+	CHECK(isca_txq_push(&txq, &frame) == ISCA_CAN_OK, "push");
+	CHECK(written == 0U && txq.count == 1U && !txq.inflight_valid, "refused frame taken as in flight");
+
+	busy = 0U;
+	CHECK(isca_txq_service(&txq) == 1, "frame not written once the TX buffer is free");
+	CHECK(txq.stats.sent == 0U, "other writer's completion counted as sent");
+	CHECK(written == 1U && last_id == 0x100U && txq.count == 0U, "queued frame");
+
+	busy = 0U;
+	isca_txq_service(&txq);
+	CHECK(txq.stats.sent == 1U && !txq.inflight_valid, "completion");
+
+	printf("TX queue: TX buffer taken by another writer, frame kept: ok\n");
+
+	return 0;
+}
@@ -0,0 +1,186 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN submission/completion ring check
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : check_uring.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file check_uring.c
+ *
+ * @brief Host check of the ring server of \ref ISCA_CAN_URING.h
+ *
+ * Checks that a completion without a frame, e.g., of a TX or NOP request,
+ * carries a zeroed frame even when its pending slot last held another
+ * ring's RX frame, and that a completion finding its CQ full is counted
+ * once in cq_overflow however many service passes it waits. The
+ * controller is a stub with a free TX buffer and a scripted RX queue.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_URING.h"
+#include "ISCA_CAN_API.h"
+#include <stdio.h>
+#include <string.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define CHECK(c, msg)    do { if ( !(c) ) { printf("FAILED: %s\n", msg); return 1; } } while (0)
+
+/******
+ * VARIABLES
+ ******/
+static can_ctrl_s       ctrl;
+static isca_uring_s     ring[2];
+static isca_uring_srv_s srv;
+static can_frame_s      rx_frame;   /*!<Frame the stub receives next*/
+static uint8_t          rx_ready;   /*!<rx_frame waits*/
+
+/******
+ * CONTROLLER STUBS
+ ******/
+uint32_t ISCA_TIME_Us(void) {
+
+	return 0U;
+
+}
+
+int isca_can_transmit_frame(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint8_t req_type) {
+
+	(void)can_ctrl;
+	(void)tx_frame;
+	(void)req_type;
+
+	return ISCA_CAN_OK;
+}
+
+int lbr_isca_can_receive_pkt_tmo(can_ctrl_s *can_ctrl, can_frame_s *rx_pkt, uint32_t timeout_us) {
+
+	(void)can_ctrl;
+	(void)timeout_us;
+
+	if ( !rx_ready ) {
+		return ISCA_CAN_TIMEOUT;
+	}
+
+	*rx_pkt  = rx_frame;
+	rx_ready = 0U;
+
+	return ISCA_CAN_OK;
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Queue one request on a ring*/
+static void check_submit(isca_uring_s *r, uint64_t user_data, uint8_t opcode) {
+
+	isca_uring_sqe_s *sqe = isca_uring_get_sqe(r, 0U);
+
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->user_data  = user_data;
+	sqe->opcode     = opcode;
+	sqe->timeout_us = ISCA_CAN_WAIT_FOREVER;
+	isca_uring_submit(r, 1U);
+
+}
+
+/******
+ * MAIN
+ ******/
+int main(void) {
+
+	isca_uring_cqe_s cqe;
+	can_cframe_s zero;
+	uint32_t i;
+
+	memset(&zero, 0, sizeof(zero));
+
+	isca_uring_init(&ring[0]);
+	isca_uring_init(&ring[1]);
+	isca_uring_srv_init(&srv);
+	CHECK(isca_uring_srv_attach(&srv, &ctrl) == 0, "attach");
+	isca_uring_srv_add_ring(&srv, &ring[0]);
+	isca_uring_srv_add_ring(&srv, &ring[1]);
+
+	memset(&rx_frame, 0, sizeof(rx_frame));
+	rx_frame.ID  = 0x123U;
+	rx_frame.DLC = 8U;
+	memset(rx_frame.DATA, 0xA5, 8U);
+	rx_ready = 1U;
+
+	check_submit(&ring[0], 1U, ISCA_URING_OP_RX);
+	CHECK(isca_uring_service(&srv, 8U) == 1U, "RX completion");
+	CHECK(isca_uring_reap(&ring[0], &cqe, 1U) == 1U && cqe.frame.data[0] == 0xA5U, "RX frame");
+
+	check_submit(&ring[1], 2U, ISCA_URING_OP_TX);
+	CHECK(isca_uring_service(&srv, 8U) == 1U, "TX completion");
+	CHECK(isca_uring_reap(&ring[1], &cqe, 1U) == 1U && cqe.user_data == 2U, "TX completion entry");
+	CHECK(memcmp(&cqe.frame, &zero, sizeof(zero)) == 0, "TX completion leaks the other ring's RX frame");
+
+	check_submit(&ring[1], 3U, ISCA_URING_OP_NOP);
+	isca_uring_service(&srv, 8U);
+	CHECK(isca_uring_reap(&ring[1], &cqe, 1U) == 1U && memcmp(&cqe.frame, &zero, sizeof(zero)) == 0,
+	      "NOP completion carries a frame");
+
+	for ( i = 0U; i < URING_CQ_ENTRIES; i++ ) {
+		check_submit(&ring[0], 100U + i, ISCA_URING_OP_NOP);
+		isca_uring_service(&srv, 8U);
+	} /*CQ full, nothing reaped*/
+
+	check_submit(&ring[0], 4U, ISCA_URING_OP_NOP);
+	for ( i = 0U; i < 5U; i++ ) {
+		CHECK(isca_uring_service(&srv, 8U) == 0U, "posted into a full CQ");
+	}
+	CHECK(ring[0].cq_overflow == 1U, "a held completion counted more than once");
+
+	CHECK(isca_uring_reap(&ring[0], &cqe, 1U) == 1U, "reap");
+	CHECK(isca_uring_service(&srv, 8U) == 1U && ring[0].cq_overflow == 1U, "held completion posted");
+
+	printf("uring: no stale frames, CQ overflow counted once: ok\n");
+
+	return 0;
+}
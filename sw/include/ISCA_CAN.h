@@ -58,6 +58,9 @@
  ******/
 #include "ISCA_IO.h"
 #include "ISCA_CAN_CFG.h"
+#include "ISCA_WAIT.h"
+#include "ISCA_QUEUE_INDEXER.h"
+#include <string.h>
 
 /******
  * DEFINITIONS
@@ -67,85 +70,140 @@
  * CAN FRAME STRUCT
  *----*/
 
-#if !(CAN_MODE == CAN_2B)
-/// Basic mode CAN frame description structure
+/// CAN frame description structure
 typedef struct can_frame_s {
 	uint16_t DLC;    /*!<Frame data length, multiple of byte*/
 	uint16_t RTR;    /*!<1: Remote frame request*/
 	uint8_t DATA[8]; /*!<Frame data, i.e., payload*/
 	uint32_t ID;     /*!<Frame Identification*/
+	uint32_t IDE;    /*!<Frame format, \ref CAN_FRAME_EXT or \ref CAN_FRAME_STD; 2A controllers send and receive \ref CAN_FRAME_STD only*/
 } can_frame_s;
-#else
-/// Extended mode CAN frame description structure
-typedef struct can_frame_s {
-	uint16_t DLC;    /*!<Frame data length, multiple of byte*/
-	uint16_t RTR;    /*!<1: Remote frame request*/
-	uint8_t DATA[8]; /*!<Frame data, i.e., payload*/
-	uint32_t ID;     /*!<Frame Identification*/
-	uint32_t IDE;    /*!<Frame format, \ref CAN_FRAME_EXT or \ref CAN_FRAME_STD)*/
-} can_frame_s;
-#endif
 
 /*-----
- * CAN CONTROLLER STRUCT
+ * CAN COMPACT FRAME STRUCT
  *----*/
+#define CAN_CF_ID_MSK      (0x1FFFFFFFU) /*!<\ref can_cframe_s hdr: identifier*/
+#define CAN_CF_RTR         (0x40000000U) /*!<\ref can_cframe_s hdr: remote frame request*/
+#define CAN_CF_IDE         (0x80000000U) /*!<\ref can_cframe_s hdr: extended frame*/
 
-#if !(CAN_MODE == CAN_2B)
+/// Packed 16-byte CAN frame, four per cache line; RX queue slot layout
+typedef struct can_cframe_s {
+	uint32_t hdr;      /*!<ID[28:0] | \ref CAN_CF_RTR | \ref CAN_CF_IDE*/
+	uint8_t  dlc;      /*!<Frame data length, multiple of byte*/
+	uint8_t  rsvd[3];  /*!<Reserved*/
+	uint8_t  data[8];  /*!<Frame data, i.e., payload*/
+} can_cframe_s;
 
-/// CAN controller IRQ enable union
-typedef union can_irq_en_u {
-    uint8_t rx;       /*!<RX IRQ; 0: disable / 1: enable*/
-    uint8_t tx;       /*!<TX IRQ; 0: disable / 1: enable*/
-    uint8_t err0;     /*!<RX FIFO overrun IRQ; 0: disable / 1: enable*/
-    uint8_t err1;     /*!<Error IRQ; 0: disable / 1: enable*/
-} irq_en;
+/*Compile time size check*/
+typedef char can_cframe_size_chk[(sizeof(can_cframe_s) == 16U) ? 1 : -1];
+
+/*-----
+ * CAN RAW RX STRUCT
+ *----*/
+
+/// Undecoded RX buffer registers of a frame, as read by the interrupt top half
+typedef struct can_raw_s {
+	uint8_t hdr[5];   /*!<Header registers; 2 in 2A mode, 3 or 5 in 2B mode*/
+	uint8_t data[8];  /*!<Payload registers*/
+	uint8_t rsvd[3];  /*!<Reserved*/
+} can_raw_s;
+
+/// Raw RX staging ring between the interrupt top half and bottom half
+typedef struct can_stage_s {
+	uint32_t head;                      /*!<Free running, written by the top half*/
+	uint32_t tail;                      /*!<Free running, written by the bottom half*/
+	can_raw_s raw[CAN_STAGE_ENTRIES];   /*!<Staged frames*/
+	uint32_t ts[CAN_STAGE_ENTRIES];     /*!<\ref ISCA_TIME_Us arrival time of each staged frame*/
+} can_stage_s;
+
+struct can_controller_s;
+
+/**
+ * @brief RX hook, called by the interrupt bottom half for every received
+ * frame before it is queued; returns 1 if it consumed the frame, 0 to
+ * have it queued as well
+ * */
+typedef int (*can_rx_hook_t)(struct can_controller_s *can_ctrl, can_frame_s const *rx_frame,
+                             uint32_t rx_ts, void *arg);
+
+/**
+ * @brief TX complete hook, called by the interrupt bottom half after a
+ * transmit IRQ, e.g., to write the next queued frame
+ * */
+typedef void (*can_tx_hook_t)(struct can_controller_s *can_ctrl, void *arg);
+
+/*-----
+ * CAN TX IMAGE STRUCT
+ *----*/
+
+#define CAN_TX_IMG_REGS    (13U) /*!<TX buffer registers, up to 5 header (2 in 2A mode) + 8 payload*/
+
+/// Pre-encoded TX buffer image of a CAN frame
+typedef struct can_tx_img_s {
+	uint8_t offs[CAN_TX_IMG_REGS]; /*!<TX buffer register offsets, header first*/
+	uint8_t data[CAN_TX_IMG_REGS]; /*!<Register values, in \ref offs order*/
+	uint8_t hdr_len;               /*!<Amount of header registers*/
+	uint8_t len;                   /*!<Amount of header and payload registers*/
+} can_tx_img_s;
+
+/*-----
+ * CAN CONTROLLER STRUCT
+ *----*/
 
-/// CAN controller description structure
-typedef struct can_controller_s {
-	size_t addr;          /*!<Controller's physical address*/
-	uint8_t brp;          /*!<Baud rate prescalar*/
-	uint8_t tseg1;        /*!<Timming segment 1*/
-	uint8_t tseg2;        /*!<Timming segment 2*/
-	uint8_t sjw;          /*!<Synchronization jump width*/
-	uint32_t mask;        /*!<Filter mask*/
-	uint32_t code;        /*!<Filter code*/
-	can_frame_s* q_ptr;   /*!<RX queue pointer*/
-	int8_t q_id;          /*!<RX queue identifier*/
-	uint8_t q_size;       /*!<RX queue size in frames*/
-	uint8_t irq;          /*!<IRQ mode, \ref CAN_IRQ_ON or \ref CAN_IRQ_OFF*/
-	irq_en  irqs_en; ;    /*!<IRQs enable union*/
-	void (*InterruptHandler) (void *); /*!<Interupt callback pointer*/
-} can_ctrl_s;
-#else
 /// CAN controller IRQ enable union
 typedef union can_irq_en_u {
     uint8_t rx;       /*!<RX IRQ; 0: disable / 1: enable*/
     uint8_t tx;       /*!<TX IRQ; 0: disable / 1: enable*/
-    uint8_t err0;     /*!<Error IRQ; 0: disable / 1: enable*/
-    uint8_t err1;     /*!<RX FIFO overrun IRQ; 0: disable / 1: enable*/
-    uint8_t err2;     /*!<Passive error IRQ; 0: disable / 1: enable*/
-    uint8_t err3;     /*!<Arbitration lost IRQ; 0: disable / 1: enable*/
-    uint8_t err4;     /*!<Bus error IRQ; 0: disable / 1: enable*/
+    uint8_t err0;     /*!<2A: RX FIFO overrun IRQ, 2B: Error IRQ; 0: disable / 1: enable*/
+    uint8_t err1;     /*!<2A: Error IRQ, 2B: RX FIFO overrun IRQ; 0: disable / 1: enable*/
+    uint8_t err2;     /*!<2B: Passive error IRQ; 0: disable / 1: enable*/
+    uint8_t err3;     /*!<2B: Arbitration lost IRQ; 0: disable / 1: enable*/
+    uint8_t err4;     /*!<2B: Bus error IRQ; 0: disable / 1: enable*/
 } irq_en;
 
+/// Operating mode specialised driver operations, selected once per controller by \ref isca_can_init
+typedef struct can_ops_s {
+	int  (*read_raw)(size_t addr, can_raw_s *raw);                             /*!<\ref isca_can_read_raw*/
+	void (*decode_raw)(can_raw_s const *raw, can_frame_s *rx_frame);           /*!<\ref isca_can_decode_raw*/
+	void (*write_frame)(size_t addr, can_frame_s const *tx_frame);             /*!<TX buffer write and trigger*/
+	int  (*tx_img_compile)(can_tx_img_s *tx_img, can_frame_s const *tx_frame); /*!<\ref isca_can_tx_img_compile*/
+	void (*set_filter)(struct can_controller_s const *can_ctrl);               /*!<\ref isca_can_set_filter*/
+	uint8_t (*irq_bits)(irq_en const *irqs_en, uint8_t rx_irq);                /*!<IRQ enable register value*/
+	uint8_t irq_en_reg;   /*!<IRQ enable register offset*/
+	uint8_t mode0;        /*!<Mode register value out of reset, IRQ enables aside*/
+	uint8_t mode0_keep;   /*!<Mode register bits kept by \ref isca_can_switch_mode*/
+	uint8_t cdr;          /*!<Clock divider register mode bits*/
+} can_ops_s;
+
 /// CAN controller description structure
 typedef struct can_controller_s {
 	size_t addr;          /*!<Controller's physical address*/
+	uint8_t can_mode;     /*!<Operating mode, \ref CAN_2A or \ref CAN_2B*/
+	can_ops_s const *ops; /*!<Operations of can_mode, set by \ref isca_can_init*/
 	uint8_t brp;          /*!<Baud rate prescalar*/
 	uint8_t tseg1;        /*!<Timming segment 1*/
 	uint8_t tseg2;        /*!<Timming segment 2*/
 	uint8_t sjw;          /*!<Synchronization jump width*/
 	uint32_t mask;        /*!<Filter mask*/
 	uint32_t code;        /*!<Filter code*/
-	can_frame_s* q_ptr;   /*!<RX queue pointer*/
-	uint8_t frm_md;       /*!<Frame mode: \ref CAN_FRAME_EXT / \ref CAN_FRAME_STD*/
-	int8_t q_id;          /*!<RX queue identifier*/
-	uint8_t q_size;       /*!<RX queue size in frames*/
+	can_cframe_s* q_ptr;  /*!<RX queue pointer*/
+	uint8_t frm_md;       /*!<2B frame mode: \ref CAN_FRAME_EXT / \ref CAN_FRAME_STD*/
+	isca_qhandle_t q_id;  /*!<RX queue handle*/
+	uint32_t q_size;      /*!<RX queue size in frames, a power of two*/
+	uint8_t q_policy;     /*!<RX queue overflow policy, e.g., \ref DQ_DROP_NEWEST*/
+	volatile uint8_t rx_blocked; /*!<RX IRQ masked by a full staging ring*/
 	uint8_t irq;          /*!<IRQ mode, \ref CAN_IRQ_ON or \ref CAN_IRQ_OFF*/
 	irq_en  irqs_en;      /*!<IRQs enable union*/
+	isca_wait_s rx_wait;  /*!<RX queue waiters, signalled by the IRQ producer*/
+	can_stage_s rx_stage; /*!<Raw frames staged by the IRQ top half*/
+	volatile uint8_t irq_latch; /*!<Error and, with a TX hook, transmit IRQ status bits latched by the top half*/
+	volatile uint8_t bh_busy;   /*!<Bottom half running*/
+	can_rx_hook_t rx_hook;      /*!<RX hook, NULL if none*/
+	void *rx_hook_arg;          /*!<RX hook argument*/
+	can_tx_hook_t tx_hook;      /*!<TX complete hook, NULL if none*/
+	void *tx_hook_arg;          /*!<TX complete hook argument*/
 	void (*InterruptHandler) (void *); /*!<Interupt callback pointer*/
 } can_ctrl_s;
-#endif // !(CAN_MODE == CAN_2B)
 
 /*-----
  * CAN FUNCT RETURN
@@ -160,6 +218,9 @@ typedef struct can_controller_s {
 #define ISCA_CAN_QUEUES_OCCUPIED   (-7)   /*!<CAN all SW RX queues occupied*/
 #define ISCA_CAN_INV_RST_MODE      (-8)   /*!<CAN invalid reset mode ordered*/
 #define ISCA_CAN_ERROR             (-9)   /*!<CAN error*/
+#define ISCA_CAN_INV_PARAM         (-10)  /*!<CAN invalid function parameter*/
+#define ISCA_CAN_TIMEOUT           (-11)  /*!<CAN request not satisfied before its deadline*/
+#define ISCA_CAN_NO_MEMORY         (-12)  /*!<CAN RX queue storage pool exhausted*/
 
 /*-----
  * CAN REQUEST TYPE
@@ -179,14 +240,17 @@ typedef struct can_controller_s {
 #define CAN_IRQ_OFF                (0U)  /*!<Switch CAN interrupts off*/
 #define CAN_IRQ_ON                 (1U)  /*!<Switch CAN interrupts on*/
 
+/*-----
+ * CAN TX STATUS
+ *----*/
+#define CAN_TX_ST_BUF_FREE         (0x1U) /*!<TX buffer released, a new frame may be written*/
+#define CAN_TX_ST_COMPLETE         (0x2U) /*!<Last requested transmission completed*/
 
-#if (CAN_MODE == CAN_2B)
 /*-----
- * CAN 2B FRAME TYPE
+ * CAN FRAME TYPE
  *----*/
-#define CAN_FRAME_STD              (0U)  /*!<CAN extended mode, basic frame (11-bit header)*/
-#define CAN_FRAME_EXT              (1U)  /*!<CAN extended mode, extended frame (29-bit header)*/
-#endif
+#define CAN_FRAME_STD              (0U)  /*!<Basic frame (11-bit header)*/
+#define CAN_FRAME_EXT              (1U)  /*!<Extended frame (29-bit header), 2B mode only*/
 
 /******
  * CAN DRIVER FUNCTIONS
@@ -195,10 +259,86 @@ int isca_can_init(can_ctrl_s *can_ctrl);
 
 int isca_can_transmit_frame(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint8_t req_type);
 
+int isca_can_transmit_frame_dl(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint32_t deadline);
+
+int isca_can_tx_wait_done(can_ctrl_s *can_ctrl, uint32_t deadline);
+
 int isca_can_receive_frame(can_ctrl_s *can_ctrl, can_frame_s *rx_frame, uint8_t req_type);
 
+int isca_can_tx_img_compile(can_ctrl_s const *can_ctrl, can_tx_img_s *tx_img, can_frame_s const *tx_frame);
+
+int isca_can_tx_img_payload(can_tx_img_s *tx_img, uint8_t const *data, uint8_t len);
+
+int isca_can_transmit_img(can_ctrl_s *can_ctrl, can_tx_img_s const *tx_img, uint8_t req_type);
+
+void isca_can_abort_tx(can_ctrl_s *can_ctrl);
+
+uint8_t isca_can_tx_status(can_ctrl_s *can_ctrl);
+
 void isca_can_set_filter(can_ctrl_s *can_ctrl);
 
+void isca_can_rx_irq_enable(can_ctrl_s *can_ctrl, uint8_t irq);
+
+/**
+ * @brief      Pack a frame into the compact queue slot layout
+ * @param[out] cframe Compact frame
+ * @param[in]  frame  Frame
+ * @return     None
+ */
+static inline void isca_can_frame_pack(can_cframe_s *cframe, can_frame_s const *frame) {
+
+	cframe->hdr = (frame->ID & CAN_CF_ID_MSK) | (frame->RTR ? CAN_CF_RTR : 0U) |
+	              (frame->IDE ? CAN_CF_IDE : 0U);
+	cframe->dlc = (uint8_t)frame->DLC;
+	memcpy(cframe->data, frame->DATA, 8U);
+
+}
+
+/**
+ * @brief      Unpack a compact queue slot into a frame
+ * @param[out] frame  Frame
+ * @param[in]  cframe Compact frame
+ * @return     None
+ */
+static inline void isca_can_frame_unpack(can_frame_s *frame, can_cframe_s const *cframe) {
+
+	frame->ID  = cframe->hdr & CAN_CF_ID_MSK;
+	frame->RTR = (cframe->hdr & CAN_CF_RTR) ? 1U : 0U;
+	frame->IDE = (cframe->hdr & CAN_CF_IDE) ? CAN_FRAME_EXT : CAN_FRAME_STD;
+	frame->DLC = cframe->dlc;
+	memcpy(frame->DATA, cframe->data, 8U);
+
+}
+
+/**
+ * @brief      Copy the RX buffer registers of the oldest received frame,
+ *             undecoded, and release the RX buffer; the register reads
+ *             only, as done from an interrupt top half
+ * @pre        CAN controller initialization
+ * @param[in]  can_ctrl CAN controller struct pointer
+ * @param[out] raw      Raw RX buffer bytes, see \ref isca_can_decode_raw
+ * @return     \ref ISCA_CAN_RX_FIFO_EMPTY
+ * @return     Remaining frames in the RX FIFO
+ */
+static inline int isca_can_read_raw(can_ctrl_s *can_ctrl, can_raw_s *raw) {
+
+	return can_ctrl->ops->read_raw(can_ctrl->addr, raw);
+
+}
+
+/**
+ * @brief      Decode raw RX buffer bytes read by \ref isca_can_read_raw
+ * @param[in]  can_ctrl CAN controller the bytes were read from
+ * @param[in]  raw      Raw RX buffer bytes
+ * @param[out] rx_frame CAN frame struct pointer
+ * @return     None
+ */
+static inline void isca_can_decode_raw(can_ctrl_s const *can_ctrl, can_raw_s const *raw, can_frame_s *rx_frame) {
+
+	can_ctrl->ops->decode_raw(raw, rx_frame);
+
+}
+
 int isca_can_switch_mode(can_ctrl_s *can_ctrl, uint8_t reset_mode);
 
 #endif /* ISCA_CAN_H */
@@ -70,6 +70,11 @@
 #define ISCA_CAN_API_ENC      (0U) /*!<Encode constant*/
 #define ISCA_CAN_API_DEC      (1U) /*!<Decode constant*/
 
+/*-----
+ * CAN REQUEST TIMEOUT
+ *----*/
+#define ISCA_CAN_WAIT_FOREVER (0xFFFFFFFFU) /*!<Block until the request is satisfied*/
+
 /******
  * FUNCTIONS DECLARATION
  ******/
@@ -79,8 +84,20 @@ int lbr_isca_can_start(can_ctrl_s *can_ctrl);
 
 int lbr_isca_can_stop(can_ctrl_s *can_ctrl);
 
+int lbr_isca_can_deinit(can_ctrl_s *can_ctrl);
+
 int lbr_isca_can_receive_pkt(can_ctrl_s *can_ctrl, can_frame_s *rx_frame);
 
+int lbr_isca_can_receive_pkt_tmo(can_ctrl_s *can_ctrl, can_frame_s *rx_frame, uint32_t timeout_us);
+
+int lbr_isca_can_receive_burst(can_ctrl_s *can_ctrl, can_cframe_s *frames, uint32_t max, uint32_t timeout_us);
+
 int lbr_isca_can_transmit_pkt(can_ctrl_s *can_ctrl, can_frame_s *tx_frame);
 
+int lbr_isca_can_transmit_pkt_tmo(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint32_t timeout_us);
+
+int lbr_isca_can_transmit_img(can_ctrl_s *can_ctrl, can_tx_img_s const *tx_img);
+
+uint32_t lbr_isca_can_rx_drops(can_ctrl_s *can_ctrl);
+
 #endif /* ISCA_CAN_API_H */
@@ -0,0 +1,130 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN shared-memory broadcast ring
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_BCAST.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_BCAST.h
+ *
+ * @brief Single-writer, multi-reader broadcast of the RX stream
+ *
+ * The writer, a controller's RX hook, stores every received frame in the
+ * next slot of the ring and never waits for the readers; each reader keeps
+ * its own cursor and filters, in its private \ref isca_bcast_rd_s, so any
+ * number of them, e.g., a logger, a diagnostics agent and the application,
+ * read the same stream. Every slot carries a sequence number, odd while
+ * the slot is written, \ref BCAST_SEQ_DONE of the frame position after;
+ * a reader the writer lapped notices the sequence jump, counts the frames
+ * it lost and resumes from the oldest frame still in the ring.
+ *
+ * The ring, \ref isca_bcast_s, holds no pointers and may be placed in a
+ * shared memory segment mapped by the reader processes.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_BCAST_H
+#define ISCA_CAN_BCAST_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if (BCAST_SLOTS & (BCAST_SLOTS - 1U)) != 0
+#error "BCAST_SLOTS must be a power of two"
+#endif
+
+/*-----
+ * BROADCAST FUNCT RETURN
+ *----*/
+#define ISCA_BCAST_FULL       (-1) /*!<No free reader filter*/
+
+#define BCAST_MAGIC           (0x42434153U) /*!<Ring layout tag, "BCAS"*/
+
+#define BCAST_SEQ_DONE(pos)   ((uint32_t)(pos) * 2U + 2U) /*!<Sequence number of a slot holding the frame at pos*/
+
+/// Broadcast ring slot, two per cache line
+typedef struct isca_bcast_slot_s {
+	uint32_t seq;            /*!<Odd while written, \ref BCAST_SEQ_DONE once the frame is stored*/
+	uint32_t ts;             /*!<RX timestamp, \ref ISCA_TIME_Us*/
+	can_cframe_s frame;      /*!<Frame*/
+	uint32_t rsvd[2];        /*!<Reserved*/
+} isca_bcast_slot_s;
+
+/// Broadcast ring, position independent
+typedef struct isca_bcast_s {
+	uint32_t magic;                                            /*!<\ref BCAST_MAGIC*/
+	uint32_t slots;                                            /*!<\ref BCAST_SLOTS of the writer's build*/
+	uint32_t head __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Position of the next frame written*/
+	isca_bcast_slot_s slot[BCAST_SLOTS] __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Frames*/
+} isca_bcast_s;
+
+/// Reader, private to its process
+typedef struct isca_bcast_rd_s {
+	isca_bcast_s const *ring;          /*!<Ring read*/
+	uint32_t pos;                      /*!<Position of the next frame read*/
+	uint32_t lost;                     /*!<Frames overwritten before read*/
+	uint32_t filt_id[BCAST_FILTERS];   /*!<Filter codes, on \ref can_cframe_s hdr*/
+	uint32_t filt_mask[BCAST_FILTERS]; /*!<Filter masks, on \ref can_cframe_s hdr*/
+	uint8_t  n_filt;                   /*!<Filters; 0 takes every frame*/
+} isca_bcast_rd_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_bcast_init(isca_bcast_s *ring);
+
+void isca_bcast_attach(isca_bcast_s *ring, can_ctrl_s *can_ctrl);
+
+void isca_bcast_publish(isca_bcast_s *ring, can_frame_s const *frame, uint32_t ts);
+
+int isca_bcast_rd_init(isca_bcast_rd_s *rd, isca_bcast_s const *ring);
+
+int isca_bcast_rd_filter(isca_bcast_rd_s *rd, uint32_t id, uint32_t mask);
+
+uint32_t isca_bcast_read(isca_bcast_rd_s *rd, can_cframe_s *frames, uint32_t *ts, uint32_t max);
+
+#endif /* ISCA_CAN_BCAST_H */
@@ -70,7 +70,7 @@
  * -DCAN_MODE=CAN_2B
  */
 #ifndef CAN_MODE
-#define CAN_MODE       (CAN_2B)  /*!<CAN operating mode; \ref CAN_2A or \ref CAN_2B*/
+#define CAN_MODE       (CAN_2B)  /*!<Example application controller mode; \ref CAN_2A or \ref CAN_2B. The driver mode is per controller, can_ctrl_s.can_mode*/
 #endif
 
 #ifndef APPRISE_MODE
@@ -89,4 +89,232 @@
  * */
 #define __COUT(str, ...)    (printf(str, ##__VA_ARGS__))
 
+/*
+ * Wait primitive used while a receive request blocks, see ISCA_WAIT.h
+ */
+#define WAIT_SPIN      (0) /*!<Busy wait*/
+#define WAIT_PTHREAD   (1) /*!<POSIX condition variable*/
+#define WAIT_HOOK      (2) /*!<Board hooks, \ref __WAIT_IDLE and \ref __WAIT_WAKE*/
+
+#ifndef WAIT_MODE
+#if defined(__linux__)
+#define WAIT_MODE      (WAIT_PTHREAD) /*!<Wait mode \ref WAIT_SPIN, \ref WAIT_PTHREAD or \ref WAIT_HOOK*/
+#else
+#define WAIT_MODE      (WAIT_HOOK)    /*!<Wait mode \ref WAIT_SPIN, \ref WAIT_PTHREAD or \ref WAIT_HOOK*/
+#endif
+#endif
+
+#ifndef POLL_PERIOD_US
+#define POLL_PERIOD_US (100U) /*!<Sleep between RX FIFO polls in \ref APP_POLL mode, \ref WAIT_PTHREAD only*/
+#endif
+
+#ifndef TX_BLOCK_TMO_US
+#define TX_BLOCK_TMO_US (100000U) /*!<Blocking transmit gives up on a TX buffer held longer, e.g., bus-off, us*/
+#endif
+
+/**
+ * @brief Idle the CPU until an interrupt arrives
+ *
+ * Used by \ref WAIT_HOOK mode; replace it with your RTOS' semaphore take
+ * if an RTOS is used
+ * */
+#if defined(__arm__)
+#define __WAIT_IDLE()       __asm__ volatile ("wfi")
+#else
+#define __WAIT_IDLE()
+#endif
+
+/**
+ * @brief Wake up the waiters of \ref __WAIT_IDLE
+ *
+ * Called by the IRQ producer; WFI needs no explicit wake-up, replace it
+ * with your RTOS' semaphore give if an RTOS is used
+ * */
+#define __WAIT_WAKE()
+
+#ifndef FRAME_POOL_FRAMES
+#define FRAME_POOL_FRAMES (1024U) /*!<Frames in the static RX queue storage pool, a power of two*/
+#endif
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE   (64U)   /*!<Data cache line size in bytes*/
+#endif
+
+#ifndef CAN_RX_BURST
+#define CAN_RX_BURST      (8U)    /*!<Frames moved from the RX FIFO per RX interrupt*/
+#endif
+
+/*
+ * Event log verbosity; events above LOG_LEVEL compile to nothing
+ */
+#define LOG_NONE          (0)
+#define LOG_ERROR         (1)
+#define LOG_WARN          (2)
+#define LOG_INFO          (3)
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL         LOG_WARN
+#endif
+
+#ifndef LOG_ENTRIES
+#define LOG_ENTRIES       (64U)   /*!<Event log ring records, a power of two*/
+#endif
+
+#ifndef CAN_STAGE_ENTRIES
+#define CAN_STAGE_ENTRIES (16U)   /*!<Raw frames staged per controller by the IRQ top half, a power of two*/
+#endif
+
+/*
+ * Bottom half scheduling hook; called by the IRQ top half after staging
+ * work. Wake the deferred worker here, e.g., release an RTOS task or a
+ * thread, or leave it empty to have the receivers run the bottom half.
+ */
+#ifndef __BH_SCHEDULE
+#define __BH_SCHEDULE(can_ctrl)
+#endif
+
+#ifndef CAN_MGR_MAX
+#define CAN_MGR_MAX       (8U)    /*!<Controllers per manager, up to 32*/
+#endif
+
+#ifndef CAN_MGR_QUANTUM
+#define CAN_MGR_QUANTUM   (CAN_RX_BURST) /*!<Frames a controller is served per manager round*/
+#endif
+
+#ifndef GW_MAX_SRC
+#define GW_MAX_SRC        (4U)    /*!<Source controllers per gateway*/
+#endif
+
+#ifndef GW_MAX_DST
+#define GW_MAX_DST        (8U)    /*!<Destination TX queues per gateway, up to 32*/
+#endif
+
+#ifndef GW_MAX_RULES
+#define GW_MAX_RULES      (64U)   /*!<Routing rules per gateway, up to 255*/
+#endif
+
+#ifndef GW_EXT_SLOTS
+#define GW_EXT_SLOTS      (128U)  /*!<Exact 29-bit ID hash slots per gateway, a power of two*/
+#endif
+
+#ifndef CO_MAX_CTRL
+#define CO_MAX_CTRL       (4U)    /*!<Controllers served by a coroutine executor*/
+#endif
+
+#ifndef URING_SQ_ENTRIES
+#define URING_SQ_ENTRIES  (64U)   /*!<Submission ring entries, a power of two*/
+#endif
+
+#ifndef URING_CQ_ENTRIES
+#define URING_CQ_ENTRIES  (128U)  /*!<Completion ring entries, a power of two*/
+#endif
+
+#ifndef URING_MAX_RINGS
+#define URING_MAX_RINGS   (4U)    /*!<Ring pairs served by a ring server*/
+#endif
+
+#ifndef URING_MAX_CTRL
+#define URING_MAX_CTRL    (4U)    /*!<Controllers served by a ring server*/
+#endif
+
+#ifndef URING_PENDING
+#define URING_PENDING     (64U)   /*!<Requests in flight per ring server*/
+#endif
+
+#ifndef BCAST_SLOTS
+#define BCAST_SLOTS       (256U)  /*!<Broadcast ring slots, a power of two*/
+#endif
+
+#ifndef BCAST_FILTERS
+#define BCAST_FILTERS     (8U)    /*!<Filters per broadcast reader*/
+#endif
+
+#ifndef TP_MAX_SESS
+#define TP_MAX_SESS       (16U)   /*!<ISO-TP sessions per endpoint*/
+#endif
+
+#ifndef TP_HASH_SLOTS
+#define TP_HASH_SLOTS     (32U)   /*!<ISO-TP session lookup slots, a power of two*/
+#endif
+
+#ifndef TP_N_BS_US
+#define TP_N_BS_US        (1000000U) /*!<ISO-TP wait for a flow control frame, us*/
+#endif
+
+#ifndef TP_N_CR_US
+#define TP_N_CR_US        (1000000U) /*!<ISO-TP wait for a consecutive frame, us*/
+#endif
+
+#ifndef TP_WFT_MAX
+#define TP_WFT_MAX        (8U)    /*!<ISO-TP flow control WAIT frames accepted in a row*/
+#endif
+
+#ifndef TP_PAD
+#define TP_PAD            (0xCCU) /*!<ISO-TP padding byte; frames are always 8 bytes long*/
+#endif
+
+#ifndef FOTA_BLOCK_SIZE
+#define FOTA_BLOCK_SIZE   (512U)  /*!<Firmware stream block, one CRC each, up to 1524 bytes*/
+#endif
+
+#ifndef FOTA_WINDOW
+#define FOTA_WINDOW       (8U)    /*!<Firmware stream blocks in flight, a power of two up to 32*/
+#endif
+
+#ifndef FOTA_STAGE_SIZE
+#define FOTA_STAGE_SIZE   (4096U) /*!<Receiver staging buffer, e.g., a flash sector; a multiple of FOTA_BLOCK_SIZE*/
+#endif
+
+#ifndef FOTA_STAGES
+#define FOTA_STAGES       (2U)    /*!<Receiver staging buffers*/
+#endif
+
+#ifndef FOTA_ACK_TMO_US
+#define FOTA_ACK_TMO_US   (50000U) /*!<Firmware stream block acknowledgement timeout, us*/
+#endif
+
+#ifndef FOTA_RETRIES
+#define FOTA_RETRIES      (8U)    /*!<Firmware stream timeouts of a block or handshake before aborting*/
+#endif
+
+#ifndef J1939_MAX_SESS
+#define J1939_MAX_SESS    (32U)   /*!<J1939 transport sessions per node, up to 255*/
+#endif
+
+#ifndef J1939_HASH_SLOTS
+#define J1939_HASH_SLOTS  (64U)   /*!<J1939 session lookup slots, a power of two*/
+#endif
+
+#ifndef J1939_CTS_PACKETS
+#define J1939_CTS_PACKETS (16U)   /*!<J1939 packets granted per CTS, 1 to 255*/
+#endif
+
+#ifndef J1939_BAM_GAP_US
+#define J1939_BAM_GAP_US  (50000U) /*!<J1939 BAM data packet spacing, 50 to 200 ms*/
+#endif
+
+#ifndef SIGDB_MAX_SIGS
+#define SIGDB_MAX_SIGS    (256U)  /*!<Signals per signal database*/
+#endif
+
+#ifndef SIGDB_MAX_MSGS
+#define SIGDB_MAX_MSGS    (64U)   /*!<Messages per signal database*/
+#endif
+
+#ifndef SIGDB_HASH_SLOTS
+#define SIGDB_HASH_SLOTS  (128U)  /*!<Message lookup slots, a power of two above SIGDB_MAX_MSGS*/
+#endif
+
+#ifndef SIGDB_NAME_LEN
+#define SIGDB_NAME_LEN    (32U)   /*!<Signal name length, terminator included*/
+#endif
+
+#ifndef SIGDB_CHUNK
+#define SIGDB_CHUNK       (256U)  /*!<Frames sorted per batch decode step, on the stack*/
+#endif
+
+#ifndef SIGDB_VALUE
+#define SIGDB_VALUE       float   /*!<Decoded signal value type*/
+#endif
+
 #endif /* ISCA_CAN_CFG_H */
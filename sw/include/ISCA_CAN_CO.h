@@ -0,0 +1,165 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN coroutines
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_CO.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_CO.h
+ *
+ * @brief Stackless coroutines awaiting CAN send/receive, and their
+ * single-threaded executor
+ *
+ * A coroutine is a function resumed at its last await. Its locals do not
+ * survive an await; keep state in the \ref isca_co_s.arg object.
+ * @code
+ * static int session(isca_co_s *co) {
+ *     sess_s *s = co->arg;
+ *     ISCA_CO_BEGIN(co);
+ *     ISCA_CO_SEND(co, s->ctrl, &s->req, 1000U);
+ *     ISCA_CO_RECV(co, s->ctrl, s->rsp_id, 0x7FFU, &s->rsp, 5000U);
+ *     if ( co->result == ISCA_CAN_TIMEOUT ) { ... }
+ *     ISCA_CO_END(co);
+ * }
+ * @endcode
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_CO_H
+#define ISCA_CAN_CO_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+
+/*-----
+ * COROUTINE FUNCT RETURN
+ *----*/
+#define ISCA_CO_DONE          (0)  /*!<Coroutine finished*/
+#define ISCA_CO_WAIT          (1)  /*!<Coroutine suspended at an await*/
+
+#define ISCA_CO_FULL          (-1) /*!<No free executor controller slot*/
+
+/*-----
+ * COROUTINE WAIT STATE
+ *----*/
+#define ISCA_CO_W_NONE        (0U) /*!<Runnable*/
+#define ISCA_CO_W_RX          (1U) /*!<Awaiting a matching frame*/
+#define ISCA_CO_W_TX          (2U) /*!<Awaiting a free TX buffer*/
+
+/*-----
+ * COROUTINE BODY
+ *----*/
+/// Open the coroutine body
+#define ISCA_CO_BEGIN(co)     switch ( (co)->lc ) { case 0U:
+
+/// Close the coroutine body; it is not resumed again
+#define ISCA_CO_END(co)       } (co)->lc = 0U; return ISCA_CO_DONE
+
+/// Suspend until the executor's next pass
+#define ISCA_CO_YIELD(co)     do { (co)->lc = __LINE__; return ISCA_CO_WAIT; case __LINE__:; } while (0)
+
+/// Await a frame with (ID & mask) == (id & mask); \ref isca_co_s.result is \ref ISCA_CAN_OK or \ref ISCA_CAN_TIMEOUT
+#define ISCA_CO_RECV(co, ctrl, id, mask, frame, timeout_us) \
+	do { isca_co_recv((co), (ctrl), (id), (mask), (frame), (timeout_us)); ISCA_CO_YIELD(co); } while (0)
+
+/// Await the frame's TX request; \ref isca_co_s.result is \ref ISCA_CAN_OK or \ref ISCA_CAN_TIMEOUT
+#define ISCA_CO_SEND(co, ctrl, frame, timeout_us) \
+	do { isca_co_send((co), (ctrl), (frame), (timeout_us)); ISCA_CO_YIELD(co); } while (0)
+
+struct isca_co_s;
+
+/// Coroutine body, returns \ref ISCA_CO_WAIT or \ref ISCA_CO_DONE
+typedef int (*isca_co_fn_t)(struct isca_co_s *co);
+
+/// Coroutine description structure
+typedef struct isca_co_s {
+	isca_co_fn_t fn;         /*!<Body*/
+	void *arg;               /*!<State kept across awaits*/
+	int result;              /*!<Result of the last await*/
+	uint16_t lc;             /*!<Resume point*/
+	uint8_t wait;            /*!<\ref ISCA_CO_W_NONE, \ref ISCA_CO_W_RX or \ref ISCA_CO_W_TX*/
+	uint8_t timed;           /*!<deadline applies*/
+	uint32_t deadline;       /*!<Await deadline, \ref ISCA_TIME_Us*/
+	can_ctrl_s *can_ctrl;    /*!<Awaited controller*/
+	can_frame_s *frame;      /*!<RX destination or TX source*/
+	uint32_t id;             /*!<RX filter code*/
+	uint32_t mask;           /*!<RX filter mask*/
+	struct isca_co_s *next;  /*!<Executor list link*/
+} isca_co_s;
+
+/// Frames received with no matching waiter
+typedef void (*isca_co_stray_t)(can_ctrl_s *can_ctrl, can_frame_s const *rx_frame, void *arg);
+
+/// Coroutine executor description structure
+typedef struct isca_co_exec_s {
+	isca_co_s *head;                   /*!<Coroutines, in spawn order*/
+	isca_co_s *tail;                   /*!<Last coroutine*/
+	can_ctrl_s *ctrl[CO_MAX_CTRL];     /*!<Controllers the executor receives from*/
+	uint8_t n_ctrl;                    /*!<Attached controllers*/
+	isca_co_stray_t stray;             /*!<Stray frames callback, NULL to drop them*/
+	void *stray_arg;                   /*!<Stray frames callback argument*/
+	uint32_t strays;                   /*!<Stray frames dropped*/
+} isca_co_exec_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_co_exec_init(isca_co_exec_s *exec, isca_co_stray_t stray, void *stray_arg);
+
+int isca_co_exec_attach(isca_co_exec_s *exec, can_ctrl_s *can_ctrl);
+
+void isca_co_spawn(isca_co_exec_s *exec, isca_co_s *co, isca_co_fn_t fn, void *arg);
+
+uint32_t isca_co_exec_run(isca_co_exec_s *exec, uint32_t budget);
+
+void isca_co_recv(isca_co_s *co, can_ctrl_s *can_ctrl, uint32_t id, uint32_t mask,
+                  can_frame_s *frame, uint32_t timeout_us);
+
+void isca_co_send(isca_co_s *co, can_ctrl_s *can_ctrl, can_frame_s *frame, uint32_t timeout_us);
+
+#endif /* ISCA_CAN_CO_H */
@@ -0,0 +1,297 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN specialised fast paths
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_FAST.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_FAST.h
+ *
+ * @brief Header-only TX/RX fast paths specialised per mode and frame format
+ *
+ * For code that knows its controller's mode, and for TX the frame format,
+ * when it is written: every register offset is a constant and the payload
+ * loop is unrolled on the DLC, so once inlined a call is the bare MMIO
+ * sequence, without the \ref can_ops_s indirection or the IDE tests of
+ * \ref isca_can_transmit_frame. Frames are the driver's \ref can_frame_s.
+ *
+ * No TX buffer wait is included; check \ref isca_can_fast_tx_free first.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_FAST_H
+#define ISCA_CAN_FAST_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+#include "ISCA_CAN_REGS.h"
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      TX buffer free
+ * @param[in]  addr Controller's physical address
+ * @return     Non zero if a frame may be written
+ */
+static inline int isca_can_fast_tx_free(size_t addr) {
+
+	return !CAN_Q_TX_BUF_STATUS(ISCA_FPGA_Read8Bit_Inl(addr+CAN_STATUS_REG));
+
+}
+
+/**
+ * @brief      Unrolled payload store; payload registers are consecutive
+ * @param[in]  reg  Address of the first payload register
+ * @param[in]  data Payload
+ * @param[in]  dlc  Payload length, clipped to 8
+ * @return     None
+ */
+static inline void isca_can_fast_payload_wr(size_t reg, uint8_t const *data, uint32_t dlc) {
+
+	switch ( dlc ) {
+		default:
+		case 8U: ISCA_FPGA_Write8Bit_Inl(reg+28U, data[7]); /* fall through */
+		case 7U: ISCA_FPGA_Write8Bit_Inl(reg+24U, data[6]); /* fall through */
+		case 6U: ISCA_FPGA_Write8Bit_Inl(reg+20U, data[5]); /* fall through */
+		case 5U: ISCA_FPGA_Write8Bit_Inl(reg+16U, data[4]); /* fall through */
+		case 4U: ISCA_FPGA_Write8Bit_Inl(reg+12U, data[3]); /* fall through */
+		case 3U: ISCA_FPGA_Write8Bit_Inl(reg+ 8U, data[2]); /* fall through */
+		case 2U: ISCA_FPGA_Write8Bit_Inl(reg+ 4U, data[1]); /* fall through */
+		case 1U: ISCA_FPGA_Write8Bit_Inl(reg+ 0U, data[0]); /* fall through */
+		case 0U: break;
+	}
+
+}
+
+/**
+ * @brief      Unrolled payload load
+ * @param[in]  reg  Address of the first payload register
+ * @param[out] data Payload
+ * @param[in]  dlc  Payload length, up to 8
+ * @return     None
+ */
+static inline void isca_can_fast_payload_rd(size_t reg, uint8_t *data, uint32_t dlc) {
+
+	switch ( dlc ) {
+		default:
+		case 8U: data[7] = ISCA_FPGA_Read8Bit_Inl(reg+28U); /* fall through */
+		case 7U: data[6] = ISCA_FPGA_Read8Bit_Inl(reg+24U); /* fall through */
+		case 6U: data[5] = ISCA_FPGA_Read8Bit_Inl(reg+20U); /* fall through */
+		case 5U: data[4] = ISCA_FPGA_Read8Bit_Inl(reg+16U); /* fall through */
+		case 4U: data[3] = ISCA_FPGA_Read8Bit_Inl(reg+12U); /* fall through */
+		case 3U: data[2] = ISCA_FPGA_Read8Bit_Inl(reg+ 8U); /* fall through */
+		case 2U: data[1] = ISCA_FPGA_Read8Bit_Inl(reg+ 4U); /* fall through */
+		case 1U: data[0] = ISCA_FPGA_Read8Bit_Inl(reg+ 0U); /* fall through */
+		case 0U: break;
+	}
+
+}
+
+/*-----
+ * TX
+ *----*/
+/**
+ * @brief      Write a frame to the TX buffer of a 2A controller and trigger TX
+ * @param[in]  addr     Controller's physical address
+ * @param[in]  tx_frame Frame; IDE is ignored
+ * @return     None
+ * @pre        \ref isca_can_fast_tx_free
+ */
+static inline void isca_can_fast_write_2a(size_t addr, can_frame_s const *tx_frame) {
+
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX0_REG_2A, (uint8_t)((tx_frame->ID & 0x7F8U) >> 3U));
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX1_REG_2A, (uint8_t)(((tx_frame->ID  & 0x7U) << 5U) |
+	                                                       ((tx_frame->RTR & 0x1U) << 4U) |
+	                                                        (tx_frame->DLC & 0xFU)));
+	isca_can_fast_payload_wr(addr+CAN_TX2_REG_2A, tx_frame->DATA, tx_frame->DLC);
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_COMMAND_TX_REG, CAN_CMNT_TRIGGER_TX);
+
+}
+
+/**
+ * @brief      Write an 11-bit ID frame to the TX buffer of a 2B controller
+ *             and trigger TX
+ * @param[in]  addr     Controller's physical address
+ * @param[in]  tx_frame Frame; IDE is taken as \ref CAN_FRAME_STD
+ * @return     None
+ * @pre        \ref isca_can_fast_tx_free
+ */
+static inline void isca_can_fast_write_2b_std(size_t addr, can_frame_s const *tx_frame) {
+
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX0_REG_2B, (uint8_t)(((tx_frame->RTR & 0x1U) << 6U) |
+	                                                        (tx_frame->DLC & 0xFU)));
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX1_REG_2B, (uint8_t)((tx_frame->ID & 0x7F8U) >> 3U));
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX2_REG_2B, (uint8_t)((tx_frame->ID & 0x7U) << 5U));
+	isca_can_fast_payload_wr(addr+CAN_TX3_REG_2B, tx_frame->DATA, tx_frame->DLC);
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_COMMAND_TX_REG, CAN_CMNT_TRIGGER_TX);
+
+}
+
+/**
+ * @brief      Write a 29-bit ID frame to the TX buffer of a 2B controller
+ *             and trigger TX
+ * @param[in]  addr     Controller's physical address
+ * @param[in]  tx_frame Frame; IDE is taken as \ref CAN_FRAME_EXT
+ * @return     None
+ * @pre        \ref isca_can_fast_tx_free
+ */
+static inline void isca_can_fast_write_2b_ext(size_t addr, can_frame_s const *tx_frame) {
+
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX0_REG_2B, (uint8_t)(0x80U |
+	                                                       ((tx_frame->RTR & 0x1U) << 6U) |
+	                                                        (tx_frame->DLC & 0xFU)));
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX1_REG_2B, (uint8_t)((tx_frame->ID & 0x1FE00000U) >> 21U));
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX2_REG_2B, (uint8_t)((tx_frame->ID & 0x1FE000U) >> 13U));
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX3_REG_2B, (uint8_t)((tx_frame->ID & 0x1FE0U) >> 5U));
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_TX4_REG_2B, (uint8_t)((tx_frame->ID & 0x1FU) << 3U));
+	isca_can_fast_payload_wr(addr+CAN_TX5_REG_2B, tx_frame->DATA, tx_frame->DLC);
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_COMMAND_TX_REG, CAN_CMNT_TRIGGER_TX);
+
+}
+
+/*-----
+ * RX
+ *----*/
+/**
+ * @brief      Count received frames, acknowledging a pending RX FIFO overrun
+ * @param[in]  addr        Controller's physical address
+ * @param[in]  counter_reg \ref CAN_RX_COUNTER_REG_2A or \ref CAN_RX_COUNTER_REG_2B
+ * @return     Frames in the RX FIFO
+ */
+static inline uint32_t isca_can_fast_rx_pending(size_t addr, uint32_t counter_reg) {
+
+	if ( __builtin_expect(CAN_Q_RX_OVERRUN(ISCA_FPGA_Read8Bit_Inl(addr+CAN_STATUS_REG)), 0) ) {
+		while ( ISCA_FPGA_Read8Bit_Inl(addr+CAN_INVALID_RX_ACK_REG) != 0U ) {
+			ISCA_FPGA_Write8Bit_Inl(addr+CAN_COMMAND_RX_REG, CAN_CMNT_RX_ACK);
+		}
+	} /*RX FIFO overrun, acknowledge the invalid data*/
+
+	return ISCA_FPGA_Read8Bit_Inl(addr+counter_reg);
+
+}
+
+/**
+ * @brief      Read and release the oldest frame of a 2A controller
+ * @param[in]  addr     Controller's physical address
+ * @param[out] rx_frame Frame
+ * @return     \ref ISCA_CAN_RX_FIFO_EMPTY
+ * @return     Remaining frames in the RX FIFO
+ */
+static inline int isca_can_fast_read_2a(size_t addr, can_frame_s *rx_frame) {
+
+	uint32_t remain = isca_can_fast_rx_pending(addr, CAN_RX_COUNTER_REG_2A);
+	uint8_t  hdr0;
+	uint8_t  hdr1;
+	uint8_t  dlc;
+
+	if ( remain == 0U ) {
+		return ISCA_CAN_RX_FIFO_EMPTY;
+	}
+
+	hdr0 = ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX0_REG_2A);
+	hdr1 = ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX1_REG_2A);
+	dlc  = hdr1 & 0xFU;
+	dlc  = (dlc == 0x8U) ? 0x8U : (dlc & 0x7U); //SCAN
+
+	isca_can_fast_payload_rd(addr+CAN_RX2_REG_2A, rx_frame->DATA, dlc);
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_COMMAND_RX_REG, CAN_CMNT_RX_ACK);
+
+	rx_frame->ID  = ((uint32_t)hdr0 << 3U) | ((hdr1 >> 5U) & 0x7U);
+	rx_frame->RTR = (hdr1 >> 4U) & 0x1U;
+	rx_frame->DLC = dlc;
+	rx_frame->IDE = CAN_FRAME_STD;
+
+	return (int)(remain - 1U);
+}
+
+/**
+ * @brief      Read and release the oldest frame of a 2B controller
+ * @param[in]  addr     Controller's physical address
+ * @param[out] rx_frame Frame
+ * @return     \ref ISCA_CAN_RX_FIFO_EMPTY
+ * @return     Remaining frames in the RX FIFO
+ * @note       The frame format is only known from the first header register,
+ *             so this path keeps its one IDE test
+ */
+static inline int isca_can_fast_read_2b(size_t addr, can_frame_s *rx_frame) {
+
+	uint32_t remain = isca_can_fast_rx_pending(addr, CAN_RX_COUNTER_REG_2B);
+	uint8_t  hdr0;
+	uint8_t  dlc;
+	uint32_t id;
+
+	if ( remain == 0U ) {
+		return ISCA_CAN_RX_FIFO_EMPTY;
+	}
+
+	hdr0 = ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX0_REG_2B);
+	dlc  = hdr0 & 0x0FU;
+	dlc  = (dlc > 0x8U) ? 0x8U : dlc;
+	id   = (uint32_t)ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX1_REG_2B);
+
+	if ( (hdr0 & 0x80U) != 0U ) {
+		id = (id << 21U) |
+		     ((uint32_t)ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX2_REG_2B) << 13U) |
+		     ((uint32_t)ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX3_REG_2B) << 5U)  |
+		     ((uint32_t)(ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX4_REG_2B) & 0xF8U) >> 3U);
+		isca_can_fast_payload_rd(addr+CAN_RX5_REG_2B, rx_frame->DATA, dlc);
+		rx_frame->IDE = CAN_FRAME_EXT;
+	} /*29-bit ID*/
+	else {
+		id = (id << 3U) | ((uint32_t)(ISCA_FPGA_Read8Bit_Inl(addr+CAN_RX2_REG_2B) & 0xE0U) >> 5U);
+		isca_can_fast_payload_rd(addr+CAN_RX3_REG_2B, rx_frame->DATA, dlc);
+		rx_frame->IDE = CAN_FRAME_STD;
+	} /*11-bit ID*/
+
+	ISCA_FPGA_Write8Bit_Inl(addr+CAN_COMMAND_RX_REG, CAN_CMNT_RX_ACK);
+
+	rx_frame->ID  = id;
+	rx_frame->RTR = (hdr0 >> 6U) & 0x1U;
+	rx_frame->DLC = dlc;
+
+	return (int)(remain - 1U);
+}
+
+#endif /* ISCA_CAN_FAST_H */
@@ -0,0 +1,145 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN-to-CAN gateway
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_GW.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_GW.h
+ *
+ * @brief CAN-to-CAN gateway routing engine
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_GW_H
+#define ISCA_CAN_GW_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+#include "ISCA_CAN_TXQ.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if (GW_MAX_RULES > 255U) || (GW_MAX_DST > 32U)
+#error "GW_MAX_RULES must not exceed 255, GW_MAX_DST 32"
+#endif
+
+/*-----
+ * GATEWAY FUNCT RETURN
+ *----*/
+#define ISCA_GW_FULL          (-1) /*!<No free source, rule or hash slot*/
+#define ISCA_GW_INV_RULE      (-2) /*!<Rule refers to an unknown source or destination*/
+
+/*-----
+ * GATEWAY RULE FLAGS
+ *----*/
+#define GW_RULE_REWRITE       (0x1U) /*!<Replace the frame ID with \ref isca_gw_rule_s.new_id*/
+#define GW_RULE_LOCAL         (0x2U) /*!<Queue the frame in the source's RX queue as well*/
+
+/// Routing rule
+typedef struct isca_gw_rule_s {
+	uint8_t  src;       /*!<Source controller, as returned by \ref isca_gw_attach*/
+	uint8_t  ide;       /*!<\ref CAN_FRAME_STD or \ref CAN_FRAME_EXT*/
+	uint8_t  flags;     /*!<\ref GW_RULE_REWRITE, \ref GW_RULE_LOCAL*/
+	uint32_t id;        /*!<Frame ID*/
+	uint32_t mask;      /*!<ID bits compared; all ones for an exact match*/
+	uint32_t dst_set;   /*!<Destination TX queues, one bit each*/
+	uint32_t new_id;    /*!<ID of the forwarded frames, with \ref GW_RULE_REWRITE*/
+} isca_gw_rule_s;
+
+/// Per rule statistics
+typedef struct isca_gw_stats_s {
+	uint32_t matched;   /*!<Frames matched*/
+	uint32_t forwarded; /*!<Frames queued for transmission, one per destination*/
+	uint32_t dropped;   /*!<Frames refused by a full destination TX queue*/
+	uint32_t lat_last;  /*!<Arrival to TX queue latency of the last frame, us*/
+	uint32_t lat_max;   /*!<Worst arrival to TX queue latency, us*/
+} isca_gw_stats_s;
+
+struct isca_gw_s;
+
+/// Gateway source, the RX hook argument of its controller
+typedef struct isca_gw_src_s {
+	struct isca_gw_s *gw;          /*!<Owning gateway*/
+	uint8_t idx;                   /*!<Source index*/
+	uint8_t std_map[2048];         /*!<11-bit ID to rule index + 1; 0: not routed*/
+} isca_gw_src_s;
+
+/// Exact 29-bit ID hash slot
+typedef struct isca_gw_ext_s {
+	uint32_t id;        /*!<Frame ID*/
+	uint8_t  src;       /*!<Source index*/
+	uint8_t  rule;      /*!<Rule index + 1; 0: free slot*/
+} isca_gw_ext_s;
+
+/// Gateway description structure
+typedef struct isca_gw_s {
+	isca_gw_src_s src[GW_MAX_SRC];           /*!<Sources*/
+	isca_txq_s *dst[GW_MAX_DST];             /*!<Destination TX queues*/
+	isca_gw_rule_s const *rules;             /*!<Compiled rules, caller storage*/
+	isca_gw_stats_s stats[GW_MAX_RULES];     /*!<Statistics of each rule*/
+	isca_gw_ext_s ext[GW_EXT_SLOTS];         /*!<Exact 29-bit ID rules*/
+	uint8_t ext_masked[GW_MAX_RULES];        /*!<Masked 29-bit ID rules, in order*/
+	uint8_t n_src;                           /*!<Attached sources*/
+	uint8_t n_dst;                           /*!<Destination TX queues*/
+	uint8_t n_rules;                         /*!<Compiled rules*/
+	uint8_t n_masked;                        /*!<Masked 29-bit ID rules*/
+} isca_gw_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_gw_init(isca_gw_s *gw, isca_txq_s * const *dst, uint8_t n_dst);
+
+int isca_gw_attach(isca_gw_s *gw, can_ctrl_s *can_ctrl);
+
+int isca_gw_compile(isca_gw_s *gw, isca_gw_rule_s const *rules, uint8_t n_rules);
+
+int isca_gw_rx(can_ctrl_s *can_ctrl, can_frame_s const *rx_frame, uint32_t rx_ts, void *arg);
+
+isca_gw_stats_s const *isca_gw_stats(isca_gw_s const *gw, uint8_t rule);
+
+#endif /* ISCA_CAN_GW_H */
@@ -53,9 +53,16 @@
 #ifndef ISCA_CAN_IRQ_H
 #define ISCA_CAN_IRQ_H
 
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
 /******
  * FUNCTIONS DECLARATION
  ******/
 void ISCA_CAN_IntrHandler(void *can_ctrl);
 
+uint32_t isca_can_bh_run(can_ctrl_s *can_ctrl, uint32_t budget);
+
 #endif /* ISCA_CAN_IRQ_H */
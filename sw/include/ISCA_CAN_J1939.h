@@ -0,0 +1,204 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN J1939 transport protocol
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_J1939.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_J1939.h
+ *
+ * @brief SAE J1939 addressing and transport protocol, BAM and RTS/CTS
+ *
+ * A node sends and receives messages of up to 1785 bytes: single frames
+ * for up to 8 bytes, broadcast (BAM) or connection mode (RTS/CTS) transport
+ * sessions above. Sessions live in a fixed table, found through a hash of
+ * their (source, destination) address pair; a pair carries one transfer at
+ * a time, and TP.DT frames carry no PGN, so the PGN is checked on the
+ * connection management frames. Reassembly buffers are taken from the frame
+ * pool, \ref isca_frame_pool_alloc, and released once delivered.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_J1939_H
+#define ISCA_CAN_J1939_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if ((J1939_HASH_SLOTS & (J1939_HASH_SLOTS - 1U)) != 0) || (J1939_MAX_SESS > 255U) || \
+    (J1939_CTS_PACKETS == 0U) || (J1939_CTS_PACKETS > 255U)
+#error "J1939_HASH_SLOTS must be a power of two, J1939_MAX_SESS and J1939_CTS_PACKETS up to 255"
+#endif
+
+/*-----
+ * J1939 FUNCT RETURN
+ *----*/
+#define ISCA_J1939_FULL       (-1) /*!<No free session*/
+#define ISCA_J1939_BUSY       (-2) /*!<Transfer to this destination in progress*/
+#define ISCA_J1939_ABORTED    (-3) /*!<Connection aborted by the peer*/
+
+/*-----
+ * J1939 ADDRESSING
+ *----*/
+#define J1939_GLOBAL          (0xFFU)    /*!<Global destination address*/
+#define J1939_MAX_SIZE        (1785U)    /*!<Longest transport message*/
+#define J1939_PGN_TP_CM       (0xEC00U)  /*!<Transport connection management*/
+#define J1939_PGN_TP_DT       (0xEB00U)  /*!<Transport data transfer*/
+#define J1939_PRIO_TP         (7U)       /*!<Transport frames priority*/
+
+/*-----
+ * J1939 TRANSPORT TIMEOUTS
+ *----*/
+#define J1939_T1_US           (750000U)  /*!<Receiver: between data packets*/
+#define J1939_T2_US           (1250000U) /*!<Receiver: CTS to data packet*/
+#define J1939_T3_US           (1250000U) /*!<Sender: data packet to CTS or end of message ACK*/
+#define J1939_T4_US           (1050000U) /*!<Sender: hold CTS to CTS*/
+
+/// Transport session
+typedef struct isca_j1939_sess_s {
+	uint32_t pgn;                       /*!<Message PGN*/
+	uint8_t *buf;                       /*!<Reassembly buffer, from the frame pool*/
+	uint8_t const *data;                /*!<Message sent, caller's*/
+	uint32_t deadline;                  /*!<Timeout or next BAM packet, \ref ISCA_TIME_Us*/
+	uint16_t size;                      /*!<Message length*/
+	uint16_t seq;                       /*!<Next data packet sent or expected*/
+	uint16_t last;                      /*!<Last data packet of the CTS window*/
+	uint8_t  packets;                   /*!<Data packets*/
+	uint8_t  max_cts;                   /*!<Packets per CTS the sender accepts*/
+	uint8_t  sa;                        /*!<Source address*/
+	uint8_t  da;                        /*!<Destination address*/
+	uint8_t  state;                     /*!<Session state*/
+	uint8_t  pend;                      /*!<Control frame to send*/
+	uint8_t  reason;                    /*!<Abort reason to send*/
+	uint8_t  prio;                      /*!<Priority of the message*/
+	struct isca_j1939_sess_s *next;     /*!<Lookup chain or free list*/
+} isca_j1939_sess_s;
+
+struct isca_j1939_s;
+
+/// Message received; data is valid during the call only
+typedef void (*isca_j1939_rx_t)(struct isca_j1939_s *j, uint32_t pgn, uint8_t sa, uint8_t da,
+                                uint8_t const *data, uint32_t len);
+
+/// Transport message sent, \ref ISCA_CAN_OK, or not
+typedef void (*isca_j1939_tx_t)(struct isca_j1939_s *j, uint32_t pgn, uint8_t da, int res);
+
+/// J1939 node description structure
+typedef struct isca_j1939_s {
+	can_ctrl_s *can_ctrl;                   /*!<2B controller*/
+	uint8_t addr;                           /*!<Own source address*/
+	isca_j1939_rx_t rx_cb;                  /*!<Message received callback*/
+	isca_j1939_tx_t tx_cb;                  /*!<Transport message sent callback*/
+	void *arg;                              /*!<Caller context*/
+	isca_j1939_sess_s *hash[J1939_HASH_SLOTS]; /*!<Sessions by address pair*/
+	isca_j1939_sess_s *free;                /*!<Free sessions*/
+	isca_j1939_sess_s sess[J1939_MAX_SESS]; /*!<Session table*/
+	uint32_t aborts;                        /*!<Transfers aborted or timed out*/
+	uint32_t no_mem;                        /*!<Transfers refused, no session or buffer*/
+} isca_j1939_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_j1939_init(isca_j1939_s *j, can_ctrl_s *can_ctrl, uint8_t addr,
+                     isca_j1939_rx_t rx_cb, isca_j1939_tx_t tx_cb, void *arg);
+
+int isca_j1939_send(isca_j1939_s *j, uint8_t prio, uint32_t pgn, uint8_t da, uint8_t const *data, uint32_t len);
+
+void isca_j1939_input(isca_j1939_s *j, can_frame_s const *rx_frame);
+
+uint32_t isca_j1939_poll(isca_j1939_s *j, uint32_t budget);
+
+/**
+ * @brief      29-bit identifier of a J1939 frame
+ * @param[in]  prio  Priority, 0 (highest) to 7
+ * @param[in]  pgn   Parameter group number
+ * @param[in]  sa    Source address
+ * @param[in]  da    Destination address, PDU1 PGNs only
+ * @return     Identifier
+ */
+static inline uint32_t isca_j1939_id(uint8_t prio, uint32_t pgn, uint8_t sa, uint8_t da) {
+
+	uint32_t id = ((uint32_t)(prio & 7U) << 26) | ((pgn & 0x3FFFFU) << 8) | sa;
+
+	if ( ((pgn >> 8) & 0xFFU) < 240U ) {
+		id = (id & ~0xFF00U) | ((uint32_t)da << 8);
+	} /*PDU1: PS is the destination address*/
+
+	return id;
+}
+
+/// PGN of a 29-bit identifier; the destination address of PDU1 PGNs is cleared
+static inline uint32_t isca_j1939_pgn(uint32_t id) {
+
+	uint32_t pgn = (id >> 8) & 0x3FFFFU;
+
+	return (((pgn >> 8) & 0xFFU) < 240U) ? (pgn & 0x3FF00U) : pgn;
+}
+
+/// Source address of a 29-bit identifier
+static inline uint8_t isca_j1939_sa(uint32_t id) {
+
+	return (uint8_t)id;
+
+}
+
+/// Destination address of a 29-bit identifier, \ref J1939_GLOBAL for PDU2 PGNs
+static inline uint8_t isca_j1939_da(uint32_t id) {
+
+	return (((id >> 16) & 0xFFU) < 240U) ? (uint8_t)(id >> 8) : J1939_GLOBAL;
+
+}
+
+/// Priority of a 29-bit identifier
+static inline uint8_t isca_j1939_prio(uint32_t id) {
+
+	return (uint8_t)((id >> 26) & 7U);
+
+}
+
+#endif /* ISCA_CAN_J1939_H */
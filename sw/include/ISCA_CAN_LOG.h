@@ -0,0 +1,120 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN event log
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_LOG.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_LOG.h
+ *
+ * @brief Binary event log, safe to write from interrupt context
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_LOG_H
+#define ISCA_CAN_LOG_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_IO.h"
+#include "ISCA_CAN_CFG.h"
+
+/******
+ * DEFINITIONS
+ ******/
+/*
+ * Event ids
+ */
+#define LOG_EV_ERR_WARN     (1U)  /*!<Error warning IRQ; arg0: IRQ status, arg1: controller address*/
+#define LOG_EV_RX_OVERRUN   (2U)  /*!<RX FIFO overrun IRQ; arg0: IRQ status, arg1: controller address*/
+#define LOG_EV_ERR_PASSIVE  (3U)  /*!<Error passive IRQ; arg0: IRQ status, arg1: controller address*/
+#define LOG_EV_ARB_LOST     (4U)  /*!<Arbitration lost IRQ; arg0: IRQ status, arg1: controller address*/
+#define LOG_EV_BUS_ERROR    (5U)  /*!<Bus error IRQ; arg0: IRQ status, arg1: controller address*/
+#define LOG_EV_RX_DROP      (6U)  /*!<RX queue full; arg0: frames dropped, arg1: controller address*/
+#define LOG_EV_RX_BLOCKED   (7U)  /*!<RX queue full, RX IRQ masked; arg0: frames held, arg1: controller address*/
+#define LOG_EV_COUNT        (8U)
+
+/// Event log record
+typedef struct isca_log_rec_s {
+	uint32_t ts;      /*!<\ref ISCA_TIME_Us timestamp*/
+	uint16_t event;   /*!<Event id, e.g., \ref LOG_EV_ERR_WARN*/
+	uint8_t  level;   /*!<\ref LOG_ERROR, \ref LOG_WARN or \ref LOG_INFO*/
+	uint8_t  rsvd;    /*!<Reserved*/
+	uint32_t arg0;    /*!<Event argument*/
+	uint32_t arg1;    /*!<Event argument*/
+} isca_log_rec_s;
+
+/*
+ * Logging macros; filtered at compile time by LOG_LEVEL
+ */
+#if (LOG_LEVEL >= LOG_ERROR)
+#define __LOG_ERROR(ev, a0, a1) (isca_log_put(LOG_ERROR, (ev), (uint32_t)(a0), (uint32_t)(a1)))
+#else
+#define __LOG_ERROR(ev, a0, a1) ((void)0)
+#endif
+
+#if (LOG_LEVEL >= LOG_WARN)
+#define __LOG_WARN(ev, a0, a1)  (isca_log_put(LOG_WARN, (ev), (uint32_t)(a0), (uint32_t)(a1)))
+#else
+#define __LOG_WARN(ev, a0, a1)  ((void)0)
+#endif
+
+#if (LOG_LEVEL >= LOG_INFO)
+#define __LOG_INFO(ev, a0, a1)  (isca_log_put(LOG_INFO, (ev), (uint32_t)(a0), (uint32_t)(a1)))
+#else
+#define __LOG_INFO(ev, a0, a1)  ((void)0)
+#endif
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_log_put(uint8_t level, uint16_t event, uint32_t arg0, uint32_t arg1);
+
+int isca_log_pop(isca_log_rec_s *rec);
+
+uint32_t isca_log_drain(uint32_t max);
+
+uint32_t isca_log_lost(void);
+
+#endif /* ISCA_CAN_LOG_H */
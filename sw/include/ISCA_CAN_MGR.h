@@ -0,0 +1,105 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN multi-controller manager
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_MGR.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_MGR.h
+ *
+ * @brief Services several CAN controllers from a single reactor loop
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_MGR_H
+#define ISCA_CAN_MGR_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if (CAN_MGR_MAX > 32U)
+#error "CAN_MGR_MAX must not exceed 32"
+#endif
+
+/*-----
+ * MANAGER FUNCT RETURN
+ *----*/
+#define ISCA_MGR_FULL        (-1) /*!<No free controller entry*/
+#define ISCA_MGR_INV_CTRL    (-2) /*!<Controller not in interrupt mode, or already managed*/
+
+/// Per controller statistics
+typedef struct isca_can_mgr_stats_s {
+	uint32_t irqs;        /*!<Interrupts dispatched*/
+	uint32_t rounds;      /*!<Rounds the controller was served in*/
+	uint32_t frames;      /*!<Staged frames handled by its bottom half*/
+	uint32_t quota_hits;  /*!<Rounds ended by \ref CAN_MGR_QUANTUM with work left*/
+} isca_can_mgr_stats_s;
+
+/// Manager description structure
+typedef struct isca_can_mgr_s {
+	can_ctrl_s *ctrl[CAN_MGR_MAX];             /*!<Managed controllers*/
+	uint32_t irq_src[CAN_MGR_MAX];             /*!<Interrupt source of each controller*/
+	isca_can_mgr_stats_s stats[CAN_MGR_MAX];   /*!<Statistics of each controller*/
+	volatile uint32_t pending;                 /*!<Controllers with bottom half work, one bit each*/
+	uint8_t count;                             /*!<Managed controllers*/
+	uint8_t next;                              /*!<Round robin start*/
+	isca_wait_s wait;                          /*!<Reactor wait object, signalled on dispatch*/
+} isca_can_mgr_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_can_mgr_init(isca_can_mgr_s *mgr);
+
+int isca_can_mgr_add(isca_can_mgr_s *mgr, can_ctrl_s *can_ctrl, uint32_t irq_src);
+
+void isca_can_mgr_irq(isca_can_mgr_s *mgr, uint32_t irq_src);
+
+int isca_can_mgr_poll(isca_can_mgr_s *mgr, uint32_t budget, uint32_t timeout_us);
+
+#endif /* ISCA_CAN_MGR_H */
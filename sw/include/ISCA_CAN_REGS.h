@@ -0,0 +1,951 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN register map
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_REGS.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_REGS.h
+ *
+ * @brief CAN controller register map of both operating modes
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_REGS_H
+#define ISCA_CAN_REGS_H
+
+/******
+ * DEFINITIONS
+ ******/
+
+
+/**
+ * @brief CAN controller base address fixed offset definition
+ * */
+#define CAN_BASE_OFFSET       (0U)
+
+/* CAN controller registers offset; _2A / _2B suffixed registers exist in that mode only */
+
+/**
+ * @brief Mode configuration register0, common offset; see
+ * \ref CAN_MODE0_REG_2A and \ref CAN_MODE0_REG_2B for the layouts
+ * */
+#define CAN_MODE0_REG         (CAN_BASE_OFFSET)
+
+/**
+ * @brief Mode configuration register0, 2A mode
+ *
+ * Layout (0 disable, 1 enable):
+ * @code
+ * CAN_MODE0_REG_2A[7:5] -> reserved,
+ * CAN_MODE0_REG_2A[4:4] -> overrun_irq_en_basic,
+ * CAN_MODE0_REG_2A[3:3] -> error_irq_en_basic,
+ * CAN_MODE0_REG_2A[2:2] -> transmit_irq_en_basic,
+ * CAN_MODE0_REG_2A[1:1] -> receive_irq_en_basic,
+ * CAN_MODE0_REG_2A[0:0] -> reset_mode
+ * @endcode
+ * */
+#define CAN_MODE0_REG_2A      (CAN_BASE_OFFSET)
+
+/**
+ * @brief Mode configuration register0, 2B mode
+ *
+ * Layout (0 disable, 1 enable):
+ * @code
+ * CAN_MODE0_REG_2B[7:4] -> reserved,
+ * CAN_MODE0_REG_2B[3:3] -> single_acceptance_filter_mode,
+ * CAN_MODE0_REG_2B[2:2] -> self_test_mode,
+ * CAN_MODE0_REG_2B[1:1] -> listen_only_mode,
+ * CAN_MODE0_REG_2B[0:0] -> reset_mode
+ * @endcode
+ * */
+#define CAN_MODE0_REG_2B      (CAN_BASE_OFFSET)
+
+/**
+ * @brief Filter Mode enable register
+ *
+ * Layout (0 disable, 1 enable):
+ * @code
+ * CAN_FILTER_MODE_REG[7:1] -> reserved
+ * CAN_FILTER_MODE_REG[0:0] -> filter_mode
+ * @endcode
+ * */
+#define CAN_FILTER_MODE_REG   (CAN_BASE_OFFSET+12U)
+
+/**
+ * @brief IRQs enable register0 (Write-only)
+ *
+ * Layout (0 disable, 1 enable):
+ * @code
+ * CAN_IRQS_EN_REG_2B[7] -> bus_error_irq_en
+ * CAN_IRQS_EN_REG_2B[6] -> arbitration_lost_irq_en
+ * CAN_IRQS_EN_REG_2B[5] -> error_passive_irq_en
+ * CAN_IRQS_EN_REG_2B[4] -> reserved
+ * CAN_IRQS_EN_REG_2B[3] -> data_overrun_irq_en_ext
+ * CAN_IRQS_EN_REG_2B[2] -> error_warning_irq_en_ext
+ * CAN_IRQS_EN_REG_2B[1] -> transmit_irq_en_ext
+ * CAN_IRQS_EN_REG_2B[0] -> receive_irq_en_ext
+ * @endcode
+ * */
+#define CAN_IRQS_EN_REG_2B    (CAN_BASE_OFFSET+16U)
+
+/**
+ * @brief IRQs status register0 (Read-only)
+ *
+ * Layout (0 inactive, 1 active; bits 7:5 are 2B mode only):
+ * @code
+ * CAN_IRQS_STATUS_REG[7] -> bus_error_irq_en
+ * CAN_IRQS_STATUS_REG[6] -> arbitration_lost_irq_en
+ * CAN_IRQS_STATUS_REG[5] -> error_passive_irq_en
+ * CAN_IRQS_STATUS_REG[4] -> reserved
+ * CAN_IRQS_STATUS_REG[3] -> data_overrun_irq_en_ext
+ * CAN_IRQS_STATUS_REG[2] -> error_warning_irq_en_ext
+ * CAN_IRQS_STATUS_REG[1] -> transmit_irq_en_ext
+ * CAN_IRQS_STATUS_REG[0] -> receive_irq_en_ext
+ * @endcode
+ * */
+#define CAN_IRQS_STATUS_REG   (CAN_BASE_OFFSET+12U)
+
+/**
+ * @brief CAN clear IRQ register (Read-only)
+ *
+ * A read request to the CAN clear IRQ register clears the interrupt
+ * at the CAN controller
+ * */
+#define CAN_IRQ_CLEAR         (CAN_BASE_OFFSET+4U)
+
+/**
+ * @brief CAN command TX register (Write-Only)
+ *
+ * Layout:
+ * @code
+ * CAN_COMMAND_TX_REG[7:1] -> reserved
+ * CAN_COMMAND_TX_REG[4]   -> trigger TX (1 enable)
+ * @endcode
+ * */
+#define CAN_COMMAND_TX_REG    (CAN_BASE_OFFSET+4U)
+
+/**
+ * @brief CAN command RX register  (Write-Only)
+ *
+ * Layout:
+ * @code
+ * CAN_COMMAND_RX_REG[7:4] -> reserved
+ * CAN_COMMAND_RX_REG[2]   -> release RX buffer, decrease RX counter (1 enable)
+ * CAN_COMMAND_RX_REG[3]   -> clear RX FIFO overrun (1 enable)
+ * CAN_COMMAND_RX_REG[1:0] -> reserved
+ * @endcode
+ * */
+#define CAN_COMMAND_RX_REG    (CAN_BASE_OFFSET+8U)
+
+/**
+ * @brief CAN status register (Read-only)
+ *
+ * Layout:
+ * @code
+ * CAN_STATUS_REG[0] -> receive buffer status
+ * CAN_STATUS_REG[1] -> overrun status (1:overrun)
+ * CAN_STATUS_REG[2] -> transmit buffer status(1:idle, 0:busy)
+ * CAN_STATUS_REG[3] -> transmission complete status
+ * CAN_STATUS_REG[4] -> receive status
+ * CAN_STATUS_REG[5] -> transmit status
+ * CAN_STATUS_REG[6] -> error status
+ * CAN_STATUS_REG[7] -> node buss off
+ * @endcode
+ * */
+#define CAN_STATUS_REG        (CAN_BASE_OFFSET+8U)
+
+/**
+ * @brief ID CODE register0
+ *
+ * Layout:
+ * @code
+ * CAN_CODE_REG0_2A[7:0] -> CODE(ID)[10:3]
+ * @endcode
+ * */
+#define CAN_CODE_REG0_2A      (CAN_BASE_OFFSET+16U)
+
+/**
+ * @brief ID CODE register1
+ *
+ * Layout:
+ * @code
+ * CAN_CODE_REG1_2A[2:0] -> CODE(ID)[2:0]
+ * @endcode
+ * */
+#define CAN_CODE_REG1_2A      (CAN_BASE_OFFSET+68U)
+
+/**
+ * @brief ID MASK register0
+ *
+ * Layout:
+ * @code
+ * CAN_MASK_REG0_2A[7:0] -> CODE(ID)[10:3]
+ * @endcode
+ * */
+#define CAN_MASK_REG0_2A      (CAN_BASE_OFFSET+20U)
+
+/**
+ * @brief ID MASK register1
+ *
+ * Layout:
+ * @code
+ * CAN_MASK_REG1_2A[2:0] -> CODE(ID)[2:0]
+ * @endcode
+ * */
+#define CAN_MASK_REG1_2A      (CAN_BASE_OFFSET+84U)
+
+/**
+ * @brief CAN code register 0
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_CODE_REG0_2B[0] -> id[21]  CAN_CODE_REG0_2B[1] -> id[22]
+ * CAN_CODE_REG0_2B[2] -> id[23]  CAN_CODE_REG0_2B[3] -> id[24]
+ * CAN_CODE_REG0_2B[4] -> id[25]  CAN_CODE_REG0_2B[5] -> id[26]
+ * CAN_CODE_REG0_2B[6] -> id[27]  CAN_CODE_REG0_2B[7] -> id[28]
+ * @endcode
+ *
+ * Layout \b standard frame, single filtering:
+ * @code
+ * CAN_CODE_REG0_2B[0] -> id[3]  CAN_CODE_REG0_2B[1] -> id[4]
+ * CAN_CODE_REG0_2B[2] -> id[5]  CAN_CODE_REG0_2B[3] -> id[6]
+ * CAN_CODE_REG0_2B[4] -> id[7]  CAN_CODE_REG0_2B[5] -> id[8]
+ * CAN_CODE_REG0_2B[6] -> id[9]  CAN_CODE_REG0_2B[7] -> id[10]
+ * @endcode
+ *
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_CODE_REG0_2B      (CAN_BASE_OFFSET+64U)
+
+/**
+ * @brief CAN code register 1
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_CODE_REG1_2B[0] -> id[13]  CAN_CODE_REG1_2B[1] -> id[14]
+ * CAN_CODE_REG1_2B[2] -> id[15]  CAN_CODE_REG1_2B[3] -> id[16]
+ * CAN_CODE_REG1_2B[4] -> id[17]  CAN_CODE_REG1_2B[5] -> id[18]
+ * CAN_CODE_REG1_2B[6] -> id[19]  CAN_CODE_REG1_2B[7] -> id[20]
+ * @endcode
+ *
+ * Layout \b standard frame single filtering:
+ * @code
+ * CAN_CODE_REG1_2B[0] -> none   CAN_CODE_REG1_2B[1] -> none
+ * CAN_CODE_REG1_2B[2] -> none   CAN_CODE_REG1_2B[3] -> none
+ * CAN_CODE_REG1_2B[4] -> rtr    CAN_CODE_REG1_2B[5] -> id[0]
+ * CAN_CODE_REG1_2B[6] -> id[1]  CAN_CODE_REG1_2B[7] -> id[2]
+ * @endcode
+ *
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_CODE_REG1_2B      (CAN_BASE_OFFSET+68U)
+
+/**
+ * @brief CAN code register 2
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_CODE_REG2_2B[0] -> id[5]   CAN_CODE_REG2_2B[1] -> id[6]
+ * CAN_CODE_REG2_2B[2] -> id[7]   CAN_CODE_REG2_2B[3] -> id[8]
+ * CAN_CODE_REG2_2B[4] -> id[9]   CAN_CODE_REG2_2B[5] -> id[10]
+ * CAN_CODE_REG2_2B[6] -> id[11]  CAN_CODE_REG2_2B[7] -> id[12]
+ * @endcode
+ *
+ * Layout \b standard frame single filtering:
+ * @code
+ * CAN_CODE_REG2_2B[0] -> data0[0] , CAN_CODE_REG2_2B[1] -> data0[1]
+ * CAN_CODE_REG2_2B[2] -> data0[2] , CAN_CODE_REG2_2B[3] -> data0[3]
+ * CAN_CODE_REG2_2B[4] -> data0[4] , CAN_CODE_REG2_2B[5] -> data0[5]
+ * CAN_CODE_REG2_2B[6] -> data0[6] , CAN_CODE_REG2_2B[7] -> data0[7]
+ * @endcode
+ *
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_CODE_REG2_2B      (CAN_BASE_OFFSET+72U)
+
+/**
+ * @brief CAN code register 3
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_CODE_REG3_2B[0] -> none  , CAN_CODE_REG3_2B[1] -> none
+ * CAN_CODE_REG3_2B[2] -> rtr   , CAN_CODE_REG3_2B[3] -> id[0]
+ * CAN_CODE_REG3_2B[4] -> id[1] , CAN_CODE_REG3_2B[5] -> id[2]
+ * CAN_CODE_REG3_2B[6] -> id[3] , CAN_CODE_REG3_2B[7] -> id[4]
+ * @endcode
+ *
+ * Layout \b standard frame single filtering:
+ * @code
+ * CAN_CODE_REG3_2B[0] -> data1[0]  CAN_CODE_REG3_2B[1] -> data1[1]
+ * CAN_CODE_REG3_2B[2] -> data1[2]  CAN_CODE_REG3_2B[3] -> data1[3]
+ * CAN_CODE_REG3_2B[4] -> data1[4]  CAN_CODE_REG3_2B[5] -> data1[5]
+ * CAN_CODE_REG3_2B[6] -> data1[6]  CAN_CODE_REG3_2B[7] -> data1[7]
+ * @endcode
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_CODE_REG3_2B      (CAN_BASE_OFFSET+76U)
+
+/**
+ * @brief CAN mask register 0
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_MASK_REG0_2B[0] -> id[21]  CAN_MASK_REG0_2B[1] -> id[22]
+ * CAN_MASK_REG0_2B[2] -> id[23]  CAN_MASK_REG0_2B[3] -> id[24]
+ * CAN_MASK_REG0_2B[4] -> id[25]  CAN_MASK_REG0_2B[5] -> id[26]
+ * CAN_MASK_REG0_2B[6] -> id[27]  CAN_MASK_REG0_2B[7] -> id[28]
+ * @endcode
+ *
+ * Layout \b standard frame single filtering:
+ * @code
+ * CAN_MASK_REG0_2B[0] -> id[3]  CAN_MASK_REG0_2B[1] -> id[4]
+ * CAN_MASK_REG0_2B[2] -> id[5]  CAN_MASK_REG0_2B[3] -> id[6]
+ * CAN_MASK_REG0_2B[4] -> id[7]  CAN_MASK_REG0_2B[5] -> id[8]
+ * CAN_MASK_REG0_2B[6] -> id[9]  CAN_MASK_REG0_2B[7] -> id[10]
+ * @endcode
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_MASK_REG0_2B      (CAN_BASE_OFFSET+80U)
+
+/**
+ * @brief CAN mask register 1
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_MASK_REG1_2B[0] -> id[13]  CAN_MASK_REG1_2B[1] -> id[14]
+ * CAN_MASK_REG1_2B[2] -> id[15]  CAN_MASK_REG1_2B[3] -> id[16]
+ * CAN_MASK_REG1_2B[4] -> id[17]  CAN_MASK_REG1_2B[5] -> id[18]
+ * CAN_MASK_REG1_2B[6] -> id[19]  CAN_MASK_REG1_2B[7] -> id[20]
+ * @endcode
+ *
+ * Layout \b standard frame single filtering:
+ * @code
+ * CAN_MASK_REG1_2B[0] -> none   CAN_MASK_REG1_2B[1] -> none
+ * CAN_MASK_REG1_2B[2] -> none   CAN_MASK_REG1_2B[3] -> none
+ * CAN_MASK_REG1_2B[4] -> rtr    CAN_MASK_REG1_2B[5] -> id[0]
+ * CAN_MASK_REG1_2B[6] -> id[1]  CAN_MASK_REG1_2B[7] -> id[2]
+ * @endcode
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_MASK_REG1_2B      (CAN_BASE_OFFSET+84U)
+
+/**
+ * @brief CAN mask register 2
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_MASK_REG2_2B[0] -> id[ 5]  CAN_MASK_REG2_2B[1] -> id[ 6]
+ * CAN_MASK_REG2_2B[2] -> id[ 7]  CAN_MASK_REG2_2B[3] -> id[ 8]
+ * CAN_MASK_REG2_2B[4] -> id[ 9]  CAN_MASK_REG2_2B[5] -> id[10]
+ * CAN_MASK_REG2_2B[6] -> id[11]  CAN_MASK_REG2_2B[7] -> id[12]
+ * @endcode
+ *
+ * Layout \b standard frame single filtering:
+ * @code
+ * CAN_MASK_REG2_2B[0] -> data0[0]  CAN_MASK_REG2_2B[1] -> data0[1]
+ * CAN_MASK_REG2_2B[2] -> data0[2]  CAN_MASK_REG2_2B[3] -> data0[3]
+ * CAN_MASK_REG2_2B[4] -> data0[4]  CAN_MASK_REG2_2B[5] -> data0[5]
+ * CAN_MASK_REG2_2B[6] -> data0[6]  CAN_MASK_REG2_2B[7] -> data0[7]
+ * @endcode
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_MASK_REG2_2B      (CAN_BASE_OFFSET+88U)
+
+/**
+ * @brief CAN mask register 3
+ *
+ * Layout \b extended frame single filtering:
+ * @code
+ * CAN_MASK_REG3_2B[0] -> none   CAN_MASK_REG3_2B[1] -> none
+ * CAN_MASK_REG3_2B[2] -> rtr    CAN_MASK_REG3_2B[3] -> id[0]
+ * CAN_MASK_REG3_2B[4] -> id[1]  CAN_MASK_REG3_2B[5] -> id[2]
+ * CAN_MASK_REG3_2B[6] -> id[3]  CAN_MASK_REG3_2B[7] -> id[4]
+ * @endcode
+ *
+ * Layout \b standard frame single filtering:
+ * @code
+ * CAN_MASK_REG3_2B[0] -> data1[0]  CAN_MASK_REG3_2B[1] -> data1[1]
+ * CAN_MASK_REG3_2B[2] -> data1[2]  CAN_MASK_REG3_2B[3] -> data1[3]
+ * CAN_MASK_REG3_2B[4] -> data1[4]  CAN_MASK_REG3_2B[5] -> data1[5]
+ * CAN_MASK_REG3_2B[6] -> data1[6]  CAN_MASK_REG3_2B[7] -> data1[7]
+ * @endcode
+ * @see CAN_MODE0_REG
+ * */
+#define CAN_MASK_REG3_2B      (CAN_BASE_OFFSET+92U)
+
+/**
+ * @brief Bus timing register 0
+ *
+ * Layout:
+ * @code
+ * CAN_BTR0_REG[7:6] -> Synch Jump Width: (value+1)
+ * CAN_BTR0_REG[5:0] -> Baud rate prescaler: 2*(value+1)
+ * @endcode
+ * */
+#define CAN_BTR0_REG          (CAN_BASE_OFFSET+24U)
+
+/**
+ * @brief Bus timing register 1
+ *
+ * Layout:
+ * @code
+ * CAN_BTR1_REG[7:7] -> Triple sampling (0 disable, 1 enable)
+ * CAN_BTR1_REG[6:4] -> TSEG1: (value+1)
+ * CAN_BTR1_REG[3:0] -> TSEG2: (value+1)
+ * @endcode
+ * */
+#define CAN_BTR1_REG          (CAN_BASE_OFFSET+28U)
+
+/**
+ * @brief RX counter register
+ *
+ * Layout:
+ * @code
+ * CAN_RX_COUNTER_REG[6:0] -> unread frames
+ * @endcode
+ * */
+#define CAN_RX_COUNTER_REG_2A (CAN_BASE_OFFSET+32U)
+#define CAN_RX_COUNTER_REG_2B (CAN_BASE_OFFSET+116U)
+
+/**
+ * @brief Acknowledge invalid RX register (Read-only)
+ *
+ * RX FIFO overrun occurred; reading \ref CAN_INVALID_RX_ACK_REG
+ * acknowledges overrun. Layout:
+ * @code
+ * CAN_INVALID_RX_ACK_REG[7:1] -> reserved
+ * CAN_INVALID_RX_ACK_REG[0:0] -> RX state ('1' valid)
+ * @endcode
+ * @note After acknowledging you should also decrease RX counter
+ * */
+#define CAN_INVALID_RX_ACK_REG    (CAN_BASE_OFFSET+4U)
+
+/**
+ * @brief TX buffer0 register, layout:
+ * @code
+ * CAN_TX0_REG_2A[7:0] -> can_frame_s.ID[10:3]
+ * @endcode
+ * */
+#define CAN_TX0_REG_2A        (CAN_BASE_OFFSET+40U)
+
+/**
+ * @brief TX buffer1 register, layout:
+ * @code
+ * CAN_TX1_REG_2A[7:5] -> can_frame_s.ID[2:0]
+ * CAN_TX1_REG_2A[4:4] -> can_frame_s.RTR
+ * CAN_TX1_REG_2A[3:0] -> can_frame_s.DLC
+ * @endcode
+ * */
+#define CAN_TX1_REG_2A        (CAN_BASE_OFFSET+44U)
+
+/**
+ * @brief TX buffer2 register, layout:
+ * @code
+ * CAN_TX2_REG_2A[7:0] -> can_frame_s.DATA[0]
+ * @endcode
+ * */
+#define CAN_TX2_REG_2A        (CAN_BASE_OFFSET+48U)
+
+/**
+ * @brief TX buffer3 register, layout:
+ * @code
+ * CAN_TX3_REG_2A[7:0] -> can_frame_s.DATA[1]
+ * */
+#define CAN_TX3_REG_2A        (CAN_BASE_OFFSET+52U)
+
+/**
+ * @brief TX buffer4 register, layout:
+ * @code
+ * CAN_TX4_REG_2A[7:0] -> can_frame_s.DATA[2]
+ * @endcode
+ * */
+#define CAN_TX4_REG_2A        (CAN_BASE_OFFSET+56U)
+
+/**
+ * @brief TX buffer5 register, layout:
+ * @code
+ * CAN_TX5_REG_2A[7:0] -> can_frame_s.DATA[3]
+ * @endcode
+ * */
+#define CAN_TX5_REG_2A        (CAN_BASE_OFFSET+60U)
+
+/**
+ * @brief TX buffer6 register, layout:
+ * @code
+ * CAN_TX6_REG_2A[7:0] -> can_frame_s.DATA[4]
+ * @endcode
+ * */
+#define CAN_TX6_REG_2A        (CAN_BASE_OFFSET+64U)
+
+/**
+ * @brief TX buffer7 register, layout:
+ * @code
+ * CAN_TX7_REG_2A[7:0] -> can_frame_s.DATA[5]
+ * @endcode
+ * */
+#define CAN_TX7_REG_2A        (CAN_BASE_OFFSET+68U)
+
+/**
+ * @brief TX buffer8 register, layout:
+ * @code
+ * CAN_TX8_REG_2A[7:0] -> can_frame_s.DATA[6]
+ * @endcode
+ * */
+#define CAN_TX8_REG_2A        (CAN_BASE_OFFSET+72U)
+
+/**
+ * @brief TX buffer9 register, layout:
+ * @code
+ * CAN_TX9_REG_2A[7:0] -> can_frame_s.DATA[7]
+ * @endcode
+ * */
+#define CAN_TX9_REG_2A        (CAN_BASE_OFFSET+76U)
+
+/**
+ * @brief RX buffer0 register, layout:
+ * @code
+ * CAN_RX0_REG_2A[7:0] -> can_frame_s.ID[10:3]
+ * @endcode
+ * */
+#define CAN_RX0_REG_2A        (CAN_BASE_OFFSET+80U)
+
+/**
+ * @brief RX buffer1 register, layout:
+ * @code
+ * CAN_RX1_REG_2A[7:5] -> ID[2:0]
+ * CAN_RX1_REG_2A[4:4] -> RTR
+ * CAN_RX1_REG_2A[3:0] -> DLC
+ * @endcode
+ * */
+#define CAN_RX1_REG_2A        (CAN_BASE_OFFSET+84U)
+
+/**
+ * @brief RX buffer2 register, layout:
+ * @code
+ * CAN_RX2_REG_2A[7:0] -> can_frame_s.DATA[0]
+ * @endcode
+ * */
+#define CAN_RX2_REG_2A        (CAN_BASE_OFFSET+88U)
+
+/**
+ * @brief RX buffer3 register, layout:
+ * @code
+ * CAN_RX3_REG_2A[7:0] -> can_frame_s.DATA[1]
+ * @endcode
+ * */
+#define CAN_RX3_REG_2A        (CAN_BASE_OFFSET+92U)
+
+/**
+ * @brief RX buffer4 register, layout:
+ * @code
+ * CAN_RX4_REG_2A[7:0] -> can_frame_s.DATA[2]
+ * @endcode
+ * */
+#define CAN_RX4_REG_2A        (CAN_BASE_OFFSET+96U)
+
+/**
+ * @brief RX buffer5 register, layout:
+ * @code
+ * CAN_RX5_REG_2A[7:0] -> can_frame_s.DATA[3]
+ * @endcode
+ * */
+#define CAN_RX5_REG_2A        (CAN_BASE_OFFSET+100U)
+
+/**
+ * @brief RX buffer6 register, layout:
+ * @code
+ * CAN_RX6_REG_2A[7:0] -> can_frame_s.DATA[4]
+ * @endcode
+ * */
+#define CAN_RX6_REG_2A        (CAN_BASE_OFFSET+104U)
+
+/**
+ * @brief RX buffer7 register, layout:
+ * @code
+ * CAN_RX7_REG_2A[7:0] -> can_frame_s.DATA[5]
+ * @endcode
+ * */
+#define CAN_RX7_REG_2A        (CAN_BASE_OFFSET+108U)
+
+/**
+ * @brief RX buffer8 register, layout:
+ * @code
+ * CAN_RX8_REG_2A[7:0] -> can_frame_s.DATA[6]
+ * @endcode
+ * */
+#define CAN_RX8_REG_2A        (CAN_BASE_OFFSET+112U)
+
+/**
+ * @brief RX buffer9 register, layout:
+ * @code
+ * CAN_RX9_REG_2A[7:0] -> can_frame_s.DATA[7]
+ * @endcode
+ * */
+#define CAN_RX9_REG_2A        (CAN_BASE_OFFSET+116U)
+
+/**
+ * @brief TX buffer0 register, layout:
+ * @code
+ * CAN_TX0_REG_2B[7]   -> can_frame_s.IDE
+ * CAN_TX0_REG_2B[6]   -> can_frame_s.RTR
+ * CAN_TX0_REG_2B[5:4] -> Reserved
+ * CAN_TX0_REG_2B[3:0] -> can_frame_s.DLC
+ * @endcode
+ * */
+#define CAN_TX0_REG_2B        (CAN_BASE_OFFSET+64U)
+
+/**
+ * @brief TX buffer1 register, layout:
+ * @code
+ * CAN_TX1_REG_2B[7:0] -> can_frame_s.ID[28:21]
+ * @endcode
+ * */
+#define CAN_TX1_REG_2B        (CAN_BASE_OFFSET+68U)
+
+/**
+ * @brief TX buffer2 register, layout:
+ * @code
+ * CAN_TX2_REG_2B[7:0] -> can_frame_s.ID[20:13]
+ * @endcode
+ * */
+#define CAN_TX2_REG_2B        (CAN_BASE_OFFSET+72U)
+
+/**
+ * @brief TX buffer3 register, layout:
+ * @code
+ * CAN_TX3_REG_2B[7:0] -> can_frame_s.ID[12:5]
+ * @endcode
+ * */
+#define CAN_TX3_REG_2B        (CAN_BASE_OFFSET+76U)
+
+/**
+ * @brief TX buffer4 register, layout:
+ * @code
+ * CAN_TX4_REG_2B[7:3] -> can_frame_s.ID[4:0]
+ * CAN_TX4_REG_2B[2:0] -> Reserved
+ * @endcode
+ * */
+#define CAN_TX4_REG_2B        (CAN_BASE_OFFSET+80U)
+
+/**
+ * @brief TX buffer5 register, layout:
+ * @code
+ * CAN_TX5_REG_2B[7:0] -> can_frame_s.DATA[0]
+ * @endcode
+ * */
+#define CAN_TX5_REG_2B        (CAN_BASE_OFFSET+84U)
+
+/**
+ * @brief TX buffer6 register, layout:
+ * @code
+ * CAN_TX6_REG_2B[7:0] -> can_frame_s.DATA[1]
+ * @endcode
+ * */
+#define CAN_TX6_REG_2B        (CAN_BASE_OFFSET+88U)
+
+/**
+ * @brief TX buffer7 register, layout:
+ * @code
+ * CAN_TX7_REG_2B[7:0] -> can_frame_s.DATA[2]
+ * @endcode
+ * */
+#define CAN_TX7_REG_2B        (CAN_BASE_OFFSET+92U)
+
+/**
+ * @brief TX buffer8 register, layout:
+ * @code
+ * CAN_TX8_REG_2B[7:0] -> can_frame_s.DATA[3]
+ * @endcode
+ * */
+#define CAN_TX8_REG_2B        (CAN_BASE_OFFSET+96U)
+
+/**
+ * @brief TX buffer9 register, layout:
+ * @code
+ * CAN_TX9_REG_2B[7:0] -> can_frame_s.DATA[4]
+ * @endcode
+ * */
+#define CAN_TX9_REG_2B        (CAN_BASE_OFFSET+100U)
+
+/**
+ * @brief TX buffer10 register, layout:
+ * @code
+ * CAN_TX10_REG_2B[7:0] -> can_frame_s.DATA[5]
+ * @endcode
+ * */
+#define CAN_TX10_REG_2B       (CAN_BASE_OFFSET+104U)
+
+/**
+ * @brief TX buffer11 register, layout:
+ * @code
+ * CAN_TX11_REG_2B[7:0] -> can_frame_s.DATA[6]
+ * @endcode
+ * */
+#define CAN_TX11_REG_2B       (CAN_BASE_OFFSET+108U)
+
+/**
+ * @brief TX buffer12 register, layout:
+ * @code
+ * CAN_TX12_REG_2B[7:0] -> can_frame_s.DATA[7]
+ * @endcode
+ * */
+#define CAN_TX12_REG_2B       (CAN_BASE_OFFSET+112U)
+
+/**
+ * @brief RX buffer0 register, layout:
+ * @code
+ * CAN_RX0_REG_2B[7]   -> can_frame_s.IDE
+ * CAN_RX0_REG_2B[6]   -> can_frame_s.RTR
+ * CAN_RX0_REG_2B[5:4] -> Reserved
+ * CAN_RX0_REG_2B[3:0] -> can_frame_s.DLC
+ * @endcode
+ * */
+#define CAN_RX0_REG_2B        (CAN_BASE_OFFSET+64U)
+
+/**
+ * @brief RX buffer1 register, layout:
+ * @code
+ * CAN_RX1_REG_2B[7:0] -> can_frame_s.ID[28:21]
+ * @endcode
+ * */
+#define CAN_RX1_REG_2B        (CAN_BASE_OFFSET+68U)
+
+/**
+ * @brief RX buffer2 register, layout:
+ * @code
+ * CAN_RX2_REG_2B[7:0] -> can_frame_s.ID[20:13]
+ * @endcode
+ * */
+#define CAN_RX2_REG_2B        (CAN_BASE_OFFSET+72U)
+
+/**
+ * @brief RX buffer3 register, layout:
+ * @code
+ * CAN_RX3_REG_2B[7:0] -> can_frame_s.ID[12:5]
+ * @endcode
+ * */
+#define CAN_RX3_REG_2B        (CAN_BASE_OFFSET+76U)
+
+/**
+ * @brief RX buffer4 register, layout:
+ * @code
+ * CAN_RX4_REG_2B[7:3] -> can_frame_s.ID[4:0]
+ * CAN_RX4_REG_2B[2:0] -> Reserved
+ * @endcode
+ * */
+#define CAN_RX4_REG_2B        (CAN_BASE_OFFSET+80U)
+
+/**
+ * @brief RX buffer5 register, layout:
+ * @code
+ * CAN_RX5_REG_2B[7:0] -> can_frame_s.DATA[0]
+ * @endcode
+ * */
+#define CAN_RX5_REG_2B        (CAN_BASE_OFFSET+84U)
+
+/**
+ * @brief RX buffer6 register, layout:
+ * @code
+ * CAN_RX6_REG_2B[7:0] -> can_frame_s.DATA[1]
+ * @endcode
+ * */
+#define CAN_RX6_REG_2B        (CAN_BASE_OFFSET+88U)
+
+/**
+ * @brief RX buffer7 register, layout:
+ * @code
+ * CAN_RX7_REG_2B[7:0] -> can_frame_s.DATA[2]
+ * @endcode
+ * */
+#define CAN_RX7_REG_2B        (CAN_BASE_OFFSET+92U)
+
+/**
+ * @brief RX buffer8 register, layout:
+ * @code
+ * CAN_RX8_REG_2B[7:0] -> can_frame_s.DATA[3]
+ * @endcode
+ * */
+#define CAN_RX8_REG_2B        (CAN_BASE_OFFSET+96U)
+
+/**
+ * @brief RX buffer9 register, layout:
+ * @code
+ * CAN_RX9_REG_2B[7:0] -> can_frame_s.DATA[4]
+ * @endcode
+ * */
+#define CAN_RX9_REG_2B        (CAN_BASE_OFFSET+100U)
+
+/**
+ * @brief RX buffer10 register, layout:
+ * @code
+ * CAN_RX10_REG_2B[7:0] -> can_frame_s.DATA[5]
+ * @endcode
+ * */
+#define CAN_RX10_REG_2B       (CAN_BASE_OFFSET+104U)
+
+/**
+ * @brief RX buffer11 register, layout:
+ * @code
+ * CAN_RX11_REG_2B[7:0] -> can_frame_s.DATA[6]
+ * @endcode
+ * */
+#define CAN_RX11_REG_2B       (CAN_BASE_OFFSET+108U)
+
+/**
+ * @brief RX buffer12 register, layout:
+ * @code
+ * CAN_RX12_REG_2B[7:0] -> can_frame_s.DATA[7]
+ * @endcode
+ * */
+#define CAN_RX12_REG_2B       (CAN_BASE_OFFSET+112U)
+
+/**
+ * @brief Clock divider register, layout:
+ * @code
+ * CAN_CDR_REG[7:7] -> extended_mode (0 disable, 1 enable)
+ * CAN_CDR_REG[6:4] -> reserved
+ * CAN_CDR_REG[3:3] -> clock_off (0 disable, 1 enable)
+ * CAN_CDR_REG[2:0] -> clock divider (integer valid range 0 - 6)
+ * @endcode
+ * */
+#define CAN_CDR_REG           (CAN_BASE_OFFSET+124U)
+
+/**
+ * @brief \ref Disable triple sampling
+ *
+ * CAN_BTR1_REG[7] default (hard-coded) value
+ */
+#define CAN_TRIPLE_SAM        (0x0U)
+
+/**
+ * @brief Disable output clock
+ *
+ * \ref CAN_CDR_REG[3] default (hard-coded) value
+ */
+#define CAN_CLK_O_OFF         (0x1U)
+
+/**
+ * @brief Disable triple sampling
+ *
+ * \ref CAN_CDR_REG[2:0] default (hard-coded) value
+ */
+#define CAN_CLK_DIV           (0x0U)
+
+/**
+ * @brief Trigger TX default value
+ *
+ * \ref Default value for \ref CAN_COMMAND_TX_REG register to trigger TX
+ * @note You should initialize TX buffers first
+ */
+#define CAN_CMNT_TRIGGER_TX   (0x1U)
+
+/**
+ * @brief Abort TX default value
+ *
+ * \ref Default value for \ref CAN_COMMAND_TX_REG register to abort a
+ * pending, not yet started, transmission
+ */
+#define CAN_CMNT_ABORT_TX     (0x2U)
+
+/**
+ * @brief Acknowledge RX default value
+ *
+ * \ref Default value for \ref CAN_COMMAND_RX_REG register to acknowledge RX
+ */
+#define CAN_CMNT_RX_ACK       (0x4U) //Request to reduce RXed frames counter.
+
+/**
+ * @brief Clear RX FIFO overrun default value
+ *
+ * \ref Default value for \ref CAN_COMMAND_RX_REG register to clear RX FIFO
+ * overrun
+ */
+#define CAN_CMNT_CLR_OVERRUN  (0x8U) //Request to clear overrun.
+
+/**
+ * @brief Query TX logic state
+ *
+ * Decode \ref CAN_STATUS_REG value to find out TX logic state
+ * @return 0 idle
+ * @return 1 active
+ */
+#define CAN_Q_TX_BUF_STATUS(status)     ( !((status>>2U) & 1U) )
+
+/**
+ * @brief Query last transmission's state
+ *
+ * Decode \ref CAN_STATUS_REG value to find out whether the last requested
+ * transmission completed
+ * @return 0 not completed (in progress or aborted)
+ * @return 1 completed
+ */
+#define CAN_Q_TX_COMPLETE(status)       ( ((status)>>3U) & 1U )
+
+/**
+ * @brief Query RX logic state
+ *
+ * Decode \ref CAN_STATUS_REG value to find out RX logic state
+ * @return 0 idle
+ * @return 1 active
+ */
+#define CAN_Q_RX_STATUS(status)			( ((status)>>4U) & 1U )
+
+/**
+ * @brief Query RX buffer status
+ *
+ * Decode \ref CAN_STATUS_REG value to find out RX FIFO status
+ * @return 0 (empty)
+ * @return 1 full (frame received)
+ */
+#define CAN_Q_RX_BUF_STATUS(status)		( ((status)>>0U) & 1U )
+
+/**
+ * @brief Query RX FIFO overrun status
+ *
+ * Decode \ref CAN_STATUS_REG value to find out RX FIFO status
+ * @return 0 no overrun
+ * @return 1 overrun occurred
+ */
+#define CAN_Q_RX_OVERRUN(status)        ( ((status)>>1U) & 1U )
+
+#endif /* ISCA_CAN_REGS_H */
@@ -0,0 +1,124 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA_CAN cyclic TX scheduler
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_SCHED.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_SCHED.h
+ *
+ * @brief Cyclic CAN frames TX scheduler, driven by a hierarchical timer wheel
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_SCHED_H
+#define ISCA_CAN_SCHED_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#define ISCA_SCHED_WHEEL_BITS   (6U)  /*!<log2 of slots per wheel level*/
+#define ISCA_SCHED_WHEEL_SLOTS  (1U << ISCA_SCHED_WHEEL_BITS) /*!<Slots per wheel level*/
+#define ISCA_SCHED_WHEEL_MASK   (ISCA_SCHED_WHEEL_SLOTS - 1U) /*!<Slot index mask*/
+#define ISCA_SCHED_LEVELS       (3U)  /*!<Wheel levels*/
+
+/**
+ * @brief Scheduler horizon in ticks
+ *
+ * Periods and phase offsets must be shorter than the horizon
+ * */
+#define ISCA_SCHED_HORIZON      (1UL << (ISCA_SCHED_WHEEL_BITS*ISCA_SCHED_LEVELS))
+
+/// Cyclic frame statistics
+typedef struct isca_sched_stats_s {
+	uint32_t sent;        /*!<Frames written to the TX buffer*/
+	uint32_t misses;      /*!<Releases found the previous one still pending*/
+	uint32_t jitter_last; /*!<Last release-to-write delay in ticks*/
+	uint32_t jitter_max;  /*!<Worst release-to-write delay in ticks*/
+} isca_sched_stats_s;
+
+/// Cyclic frame entry; storage is provided by the caller
+typedef struct isca_sched_entry_s {
+	struct isca_sched_entry_s *next;  /*!<Wheel slot link*/
+	struct isca_sched_entry_s *pnext; /*!<Pending list link*/
+	can_tx_img_s img;                 /*!<Pre-encoded frame*/
+	uint32_t period;                  /*!<Release period in ticks*/
+	uint32_t due;                     /*!<Next release tick*/
+	uint32_t released;                /*!<Last release tick*/
+	uint8_t  level;                   /*!<Wheel level the entry is linked to*/
+	uint8_t  slot;                    /*!<Wheel slot the entry is linked to*/
+	uint8_t  pending;                 /*!<1: released, waiting for the TX buffer*/
+	isca_sched_stats_s stats;         /*!<Per frame statistics*/
+} isca_sched_entry_s;
+
+/// Cyclic TX scheduler instance
+typedef struct isca_sched_s {
+	can_ctrl_s *can_ctrl;             /*!<Controller frames are sent from*/
+	uint32_t now;                     /*!<Next tick to be processed*/
+	isca_sched_entry_s *wheel[ISCA_SCHED_LEVELS][ISCA_SCHED_WHEEL_SLOTS]; /*!<Timer wheel*/
+	isca_sched_entry_s *pend_head;    /*!<Released frames, oldest first*/
+	isca_sched_entry_s *pend_tail;    /*!<Last released frame*/
+} isca_sched_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_sched_init(isca_sched_s *sched, can_ctrl_s *can_ctrl, uint32_t now);
+
+int isca_sched_add(isca_sched_s *sched, isca_sched_entry_s *entry,
+                   can_frame_s const *frame, uint32_t period, uint32_t offset);
+
+int isca_sched_remove(isca_sched_s *sched, isca_sched_entry_s *entry);
+
+int isca_sched_update(isca_sched_entry_s *entry, uint8_t const *data, uint8_t len);
+
+int isca_sched_run(isca_sched_s *sched, uint32_t now);
+
+int isca_sched_tx_done(isca_sched_s *sched, uint32_t now);
+
+#endif /* ISCA_CAN_SCHED_H */
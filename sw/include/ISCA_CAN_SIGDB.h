@@ -0,0 +1,173 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN compiled signal database
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_SIGDB.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_SIGDB.h
+ *
+ * @brief Signal database: DBC-style signal descriptions compiled into per
+ * message extraction plans, decoded in batches
+ *
+ * Signals are added one by one, \ref isca_sigdb_add, or loaded from the
+ * BO_/SG_ lines of a DBC file, \ref isca_sigdb_load_dbc. Compiling turns
+ * each signal's start bit, length and byte order into a shift and a mask
+ * on the frame payload read as one 64-bit word, and groups the signals by
+ * message ID behind a hash.
+ *
+ * A batch decode sorts the frames by message, then runs each signal's
+ * extraction over all of its message's payloads at once, appending the
+ * physical values, raw * scale + offset, and the frame indices to the
+ * signal's column (structure of arrays). Byte aligned 8, 16 and 32-bit
+ * signals take loops without masking or sign extension shifts, which the
+ * compiler vectorises.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_SIGDB_H
+#define ISCA_CAN_SIGDB_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if ((SIGDB_HASH_SLOTS & (SIGDB_HASH_SLOTS - 1U)) != 0) || (SIGDB_HASH_SLOTS <= SIGDB_MAX_MSGS) || \
+    (SIGDB_MAX_MSGS > 254U) || (SIGDB_MAX_SIGS > 0xFFFFU)
+#error "SIGDB_HASH_SLOTS must be a power of two above SIGDB_MAX_MSGS, SIGDB_MAX_MSGS up to 254"
+#endif
+
+/*-----
+ * SIGNAL DATABASE FUNCT RETURN
+ *----*/
+#define ISCA_SIGDB_FULL       (-1) /*!<No free signal or message slot*/
+#define ISCA_SIGDB_SYNTAX     (-2) /*!<DBC line not understood, see \ref isca_sigdb_s.err_line*/
+#define ISCA_SIGDB_NONE       (-3) /*!<No such signal*/
+
+/*-----
+ * SIGNAL EXTRACTION KINDS
+ *----*/
+#define SIG_K_GENERIC         (0U) /*!<Shift, mask, sign extension*/
+#define SIG_K_U8              (1U) /*!<Byte aligned, unsigned 8-bit*/
+#define SIG_K_I8              (2U) /*!<Byte aligned, signed 8-bit*/
+#define SIG_K_U16             (3U) /*!<Byte aligned, unsigned 16-bit*/
+#define SIG_K_I16             (4U) /*!<Byte aligned, signed 16-bit*/
+#define SIG_K_U32             (5U) /*!<Byte aligned, unsigned 32-bit*/
+#define SIG_K_I32             (6U) /*!<Byte aligned, signed 32-bit*/
+
+/// Signal description, as in a DBC SG_ line
+typedef struct isca_sig_def_s {
+	char     name[SIGDB_NAME_LEN]; /*!<Signal name*/
+	uint32_t id;                   /*!<Message ID*/
+	uint8_t  ide;                  /*!<\ref CAN_FRAME_STD or \ref CAN_FRAME_EXT*/
+	uint8_t  start;                /*!<DBC start bit; the MSB of big endian signals*/
+	uint8_t  len;                  /*!<Length in bits, 1 to 64*/
+	uint8_t  big_endian;           /*!<1: Motorola byte order (DBC @0)*/
+	uint8_t  is_signed;            /*!<1: two's complement (DBC -)*/
+	double   scale;                /*!<Physical value factor*/
+	double   offset;               /*!<Physical value offset*/
+} isca_sig_def_s;
+
+/// Compiled signal extraction plan
+typedef struct isca_sig_s {
+	uint64_t mask;                 /*!<Raw value mask, after the shift*/
+	SIGDB_VALUE scale;             /*!<Physical value factor*/
+	SIGDB_VALUE offset;            /*!<Physical value offset*/
+	uint16_t def;                  /*!<Description index*/
+	uint8_t  shift;                /*!<Raw value LSB in the payload word*/
+	uint8_t  kind;                 /*!<SIG_K_* extraction*/
+	uint8_t  big_endian;           /*!<Payload word read big endian*/
+	uint8_t  len;                  /*!<Length in bits*/
+	uint8_t  is_signed;            /*!<Two's complement*/
+} isca_sig_s;
+
+/// Compiled message: its signals and the payload length they need
+typedef struct isca_sig_msg_s {
+	uint32_t hdr;                  /*!<\ref can_cframe_s hdr of the message, ID | \ref CAN_CF_IDE*/
+	uint16_t first;                /*!<First signal*/
+	uint16_t n_sig;                /*!<Signals*/
+	uint8_t  dlc;                  /*!<Shortest payload holding every signal*/
+	uint8_t  big_endian;           /*!<Has big endian signals*/
+} isca_sig_msg_s;
+
+/// Signal column, filled by \ref isca_sigdb_decode
+typedef struct isca_sig_col_s {
+	SIGDB_VALUE *val;              /*!<Physical values, caller storage*/
+	uint32_t *row;                 /*!<Batch indices of the frames, caller storage; NULL if not needed*/
+	uint32_t n;                    /*!<Values stored; reset by the caller between batches*/
+} isca_sig_col_s;
+
+/// Signal database description structure
+typedef struct isca_sigdb_s {
+	isca_sig_def_s def[SIGDB_MAX_SIGS];   /*!<Descriptions, in adding order*/
+	isca_sig_s     sig[SIGDB_MAX_SIGS];   /*!<Compiled signals, grouped by message*/
+	isca_sig_msg_s msg[SIGDB_MAX_MSGS];   /*!<Compiled messages*/
+	uint8_t  hash[SIGDB_HASH_SLOTS];      /*!<Message index + 1 by hdr; 0: free slot*/
+	uint16_t n_def;                       /*!<Descriptions*/
+	uint16_t n_sig;                       /*!<Compiled signals, column count*/
+	uint16_t n_msg;                       /*!<Compiled messages*/
+	uint32_t err_line;                    /*!<DBC line of the last \ref ISCA_SIGDB_SYNTAX*/
+	uint32_t short_frames;                /*!<Frames shorter than their message, not decoded*/
+} isca_sigdb_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_sigdb_init(isca_sigdb_s *db);
+
+int isca_sigdb_add(isca_sigdb_s *db, isca_sig_def_s const *def);
+
+int isca_sigdb_load_dbc(isca_sigdb_s *db, char const *text);
+
+int isca_sigdb_compile(isca_sigdb_s *db);
+
+int isca_sigdb_find(isca_sigdb_s const *db, char const *name);
+
+SIGDB_VALUE isca_sigdb_get(isca_sigdb_s const *db, uint16_t sig, can_cframe_s const *frame);
+
+uint32_t isca_sigdb_decode(isca_sigdb_s *db, can_cframe_s const *frames, uint32_t n, isca_sig_col_s *cols);
+
+#endif /* ISCA_CAN_SIGDB_H */
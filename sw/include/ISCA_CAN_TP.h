@@ -0,0 +1,172 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN ISO-TP transport layer
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_TP.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_TP.h
+ *
+ * @brief ISO 15765-2 (ISO-TP) transport layer, normal addressing
+ *
+ * Messages of up to 4 GiB are segmented into single, first and consecutive
+ * frames, paced by the receiver's flow control frames, i.e., block size
+ * and STmin. A session is one pair of CAN IDs; an endpoint serves many
+ * sessions of one controller, without blocking, from \ref isca_tp_poll.
+ *
+ * Neither direction copies the message: frames are sent straight from
+ * the caller's buffer and reassembled straight into the buffer armed with
+ * \ref isca_tp_recv. The caller keeps either buffer until the session's
+ * callback reports the transfer done.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_TP_H
+#define ISCA_CAN_TP_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if (TP_HASH_SLOTS & (TP_HASH_SLOTS - 1U)) != 0
+#error "TP_HASH_SLOTS must be a power of two"
+#endif
+
+/*-----
+ * ISO-TP FUNCT RETURN
+ *----*/
+#define ISCA_TP_FULL          (-1) /*!<No free session slot*/
+#define ISCA_TP_BUSY          (-2) /*!<Transfer in progress in this direction*/
+#define ISCA_TP_OVFLW         (-3) /*!<Message larger than the receiver's buffer*/
+#define ISCA_TP_SEQ           (-4) /*!<Consecutive frame out of sequence*/
+#define ISCA_TP_WFT           (-5) /*!<More than \ref TP_WFT_MAX flow control WAIT frames*/
+
+/*-----
+ * ISO-TP EVENTS
+ *----*/
+#define ISCA_TP_EV_TX_DONE    (0U) /*!<Message sent, or not*/
+#define ISCA_TP_EV_RX_DONE    (1U) /*!<Message received, or reception aborted*/
+
+/*-----
+ * ISO-TP PROTOCOL CONTROL INFORMATION
+ *----*/
+#define TP_PCI_SF             (0x0U) /*!<Single frame*/
+#define TP_PCI_FF             (0x1U) /*!<First frame*/
+#define TP_PCI_CF             (0x2U) /*!<Consecutive frame*/
+#define TP_PCI_FC             (0x3U) /*!<Flow control frame*/
+
+#define TP_FC_CTS             (0x0U) /*!<Flow control: continue to send*/
+#define TP_FC_WAIT            (0x1U) /*!<Flow control: wait*/
+#define TP_FC_OVFLW           (0x2U) /*!<Flow control: overflow*/
+
+struct isca_tp_sess_s;
+
+/// Transfer done callback; res is \ref ISCA_CAN_OK, \ref ISCA_CAN_TIMEOUT or an ISCA_TP_* code, len the bytes received
+typedef void (*isca_tp_cb_t)(struct isca_tp_sess_s *sess, uint8_t event, int res, uint32_t len);
+
+/// ISO-TP session description structure
+typedef struct isca_tp_sess_s {
+	/*Configuration, see \ref isca_tp_sess_init*/
+	uint32_t tx_id;              /*!<ID of the frames sent*/
+	uint32_t rx_id;              /*!<ID of the frames received*/
+	uint8_t  ide;                /*!<\ref CAN_FRAME_STD or \ref CAN_FRAME_EXT*/
+	uint8_t  bs;                 /*!<Block size granted to the sender, 0 for no limit*/
+	uint8_t  stmin;              /*!<STmin granted to the sender, ISO-TP encoded*/
+	isca_tp_cb_t cb;             /*!<Transfer done callback*/
+	void *arg;                   /*!<Caller context*/
+	/*Transmitter*/
+	uint8_t const *tx_buf;       /*!<Message sent*/
+	uint32_t tx_len;             /*!<Message length*/
+	uint32_t tx_off;             /*!<Bytes sent*/
+	uint32_t tx_stmin_us;        /*!<Receiver's STmin*/
+	uint32_t tx_time;            /*!<Next consecutive frame not before / flow control deadline*/
+	uint8_t  tx_state;           /*!<Transmitter state*/
+	uint8_t  tx_sn;              /*!<Next sequence number*/
+	uint8_t  tx_bs;              /*!<Receiver's block size*/
+	uint8_t  tx_left;            /*!<Frames left in the block*/
+	uint8_t  tx_wft;             /*!<WAIT frames in a row*/
+	/*Receiver*/
+	uint8_t *rx_buf;             /*!<Armed buffer, NULL if none*/
+	uint32_t rx_cap;             /*!<Buffer capacity*/
+	uint32_t rx_len;             /*!<Message length*/
+	uint32_t rx_off;             /*!<Bytes received*/
+	uint32_t rx_deadline;        /*!<Next consecutive frame deadline*/
+	uint8_t  rx_state;           /*!<Receiver state*/
+	uint8_t  rx_sn;              /*!<Expected sequence number*/
+	uint8_t  rx_left;            /*!<Frames left in the block*/
+	uint8_t  fc_pend;            /*!<Flow control status to send + 1, 0 if none*/
+	struct isca_tp_sess_s *next; /*!<Lookup chain*/
+} isca_tp_sess_s;
+
+/// ISO-TP endpoint description structure
+typedef struct isca_tp_s {
+	can_ctrl_s *can_ctrl;                  /*!<Controller*/
+	isca_tp_sess_s *hash[TP_HASH_SLOTS];   /*!<Sessions by rx_id*/
+	isca_tp_sess_s *sess[TP_MAX_SESS];     /*!<Sessions, in open order*/
+	uint8_t  n_sess;                       /*!<Sessions*/
+	uint32_t strays;                       /*!<Frames received for no session*/
+	uint32_t rx_drops;                     /*!<Messages refused, no buffer armed or too long*/
+} isca_tp_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_tp_init(isca_tp_s *tp, can_ctrl_s *can_ctrl);
+
+void isca_tp_sess_init(isca_tp_sess_s *sess, uint32_t tx_id, uint32_t rx_id, uint8_t ide,
+                       isca_tp_cb_t cb, void *arg);
+
+int isca_tp_open(isca_tp_s *tp, isca_tp_sess_s *sess);
+
+int isca_tp_send(isca_tp_sess_s *sess, uint8_t const *buf, uint32_t len);
+
+void isca_tp_recv(isca_tp_sess_s *sess, uint8_t *buf, uint32_t cap);
+
+void isca_tp_input(isca_tp_s *tp, can_frame_s const *rx_frame);
+
+uint32_t isca_tp_poll(isca_tp_s *tp, uint32_t budget);
+
+#endif /* ISCA_CAN_TP_H */
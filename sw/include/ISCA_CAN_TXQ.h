@@ -0,0 +1,116 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA_CAN arbitration ordered TX queue
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_TXQ.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_TXQ.h
+ *
+ * @brief Software TX queue served in CAN arbitration order
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_TXQ_H
+#define ISCA_CAN_TXQ_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#define ISCA_TXQ_PREEMPT_OFF   (0U) /*!<Never abort the frame in the TX buffer*/
+#define ISCA_TXQ_PREEMPT_ON    (1U) /*!<Abort and requeue a lower priority frame in the TX buffer*/
+
+/// TX queue heap node
+typedef struct isca_txq_item_s {
+	uint32_t key;         /*!<Arbitration key, lower wins*/
+	uint32_t seq;         /*!<Enqueue order, breaks key ties*/
+	uint32_t deadline;    /*!<Drop the frame if not sent by then, \ref ISCA_TIME_Us ticks*/
+	uint8_t  dl_valid;    /*!<1: \ref deadline applies*/
+	can_frame_s frame;    /*!<Queued frame*/
+} isca_txq_item_s;
+
+/// TX queue statistics
+typedef struct isca_txq_stats_s {
+	uint32_t queued;      /*!<Frames accepted*/
+	uint32_t sent;        /*!<Frames completed on the bus*/
+	uint32_t preempted;   /*!<Frames aborted in the TX buffer and requeued*/
+	uint32_t rejected;    /*!<Frames rejected, queue full*/
+	uint32_t expired;     /*!<Frames dropped, deadline passed*/
+} isca_txq_stats_s;
+
+/// Arbitration ordered TX queue instance
+typedef struct isca_txq_s {
+	can_ctrl_s *can_ctrl;      /*!<Controller frames are sent from*/
+	isca_txq_item_s *heap;     /*!<Caller provided binary heap storage*/
+	uint32_t size;             /*!<Heap capacity in frames*/
+	uint32_t count;            /*!<Queued frames*/
+	uint32_t seq;              /*!<Next enqueue sequence number*/
+	isca_txq_item_s inflight;  /*!<Frame last written to the TX buffer*/
+	uint8_t inflight_valid;    /*!<1: \ref inflight awaits completion*/
+	uint8_t abort_req;         /*!<1: abort ordered for \ref inflight*/
+	uint8_t preempt;           /*!<\ref ISCA_TXQ_PREEMPT_ON or \ref ISCA_TXQ_PREEMPT_OFF*/
+	isca_txq_stats_s stats;    /*!<Queue statistics*/
+} isca_txq_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_txq_init(isca_txq_s *txq, can_ctrl_s *can_ctrl, isca_txq_item_s *items,
+                   uint32_t size, uint8_t preempt);
+
+int isca_txq_push(isca_txq_s *txq, can_frame_s const *tx_frame);
+
+int isca_txq_push_dl(isca_txq_s *txq, can_frame_s const *tx_frame, uint32_t deadline);
+
+int isca_txq_service(isca_txq_s *txq);
+
+void isca_txq_tx_hook(can_ctrl_s *can_ctrl, void *arg);
+
+uint32_t isca_txq_arb_key(can_frame_s const *frame);
+
+#endif /* ISCA_CAN_TXQ_H */
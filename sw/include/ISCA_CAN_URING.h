@@ -0,0 +1,180 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN submission/completion rings
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_URING.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_URING.h
+ *
+ * @brief Asynchronous CAN I/O through submission/completion ring pairs
+ *
+ * The application fills submission entries, TX or RX requests tagged with
+ * its own user_data, and publishes them with one index store; the server,
+ * \ref isca_uring_service, completes them into the completion ring with a
+ * status and a timestamp, and the application reaps any number of them at
+ * once.
+ *
+ * A ring pair, \ref isca_uring_s, is one block without pointers, with the
+ * frames inline; placed in a shared memory segment it lets a daemon owning
+ * the controllers serve several processes, one ring pair each, without
+ * copies. Either side only writes its own indices, with release stores.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_CAN_URING_H
+#define ISCA_CAN_URING_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#if ((URING_SQ_ENTRIES & (URING_SQ_ENTRIES - 1U)) != 0) || ((URING_CQ_ENTRIES & (URING_CQ_ENTRIES - 1U)) != 0)
+#error "URING_SQ_ENTRIES and URING_CQ_ENTRIES must be powers of two"
+#endif
+
+/*-----
+ * URING FUNCT RETURN
+ *----*/
+#define ISCA_URING_FULL       (-1) /*!<No free ring, controller or pending slot*/
+
+/*-----
+ * URING OPCODES
+ *----*/
+#define ISCA_URING_OP_NOP     (0U) /*!<Complete at once*/
+#define ISCA_URING_OP_TX      (1U) /*!<Transmit \ref isca_uring_sqe_s.frame*/
+#define ISCA_URING_OP_RX      (2U) /*!<Receive the next frame with (ID & mask) == (id & mask)*/
+
+/// Submission entry
+typedef struct isca_uring_sqe_s {
+	uint64_t user_data;      /*!<Copied to the completion*/
+	uint8_t  opcode;         /*!<\ref ISCA_URING_OP_TX, \ref ISCA_URING_OP_RX, ...*/
+	uint8_t  ctrl;           /*!<Controller index, see \ref isca_uring_srv_attach*/
+	uint16_t rsvd;           /*!<Reserved*/
+	uint32_t timeout_us;     /*!<Time budget from server intake, ISCA_CAN_WAIT_FOREVER for none*/
+	uint32_t id;             /*!<RX filter code*/
+	uint32_t mask;           /*!<RX filter mask, 0 to take any frame*/
+	can_cframe_s frame;      /*!<TX frame*/
+} isca_uring_sqe_s;
+
+/// Completion entry
+typedef struct isca_uring_cqe_s {
+	uint64_t user_data;      /*!<Submission's user_data*/
+	int32_t  res;            /*!<\ref ISCA_CAN_OK, \ref ISCA_CAN_TIMEOUT, \ref ISCA_CAN_INV_PARAM*/
+	uint32_t ts;             /*!<Completion time, \ref ISCA_TIME_Us; TX request or frame pick-up*/
+	can_cframe_s frame;      /*!<RX frame*/
+} isca_uring_cqe_s;
+
+/// Submission/completion ring pair, position independent
+typedef struct isca_uring_s {
+	uint32_t sq_head __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Written by the server*/
+	uint32_t cq_tail;                                             /*!<Written by the server*/
+	uint32_t cq_overflow;                                         /*!<Completions that found the CQ full, each counted once, server side*/
+	uint32_t sq_tail __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Written by the application*/
+	uint32_t cq_head;                                             /*!<Written by the application*/
+	isca_uring_sqe_s sqes[URING_SQ_ENTRIES] __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Submissions*/
+	isca_uring_cqe_s cqes[URING_CQ_ENTRIES] __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Completions*/
+} isca_uring_s;
+
+/// Request in flight, server side
+typedef struct isca_uring_pend_s {
+	isca_uring_sqe_s sqe;    /*!<Submission copy; the SQ slot is recycled at once*/
+	uint32_t deadline;       /*!<\ref ISCA_TIME_Us*/
+	uint8_t  ring;           /*!<Ring index*/
+	uint8_t  done;           /*!<Completed, waiting for CQ room*/
+	uint8_t  held;           /*!<Found the CQ full, counted in cq_overflow*/
+	int32_t  res;            /*!<Result once done*/
+	uint32_t ts;             /*!<Completion time once done*/
+	can_cframe_s frame;      /*!<RX frame once done, zeroed otherwise*/
+} isca_uring_pend_s;
+
+/// Ring server description structure
+typedef struct isca_uring_srv_s {
+	isca_uring_s *ring[URING_MAX_RINGS];      /*!<Served ring pairs*/
+	can_ctrl_s *ctrl[URING_MAX_CTRL];         /*!<Controllers*/
+	isca_uring_pend_s pend[URING_PENDING];    /*!<Requests in flight, in submission order*/
+	uint32_t n_pend;                          /*!<Requests in flight*/
+	uint32_t strays;                          /*!<Frames received with no RX request*/
+	uint8_t  n_ring;                          /*!<Served ring pairs*/
+	uint8_t  n_ctrl;                          /*!<Controllers*/
+} isca_uring_srv_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_uring_init(isca_uring_s *ring);
+
+isca_uring_sqe_s *isca_uring_get_sqe(isca_uring_s *ring, uint32_t i);
+
+void isca_uring_submit(isca_uring_s *ring, uint32_t n);
+
+uint32_t isca_uring_peek_cq(isca_uring_s *ring, uint32_t *first);
+
+void isca_uring_cq_advance(isca_uring_s *ring, uint32_t n);
+
+uint32_t isca_uring_reap(isca_uring_s *ring, isca_uring_cqe_s *cqes, uint32_t max);
+
+void isca_uring_srv_init(isca_uring_srv_s *srv);
+
+int isca_uring_srv_attach(isca_uring_srv_s *srv, can_ctrl_s *can_ctrl);
+
+int isca_uring_srv_add_ring(isca_uring_srv_s *srv, isca_uring_s *ring);
+
+uint32_t isca_uring_service(isca_uring_srv_s *srv, uint32_t budget);
+
+/**
+ * @brief      Completion entry of a \ref isca_uring_peek_cq range
+ * @param[in]  ring  Ring pair
+ * @param[in]  pos   first + i, i below the peeked count
+ * @return     Completion entry, valid until \ref isca_uring_cq_advance
+ */
+static inline isca_uring_cqe_s const *isca_uring_cqe_at(isca_uring_s const *ring, uint32_t pos) {
+
+	return &ring->cqes[pos & (URING_CQ_ENTRIES - 1U)];
+
+}
+
+#endif /* ISCA_CAN_URING_H */
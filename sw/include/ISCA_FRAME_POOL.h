@@ -0,0 +1,82 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA static frame pool
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_FRAME_POOL.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_FRAME_POOL.h
+ *
+ * @brief Static, compile-time sized storage pool for the RX queues
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_FRAME_POOL_H
+#define ISCA_FRAME_POOL_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+/// Frame pool statistics
+typedef struct isca_frame_pool_stats_s {
+	uint32_t size;        /*!<Pool size in frames, \ref FRAME_POOL_FRAMES*/
+	uint32_t in_use;      /*!<Frames currently allocated*/
+	uint32_t high_water;  /*!<Most frames ever allocated at once*/
+	uint32_t failed;      /*!<Allocations refused*/
+} isca_frame_pool_stats_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+can_cframe_s *isca_frame_pool_alloc(uint32_t frames);
+
+void isca_frame_pool_free(can_cframe_s *block);
+
+void isca_frame_pool_stats(isca_frame_pool_stats_s *stats);
+
+#endif /* ISCA_FRAME_POOL_H */
@@ -66,4 +66,23 @@ void ISCA_FPGA_Write8Bit(size_t const address_ptr, uint8_t const data);
 
 uint8_t ISCA_FPGA_Read8Bit(size_t const address_ptr);
 
+uint32_t ISCA_TIME_Us(void);
+
+/**
+ * @brief  Header inlined \ref ISCA_FPGA_Write8Bit, for register sequences
+ *         the compiler should reduce to plain stores
+ * */
+static inline void ISCA_FPGA_Write8Bit_Inl(size_t const address_ptr, uint8_t const data)
+{
+	*((volatile uint8_t *)address_ptr) = data;
+}
+
+/**
+ * @brief  Header inlined \ref ISCA_FPGA_Read8Bit
+ * */
+static inline uint8_t ISCA_FPGA_Read8Bit_Inl(size_t const address_ptr)
+{
+	return *((volatile uint8_t *)address_ptr);
+}
+
 #endif /* ISCA_IO_H */
@@ -0,0 +1,90 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA lock-free MPMC frame queue
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_MPMC_QUEUE.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_MPMC_QUEUE.h
+ *
+ * @brief Bounded lock-free multi-producer/multi-consumer frame queue
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_MPMC_QUEUE_H
+#define ISCA_MPMC_QUEUE_H
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN.h"
+
+/******
+ * DEFINITIONS
+ ******/
+/// MPMC queue cell
+typedef struct isca_mpmc_cell_s {
+	uint32_t seq;          /*!<Cell sequence; tells producers and consumers whose turn it is*/
+	can_cframe_s frame;    /*!<Queued frame*/
+} isca_mpmc_cell_s;
+
+/// MPMC queue description structure
+typedef struct isca_mpmc_s {
+	isca_mpmc_cell_s *cells; /*!<Caller provided cells*/
+	uint32_t mask;           /*!<Capacity - 1*/
+	uint32_t enq_pos __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Producers' free running counter*/
+	uint32_t deq_pos __attribute__ ((aligned (CACHE_LINE_SIZE))); /*!<Consumers' free running counter*/
+} isca_mpmc_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+int isca_mpmc_init(isca_mpmc_s *q, isca_mpmc_cell_s *cells, uint32_t size);
+
+int isca_mpmc_push(isca_mpmc_s *q, can_cframe_s const *frame);
+
+int isca_mpmc_pop(isca_mpmc_s *q, can_cframe_s *frame);
+
+uint32_t isca_mpmc_count(isca_mpmc_s *q);
+
+#endif /* ISCA_MPMC_QUEUE_H */
@@ -62,19 +62,59 @@
 /******
  * DEFINITIONS
  ******/
-#define MAX_QUEUES   (8)
+#ifndef MAX_QUEUES
+#define MAX_QUEUES   (256) /*!<Registry capacity, up to 65534 queues*/
+#endif
 #define DQ_OK        (0)
 #define DQ_AVAILABLE (1)
 #define DQ_OCCUPIED  (-1)
 #define DQ_FULL      (-2)
 #define DQ_EMPTY     (-3)
+#define DQ_STALE     (-4)
+#define DQ_LOST      (-5) /*!<Peeked elements overwritten by a \ref DQ_DROP_OLDEST producer*/
+
+/*
+ * Overflow policy, i.e., producer behaviour on a full queue
+ */
+#define DQ_DROP_NEWEST (0U) /*!<Refuse the new element; counted as a drop*/
+#define DQ_DROP_OLDEST (1U) /*!<Overwrite the oldest element; counted as a drop*/
+#define DQ_BLOCK       (2U) /*!<Refuse the new element; the producer holds it back*/
+
+#define DQ_INVALID_HANDLE (0U) /*!<Never a valid \ref isca_qhandle_t*/
+
+/**
+ * @brief Queue handle
+ *
+ * Layout:
+ * @code
+ * isca_qhandle_t[31:16] -> generation (never 0)
+ * isca_qhandle_t[15:0]  -> registry index
+ * @endcode
+ * */
+typedef uint32_t isca_qhandle_t;
+
+/// Contiguous slot spans of a batch; the second one is used only across the wrap point
+typedef struct isca_qspan_s {
+	uint32_t pos;     /*!<Free running counter at the batch start*/
+	uint32_t idx[2];  /*!<First slot index of each span*/
+	uint32_t len[2];  /*!<Slots in each span*/
+} isca_qspan_s;
 
 /******
  * FUNCTIONS DECLARATION
  ******/
-int isca_queue_acquire(uint8_t const q_slots);
-int isca_queue_release(uint8_t queue_index);
-int isca_queue_rd_ptr(uint8_t q_index, uint8_t *queue_rd_ptr);
-int isca_queue_wr_ptr(uint8_t q_index, uint8_t *queue_wr_index);
+int isca_queue_acquire(uint32_t const q_slots, uint8_t const q_policy, isca_qhandle_t *q_handle);
+int isca_queue_release(isca_qhandle_t q_handle);
+int isca_queue_rd_ptr(isca_qhandle_t q_handle, uint32_t *queue_rd_ptr);
+int isca_queue_wr_ptr(isca_qhandle_t q_handle, uint32_t *queue_wr_index);
+uint32_t isca_queue_count(isca_qhandle_t q_handle);
+uint32_t isca_queue_size(isca_qhandle_t q_handle);
+int isca_queue_policy(isca_qhandle_t q_handle);
+uint32_t isca_queue_drops(isca_qhandle_t q_handle);
+void isca_queue_drop_n(isca_qhandle_t q_handle, uint32_t n);
+uint32_t isca_queue_reserve_n(isca_qhandle_t q_handle, uint32_t n, isca_qspan_s *span);
+int isca_queue_commit_n(isca_qhandle_t q_handle, uint32_t n);
+uint32_t isca_queue_peek_n(isca_qhandle_t q_handle, uint32_t n, isca_qspan_s *span);
+int isca_queue_release_n(isca_qhandle_t q_handle, isca_qspan_s const *span, uint32_t n);
 
 #endif /* ISCA_QUEUE_INDEXER_H */
@@ -0,0 +1,95 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA wait primitive
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_WAIT.h
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_WAIT.h
+ *
+ * @brief Event wait primitive used by the blocking receive requests
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+#ifndef ISCA_WAIT_H
+#define ISCA_WAIT_H
+
+/******
+ * HEADERS
+ ******/
+#include "stdint.h"
+#include "ISCA_CAN_CFG.h"
+
+#if (WAIT_MODE == WAIT_PTHREAD)
+#include <pthread.h>
+#endif // (WAIT_MODE == WAIT_PTHREAD)
+
+/******
+ * DEFINITIONS
+ ******/
+#define WAIT_OK        (0)  /*!<Event signalled*/
+#define WAIT_TIMEOUT   (-1) /*!<Deadline passed*/
+
+/// Wait object; an event counter waiters block on
+typedef struct isca_wait_s {
+	volatile uint32_t seq;     /*!<Signalled events counter*/
+#if (WAIT_MODE == WAIT_PTHREAD)
+	pthread_mutex_t lock;      /*!<Protects the condition variable*/
+	pthread_cond_t  cond;      /*!<Waiters block here*/
+#endif // (WAIT_MODE == WAIT_PTHREAD)
+} isca_wait_s;
+
+/******
+ * FUNCTIONS DECLARATION
+ ******/
+void isca_wait_init(isca_wait_s *wait);
+
+uint32_t isca_wait_prepare(isca_wait_s *wait);
+
+int isca_wait_block(isca_wait_s *wait, uint32_t seq, uint32_t const *deadline);
+
+void isca_wait_signal(isca_wait_s *wait);
+
+void isca_wait_relax(void);
+
+#endif /* ISCA_WAIT_H */
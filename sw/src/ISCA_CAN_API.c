@@ -56,6 +56,13 @@
 #include "ISCA_CAN_IRQ.h"
 #include "ISCA_CAN_API.h"
 #include "ISCA_QUEUE_INDEXER.h"
+#include "ISCA_FRAME_POOL.h"
+
+/******
+ * PRIVATE FUNCTIONS DECLARATION
+ ******/
+static int lbr_isca_can_rx_peek(can_ctrl_s *can_ctrl, uint32_t max, isca_qspan_s *span,
+                                uint32_t const *deadline);
 
 /******
  * FUNCTIONS DEFINITION
@@ -63,13 +70,18 @@
 /******************************************************************************//**
  * @brief		  Initialize the CAN controller
  * @param[in,out] can_ctrl CAN controller instance pointer
- * @param[in]     queue_slots Amount of slots to allocate for the SW RX queue
+ * @param[in]     queue_slots Amount of slots to allocate for the SW RX queue,
+ *                            rounded up to a power of two
  * @return 		  \ref ISCA_CAN_OK
  * @return        \ref ISCA_CAN_QUEUES_OCCUPIED
+ * @return        \ref ISCA_CAN_NO_MEMORY
+ * @return        \ref ISCA_CAN_INV_PARAM
+ * @return        \ref ISCA_CAN_ERROR Re-initialized, but could not be stopped
  * @pre           The following \ref can_ctrl 's fields should have been initialized
  *                before calling this function
  *                @code
  *                can_ctrl.addr
+ *                can_ctrl.can_mode //CAN_2A or CAN_2B
  *                can_ctrl.brp
  *                can_ctrl.tseg1
  *                can_ctrl.tseg2
@@ -77,29 +89,55 @@
  *                can_ctrl.irq
  *                can_ctrl.mask
  *                can_ctrl.code
- *                can_ctrl.frm_md //(if CAN_MODE==CAN_2B)
+ *                can_ctrl.q_policy //RX queue overflow policy, 0: DQ_DROP_NEWEST
+ *                can_ctrl.q_ptr    //NULL before the first init, e.g., a zeroed struct
+ *                can_ctrl.frm_md //(if can_mode==CAN_2B)
  *                @endcode
+ * @note          A controller initialized before, stopped or not, is
+ *                deinitialized first, see \ref lbr_isca_can_deinit
  ********************************************************************************/
 int lbr_isca_can_init(can_ctrl_s *can_ctrl, int queue_slots) {
 
-	int        can_rx_queue_id;
+	isca_qhandle_t can_rx_queue_id;
 	can_ctrl_s *can_controller_l;
 
 	/*Point local CAN controller to the passed; cast to can_ctrl_s**/
 	can_controller_l = (can_ctrl_s *)can_ctrl;
 
-	/*Create a CAN frames queue*/
-	can_rx_queue_id = isca_queue_acquire(queue_slots);
+	if ( can_controller_l->can_mode != CAN_2A && can_controller_l->can_mode != CAN_2B ) {
+		return ISCA_CAN_INV_PARAM;
+	} /*Unknown operating mode*/
 
-	//if ( __builtin_expect(can_rx_queue_id == DQ_OCCUPIED, 0) ) {
-	if ( can_rx_queue_id == DQ_OCCUPIED ) {
+	if ( can_controller_l->q_ptr != NULL &&
+	     lbr_isca_can_deinit(can_controller_l) == ISCA_CAN_INV_RST_MODE ) {
+		return ISCA_CAN_ERROR;
+	} /*Initialized before; stop keeps the storage for start, so give it back along with any queue*/
+
+	/*Create a CAN frames queue*/
+	//if ( __builtin_expect(isca_queue_acquire(queue_slots, can_controller_l->q_policy, &can_rx_queue_id) != DQ_OK, 0) ) {
+	if ( isca_queue_acquire(queue_slots, can_controller_l->q_policy, &can_rx_queue_id) != DQ_OK ) {
 		return ISCA_CAN_QUEUES_OCCUPIED;
 	} /*No queue available*/
 
-	/*Update can controller struct*/
-	can_controller_l->q_ptr  = (can_frame_s *)malloc(sizeof(can_frame_s)*queue_slots);
+	/*Update can controller struct; queue size is rounded up to a power of two*/
 	can_controller_l->q_id   = can_rx_queue_id;
-	can_controller_l->q_size = queue_slots;
+	can_controller_l->q_size = isca_queue_size(can_rx_queue_id);
+	can_controller_l->rx_blocked = 0U;
+	can_controller_l->rx_stage.head = 0U;
+	can_controller_l->rx_stage.tail = 0U;
+	can_controller_l->irq_latch = 0U;
+	can_controller_l->bh_busy   = 0U;
+	can_controller_l->rx_hook   = NULL;
+	can_controller_l->tx_hook   = NULL;
+	can_controller_l->q_ptr  = isca_frame_pool_alloc(can_controller_l->q_size);
+
+	if ( can_controller_l->q_ptr == NULL ) {
+		isca_queue_release(can_rx_queue_id);
+		can_controller_l->q_id = DQ_INVALID_HANDLE;
+		return ISCA_CAN_NO_MEMORY;
+	} /*Frame pool exhausted*/
+
+	isca_wait_init(&can_controller_l->rx_wait);
 
 	/*Set CAN controllers default interrupt callback function*/
 	if ( can_controller_l->irq == CAN_IRQ_ON ) {
@@ -115,30 +153,62 @@ int lbr_isca_can_init(can_ctrl_s *can_ctrl, int queue_slots) {
  * @brief		  Read a received or wait to receive a CAN frame
  * @param[in,out] can_ctrl CAN controller instance pointer
  * @param[out]    rx_frame CAN frame instance pointer
- * @return        \ref ISCA_CAN_RX_FIFO_EMPTY
- * @return 		  \ref ISCA_CAN_INV_IO_TYPE
- * @return		  \ref ISCA_CAN_OK
+ * @return 		  \ref ISCA_CAN_INV_REQ_TYPE
+ * @return		  \ref ISCA_CAN_OK, or remaining frames in polling mode
  ********************************************************************************/
 int lbr_isca_can_receive_pkt(can_ctrl_s* can_ctrl, can_frame_s *rx_frame) {
 
-	uint8_t queue_rd_index;
-	int q_idx;
-	int ret_val = ISCA_CAN_OK;
+	return lbr_isca_can_receive_pkt_tmo(can_ctrl, rx_frame, ISCA_CAN_WAIT_FOREVER);
 
-	if (can_ctrl->irq == CAN_IRQ_ON) {
+}
 
-		do {
-			q_idx = isca_queue_rd_ptr(((can_ctrl_s*)can_ctrl)->q_id, &queue_rd_index);
-		} while( q_idx == DQ_EMPTY ); /*Wait for the interrupt handler to push a frame*/
+/********************************************************************************
+ * @brief		  Read a received or wait up to a timeout to receive a CAN frame
+ *
+ * In interrupt mode the caller sleeps on the controller's RX wait object until
+ * the interrupt handler queues a frame; in polling mode the RX FIFO is polled
+ * every \ref POLL_PERIOD_US.
+ * @param[in,out] can_ctrl   CAN controller instance pointer
+ * @param[out]    rx_frame   CAN frame instance pointer
+ * @param[in]     timeout_us Time budget in microseconds, 0 to only check
+ *                           once, \ref ISCA_CAN_WAIT_FOREVER to block
+ * @return        \ref ISCA_CAN_TIMEOUT
+ * @return 		  \ref ISCA_CAN_INV_REQ_TYPE
+ * @return		  \ref ISCA_CAN_OK, or remaining frames in polling mode
+ ********************************************************************************/
+int lbr_isca_can_receive_pkt_tmo(can_ctrl_s* can_ctrl, can_frame_s *rx_frame, uint32_t timeout_us) {
+
+	isca_qspan_s span;
+	uint32_t deadline = ISCA_TIME_Us() + timeout_us;
+	uint32_t *deadline_p = (timeout_us == ISCA_CAN_WAIT_FOREVER) ? NULL : &deadline;
+	int ret_val;
+
+	if (can_ctrl->irq == CAN_IRQ_ON) {
 
 		/*Interrupt routines use the created during initialization queue.
-		 *Copy frame from  to user*/
-		memmove(rx_frame, &can_ctrl->q_ptr[queue_rd_index], sizeof(can_frame_s));
+		 *Copy frame from the queue to user, then recycle the slot*/
+		do {
+			ret_val = lbr_isca_can_rx_peek(can_ctrl, 1U, &span, deadline_p);
+			if ( ret_val < 0 ) {
+				return ret_val;
+			} /*Timed out*/
+			isca_can_frame_unpack(rx_frame, &can_ctrl->q_ptr[span.idx[0]]);
+		} while ( isca_queue_release_n(can_ctrl->q_id, &span, 1U) == DQ_LOST ); /*Evicted while copied*/
+
+		ret_val = ISCA_CAN_OK;
 	} /*Interrupt mode*/
 	else {
 
 		/*Poll until frame is available*/
-		ret_val = isca_can_receive_frame(can_ctrl, rx_frame, CAN_REQ_BLOCKING);
+		while ( (ret_val = isca_can_receive_frame(can_ctrl, rx_frame, CAN_REQ_NONBLOCKING))
+		        == ISCA_CAN_RX_FIFO_EMPTY ) {
+
+			if ( deadline_p != NULL && (int32_t)(ISCA_TIME_Us() - deadline) >= 0 ) {
+				return ISCA_CAN_TIMEOUT;
+			} /*Out of budget*/
+
+			isca_wait_relax();
+		}
 
 	} /*Polling mode*/
 
@@ -146,11 +216,68 @@ int lbr_isca_can_receive_pkt(can_ctrl_s* can_ctrl, can_frame_s *rx_frame) {
 
 }
 
+/********************************************************************************
+ * @brief		  Read a burst of received frames, waiting up to a timeout for
+ *                the first one
+ *
+ * In interrupt mode the queued frames are copied with one memcpy per
+ * contiguous span and recycled with a single index update; in polling mode
+ * the RX FIFO is drained frame by frame.
+ * @param[in,out] can_ctrl   CAN controller instance pointer
+ * @param[out]    frames     Compact frames, see \ref isca_can_frame_unpack
+ * @param[in]     max        Capacity of frames
+ * @param[in]     timeout_us Time budget in microseconds, 0 to only check
+ *                           once, \ref ISCA_CAN_WAIT_FOREVER to block
+ * @return        Amount of frames read, at least 1
+ * @return        \ref ISCA_CAN_TIMEOUT
+ * @return        \ref ISCA_CAN_INV_PARAM
+ ********************************************************************************/
+int lbr_isca_can_receive_burst(can_ctrl_s *can_ctrl, can_cframe_s *frames, uint32_t max, uint32_t timeout_us) {
+
+	isca_qspan_s span;
+	can_frame_s rx_frame;
+	uint32_t deadline = ISCA_TIME_Us() + timeout_us;
+	uint32_t *deadline_p = (timeout_us == ISCA_CAN_WAIT_FOREVER) ? NULL : &deadline;
+	uint32_t n;
+	int ret_val;
+
+	if ( max == 0U ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	if (can_ctrl->irq == CAN_IRQ_ON) {
+
+		do {
+			ret_val = lbr_isca_can_rx_peek(can_ctrl, max, &span, deadline_p);
+			if ( ret_val < 0 ) {
+				return ret_val;
+			} /*Timed out*/
+			memcpy(frames, &can_ctrl->q_ptr[span.idx[0]], span.len[0] * sizeof(can_cframe_s));
+			memcpy(&frames[span.len[0]], &can_ctrl->q_ptr[span.idx[1]], span.len[1] * sizeof(can_cframe_s));
+		} while ( isca_queue_release_n(can_ctrl->q_id, &span, (uint32_t)ret_val) == DQ_LOST ); /*Evicted while copied*/
+
+		return ret_val;
+	} /*Interrupt mode*/
+
+	ret_val = lbr_isca_can_receive_pkt_tmo(can_ctrl, &rx_frame, timeout_us);
+	for ( n = 0U; ret_val >= 0; ) {
+		isca_can_frame_pack(&frames[n++], &rx_frame);
+		if ( n == max || ret_val == 0 ) {
+			break;
+		} /*Full, or RX FIFO drained*/
+		ret_val = isca_can_receive_frame(can_ctrl, &rx_frame, CAN_REQ_NONBLOCKING);
+	} /*Polling mode*/
+
+	return (n != 0U) ? (int)n : ret_val;
+
+}
+
 /********************************************************************************
  * @brief		Transmit a CAN frame
  * @param[in]	can_ctrl  CAN controller struct
  * @param[in]   tx_frame  CAN frame struct pointer
  * @return      \ref ISCA_CAN_BUSY
+ * @return      \ref ISCA_CAN_TIMEOUT TX buffer not released within \ref TX_BLOCK_TMO_US
  * @return      \ref ISCA_CAN_INV_IO_TYPE
  * @return      \ref ISCA_CAN_OK
  ********************************************************************************/
@@ -163,6 +290,51 @@ int lbr_isca_can_transmit_pkt(can_ctrl_s *can_ctrl, can_frame_s *tx_frame) {
 
 }
 
+/********************************************************************************
+ * @brief		Transmit a CAN frame within a time budget
+ *
+ * Waits for the TX buffer and for the transmission to complete, for at most
+ * \p timeout_us microseconds in total. A frame that could not be written in
+ * time is dropped; a frame written but not sent in time is aborted.
+ * @param[in]	can_ctrl    CAN controller struct
+ * @param[in]   tx_frame    CAN frame struct pointer
+ * @param[in]   timeout_us  Time budget in microseconds
+ * @return      \ref ISCA_CAN_TIMEOUT
+ * @return      \ref ISCA_CAN_ERROR
+ * @return      \ref ISCA_CAN_OK
+ ********************************************************************************/
+int lbr_isca_can_transmit_pkt_tmo(can_ctrl_s *can_ctrl, can_frame_s *tx_frame, uint32_t timeout_us) {
+
+	int ret_val;
+	uint32_t deadline = ISCA_TIME_Us() + timeout_us;
+
+	ret_val = isca_can_transmit_frame_dl(can_ctrl, tx_frame, deadline);
+
+	if ( ret_val == ISCA_CAN_OK ) {
+		ret_val = isca_can_tx_wait_done(can_ctrl, deadline);
+	} /*Frame written; wait for it to leave*/
+
+	return ret_val;
+
+}
+
+/********************************************************************************
+ * @brief		Transmit a pre-encoded CAN frame image
+ * @param[in]	can_ctrl  CAN controller struct
+ * @param[in]   tx_img    TX image, see \ref isca_can_tx_img_compile
+ * @return      \ref ISCA_CAN_TIMEOUT TX buffer not released within \ref TX_BLOCK_TMO_US
+ * @return      \ref ISCA_CAN_INV_REQ_TYPE
+ * @return      \ref ISCA_CAN_OK
+ ********************************************************************************/
+int lbr_isca_can_transmit_img(can_ctrl_s *can_ctrl, can_tx_img_s const *tx_img) {
+
+	int ret_val;
+
+	ret_val = isca_can_transmit_img(can_ctrl, tx_img, CAN_REQ_BLOCKING);
+	return ret_val;
+
+}
+
 /********************************************************************************
  * @brief		Set CAN controller reset mode off and acquire a queue
  * @param[in]   can_ctrl CAN controller struct
@@ -177,10 +349,17 @@ int lbr_isca_can_start(can_ctrl_s *can_ctrl) {
 	//Switch off can controller's reset mode
 	ret_val = isca_can_switch_mode(can_ctrl, ISCA_CAN_MODE_RESET_OFF);
 
-	if ( ret_val != ISCA_CAN_INV_RST_MODE ) {
-		//Acquire queue
-		can_ctrl->q_id = isca_queue_acquire(can_ctrl->q_size);
-	} /**< Controller switched-off*/
+	if ( ret_val != ISCA_CAN_INV_RST_MODE && isca_queue_size(can_ctrl->q_id) == 0U ) {
+		//Acquire queue, unless the one acquired on init is still held
+		if ( isca_queue_acquire(can_ctrl->q_size, can_ctrl->q_policy, &can_ctrl->q_id) != DQ_OK ) {
+			can_ctrl->q_id = DQ_INVALID_HANDLE;
+		}
+
+		if ( can_ctrl->rx_blocked ) {
+			can_ctrl->rx_blocked = 0U;
+			isca_can_rx_irq_enable(can_ctrl, CAN_IRQ_ON);
+		} /*Stopped while held back; the new queue is empty*/
+	} /**< Controller switched-on, queue released by stop*/
 
 	return ret_val;
 }
@@ -202,8 +381,73 @@ int lbr_isca_can_stop(can_ctrl_s *can_ctrl) {
 	if ( ret_val != ISCA_CAN_INV_RST_MODE ) {
 		//Release queue
 		isca_queue_release(can_ctrl->q_id);
+		can_ctrl->q_id = DQ_INVALID_HANDLE;
 	} /**< Controller switched-off*/
 
 	return ret_val;
 
 }
+
+/********************************************************************************
+ * @brief		Stop the CAN controller and return its RX queue storage to the
+ *              frame pool; pairs with \ref lbr_isca_can_init
+ * @param[in]   can_ctrl CAN controller struct
+ * @return 		Controller's previous \ref CAN_MODE0_REG value
+ * @return      \ref ISCA_CAN_INV_RST_MODE
+ ********************************************************************************/
+int lbr_isca_can_deinit(can_ctrl_s *can_ctrl) {
+
+	int ret_val;
+
+	ret_val = lbr_isca_can_stop(can_ctrl);
+
+	if ( ret_val != ISCA_CAN_INV_RST_MODE ) {
+		isca_frame_pool_free(can_ctrl->q_ptr);
+		can_ctrl->q_ptr  = NULL;
+		can_ctrl->q_size = 0U;
+	} /*Controller switched-off, no producer left*/
+
+	return ret_val;
+
+}
+
+/********************************************************************************
+ * @brief		Frames lost to the RX queue overflow policy
+ * @param[in]   can_ctrl CAN controller struct
+ * @return 		Drop count since the queue was acquired
+ ********************************************************************************/
+uint32_t lbr_isca_can_rx_drops(can_ctrl_s *can_ctrl) {
+
+	return isca_queue_drops(can_ctrl->q_id);
+
+}
+
+/******
+ * PRIVATE FUNCTIONS DEFINITION
+ ******/
+/*Peek up to max queued frames, running the interrupt bottom half and
+ *sleeping on the RX wait object while the queue is empty; returns the
+ *amount peeked or ISCA_CAN_TIMEOUT*/
+static int lbr_isca_can_rx_peek(can_ctrl_s *can_ctrl, uint32_t max, isca_qspan_s *span,
+                                uint32_t const *deadline) {
+
+	uint32_t seq;
+	uint32_t n;
+
+	for (;;) {
+		seq = isca_wait_prepare(&can_ctrl->rx_wait);
+
+		/*Decode the frames staged by the IRQ top half, unless a worker is on it*/
+		isca_can_bh_run(can_ctrl, CAN_RX_BURST);
+
+		n = isca_queue_peek_n(can_ctrl->q_id, max, span);
+		if ( n != 0U ) {
+			return (int)n;
+		} /*Frames available*/
+
+		if ( isca_wait_block(&can_ctrl->rx_wait, seq, deadline) == WAIT_TIMEOUT ) {
+			return ISCA_CAN_TIMEOUT;
+		} /*Wait for the interrupt handler to push a frame*/
+	}
+
+}
@@ -0,0 +1,258 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN shared-memory broadcast ring
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_BCAST.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_BCAST.c
+ *
+ * @brief Single-writer, multi-reader broadcast of the RX stream
+ *
+ * Slots are written seqlock style: the sequence number turns odd before
+ * the frame is stored and takes its final value after, so a reader that
+ * finds the same, expected sequence number before and after copying a
+ * frame holds an intact copy.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_BCAST.h"
+#include <string.h>
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static int isca_bcast_hook(can_ctrl_s *can_ctrl, can_frame_s const *rx_frame, uint32_t ts, void *arg);
+static int isca_bcast_match(isca_bcast_rd_s const *rd, uint32_t hdr);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize an empty broadcast ring; done by the writer
+ * @param[out] ring  Broadcast ring, e.g., in a shared memory segment
+ * @return     None
+ */
+void isca_bcast_init(isca_bcast_s *ring) {
+
+	memset(ring, 0, sizeof(isca_bcast_s));
+	ring->magic = BCAST_MAGIC;
+	ring->slots = BCAST_SLOTS;
+
+}
+
+/**
+ * @brief      Broadcast a controller's RX stream; its RX queue stays empty
+ * @param[in]  ring      Broadcast ring
+ * @param[in]  can_ctrl  Controller; takes its RX hook over
+ * @return     None
+ */
+void isca_bcast_attach(isca_bcast_s *ring, can_ctrl_s *can_ctrl) {
+
+	can_ctrl->rx_hook_arg = ring;
+	can_ctrl->rx_hook     = isca_bcast_hook;
+
+}
+
+/**
+ * @brief      Store a frame in the next slot, overwriting the oldest one
+ * @param[in]  ring   Broadcast ring; one writer only
+ * @param[in]  frame  Frame
+ * @param[in]  ts     RX timestamp, \ref ISCA_TIME_Us
+ * @return     None
+ */
+void isca_bcast_publish(isca_bcast_s *ring, can_frame_s const *frame, uint32_t ts) {
+
+	uint32_t pos = ring->head;
+	isca_bcast_slot_s *slot = &ring->slot[pos & (BCAST_SLOTS - 1U)];
+
+	__atomic_store_n(&slot->seq, BCAST_SEQ_DONE(pos) - 1U, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE); /*Odd before the frame*/
+
+	slot->ts = ts;
+	isca_can_frame_pack(&slot->frame, frame);
+
+	__atomic_store_n(&slot->seq, BCAST_SEQ_DONE(pos), __ATOMIC_RELEASE);
+	__atomic_store_n(&ring->head, pos + 1U, __ATOMIC_RELEASE);
+
+}
+
+/**
+ * @brief      Attach a reader to a ring, from its next frame on
+ * @param[out] rd    Reader, without filters
+ * @param[in]  ring  Broadcast ring, initialized by the writer
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_CAN_INV_PARAM, ring not initialized or of another
+ *             \ref BCAST_SLOTS
+ */
+int isca_bcast_rd_init(isca_bcast_rd_s *rd, isca_bcast_s const *ring) {
+
+	if ( ring->magic != BCAST_MAGIC || ring->slots != BCAST_SLOTS ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	memset(rd, 0, sizeof(isca_bcast_rd_s));
+	rd->ring = ring;
+	rd->pos  = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Add a reader filter; frames matching any filter are read
+ * @param[in]  rd    Reader
+ * @param[in]  id    Filter code, on \ref can_cframe_s hdr, e.g.,
+ *                   0x123 | \ref CAN_CF_IDE
+ * @param[in]  mask  Filter mask, e.g., \ref CAN_CF_ID_MSK | \ref CAN_CF_IDE
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_BCAST_FULL
+ */
+int isca_bcast_rd_filter(isca_bcast_rd_s *rd, uint32_t id, uint32_t mask) {
+
+	if ( rd->n_filt >= BCAST_FILTERS ) {
+		return ISCA_BCAST_FULL;
+	}
+
+	rd->filt_id[rd->n_filt]   = id & mask;
+	rd->filt_mask[rd->n_filt] = mask;
+	rd->n_filt++;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Read up to max frames passing the reader's filters, without
+ *             waiting; frames the writer overwrote first are skipped and
+ *             added to rd->lost
+ * @param[in]  rd      Reader
+ * @param[out] frames  Frames
+ * @param[out] ts      RX timestamps, NULL if not needed
+ * @param[in]  max     Capacity of frames and ts
+ * @return     Amount of frames read
+ */
+uint32_t isca_bcast_read(isca_bcast_rd_s *rd, can_cframe_s *frames, uint32_t *ts, uint32_t max) {
+
+	isca_bcast_slot_s const *slot;
+	isca_bcast_s const *ring = rd->ring;
+	uint32_t pos = rd->pos;
+	uint32_t head;
+	uint32_t seq;
+	uint32_t hdr;
+	uint32_t n = 0U;
+
+	head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+	while ( n < max && pos != head ) {
+
+		if ( head - pos > BCAST_SLOTS ) {
+			rd->lost += head - pos - BCAST_SLOTS;
+			pos = head - BCAST_SLOTS;
+		} /*Lapped; resume from the oldest frame*/
+
+		slot = &ring->slot[pos & (BCAST_SLOTS - 1U)];
+		seq  = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+		if ( seq == BCAST_SEQ_DONE(pos) ) {
+
+			hdr = slot->frame.hdr;
+			if ( isca_bcast_match(rd, hdr) ) {
+				frames[n] = slot->frame;
+				if ( ts != NULL ) {
+					ts[n] = slot->ts;
+				}
+			}
+
+			__atomic_thread_fence(__ATOMIC_ACQUIRE); /*Copy before the recheck*/
+
+			if ( __atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq ) {
+				if ( isca_bcast_match(rd, hdr) ) {
+					n++;
+				}
+				pos++;
+				continue;
+			} /*Intact*/
+		}
+
+		/*Overwritten while or before being read*/
+		rd->lost++;
+		pos++;
+		head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	}
+
+	rd->pos = pos;
+
+	return n;
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*RX hook: broadcast the frame; consumed*/
+static int isca_bcast_hook(can_ctrl_s *can_ctrl, can_frame_s const *rx_frame, uint32_t ts, void *arg) {
+
+	(void)can_ctrl;
+
+	isca_bcast_publish((isca_bcast_s *)arg, rx_frame, ts);
+
+	return 1;
+}
+
+/*Reader filters check*/
+static int isca_bcast_match(isca_bcast_rd_s const *rd, uint32_t hdr) {
+
+	uint8_t i;
+
+	if ( rd->n_filt == 0U ) {
+		return 1;
+	}
+
+	for ( i = 0U; i < rd->n_filt; i++ ) {
+		if ( (hdr & rd->filt_mask[i]) == rd->filt_id[i] ) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,275 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN coroutines
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_CO.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_CO.c
+ *
+ * @brief Stackless coroutines awaiting CAN send/receive, and their
+ * single-threaded executor
+ *
+ * Every \ref isca_co_exec_run pass drains the attached controllers' RX
+ * queues, which runs their interrupt bottom halves in interrupt mode or
+ * polls their RX FIFOs otherwise, hands each frame to the first coroutine,
+ * in spawn order, awaiting a matching one, retries pending sends, expires
+ * deadlines and resumes every coroutine whose await completed. Many
+ * request/response sessions so share one thread and no session blocks
+ * another.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note The executor owns the RX queues of the attached controllers; do
+ * not receive from them elsewhere
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_CO.h"
+#include "ISCA_CAN_API.h"
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static void isca_co_deliver(isca_co_exec_s *exec, can_ctrl_s *can_ctrl, can_frame_s const *rx_frame);
+static void isca_co_arm(isca_co_s *co, can_ctrl_s *can_ctrl, can_frame_s *frame,
+                        uint32_t timeout_us, uint8_t wait);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize an executor without coroutines or controllers
+ * @param[out] exec      Executor
+ * @param[in]  stray     Called for received frames no coroutine awaits,
+ *                       NULL to drop them
+ * @param[in]  stray_arg Argument of stray
+ * @return     None
+ */
+void isca_co_exec_init(isca_co_exec_s *exec, isca_co_stray_t stray, void *stray_arg) {
+
+	memset(exec, 0, sizeof(isca_co_exec_s));
+
+	exec->stray     = stray;
+	exec->stray_arg = stray_arg;
+
+}
+
+/**
+ * @brief      Receive from a controller's RX queue on behalf of the coroutines
+ * @param[in]  exec     Executor
+ * @param[in]  can_ctrl Controller, initialized with \ref lbr_isca_can_init
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_CO_FULL
+ */
+int isca_co_exec_attach(isca_co_exec_s *exec, can_ctrl_s *can_ctrl) {
+
+	if ( exec->n_ctrl >= CO_MAX_CTRL ) {
+		return ISCA_CO_FULL;
+	}
+
+	exec->ctrl[exec->n_ctrl++] = can_ctrl;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Start a coroutine; it first runs on the executor's next pass
+ * @param[in]  exec Executor
+ * @param[out] co   Caller provided coroutine storage, in use until its body
+ *                  returns \ref ISCA_CO_DONE
+ * @param[in]  fn   Body
+ * @param[in]  arg  State kept across awaits
+ * @return     None
+ */
+void isca_co_spawn(isca_co_exec_s *exec, isca_co_s *co, isca_co_fn_t fn, void *arg) {
+
+	memset(co, 0, sizeof(isca_co_s));
+
+	co->fn  = fn;
+	co->arg = arg;
+
+	if ( exec->tail != NULL ) {
+		exec->tail->next = co;
+	}
+	else {
+		exec->head = co;
+	}
+	exec->tail = co;
+
+}
+
+/**
+ * @brief      One executor pass: receive, send, expire and resume
+ * @param[in]  exec   Executor
+ * @param[in]  budget Most frames received per controller
+ * @return     Coroutines alive after the pass
+ */
+uint32_t isca_co_exec_run(isca_co_exec_s *exec, uint32_t budget) {
+
+	can_frame_s rx_frame;
+	isca_co_s *co;
+	isca_co_s *prev = NULL;
+	isca_co_s *next;
+	uint32_t alive = 0U;
+	uint32_t now;
+	uint32_t n;
+	uint8_t  c;
+
+	for ( c = 0U; c < exec->n_ctrl; c++ ) {
+		for ( n = 0U; n < budget; n++ ) {
+			if ( lbr_isca_can_receive_pkt_tmo(exec->ctrl[c], &rx_frame, 0U) < 0 ) {
+				break;
+			} /*Drained*/
+			isca_co_deliver(exec, exec->ctrl[c], &rx_frame);
+		}
+	} /*Receive*/
+
+	now = ISCA_TIME_Us();
+
+	for ( co = exec->head; co != NULL; co = next ) {
+
+		next = co->next;
+
+		if ( co->wait == ISCA_CO_W_TX &&
+		     isca_can_transmit_frame(co->can_ctrl, co->frame, CAN_REQ_NONBLOCKING) == ISCA_CAN_OK ) {
+			co->wait   = ISCA_CO_W_NONE;
+			co->result = ISCA_CAN_OK;
+		} /*TX buffer free*/
+
+		if ( co->wait != ISCA_CO_W_NONE && co->timed && (int32_t)(now - co->deadline) >= 0 ) {
+			co->wait   = ISCA_CO_W_NONE;
+			co->result = ISCA_CAN_TIMEOUT;
+		} /*Await expired*/
+
+		if ( co->wait == ISCA_CO_W_NONE && co->fn(co) == ISCA_CO_DONE ) {
+			if ( prev != NULL ) {
+				prev->next = next;
+			}
+			else {
+				exec->head = next;
+			}
+			if ( exec->tail == co ) {
+				exec->tail = prev;
+			}
+			continue;
+		} /*Finished, unlink*/
+
+		prev = co;
+		alive++;
+	}
+
+	return alive;
+}
+
+/**
+ * @brief      Arm an RX await; use \ref ISCA_CO_RECV
+ * @param[in]  co         Coroutine
+ * @param[in]  can_ctrl   Controller, attached to the executor
+ * @param[in]  id         Filter code
+ * @param[in]  mask       Filter mask, ID bits compared
+ * @param[out] frame      Destination of the matching frame
+ * @param[in]  timeout_us Time budget, \ref ISCA_CAN_WAIT_FOREVER for none
+ * @return     None
+ */
+void isca_co_recv(isca_co_s *co, can_ctrl_s *can_ctrl, uint32_t id, uint32_t mask,
+                  can_frame_s *frame, uint32_t timeout_us) {
+
+	co->id   = id & mask;
+	co->mask = mask;
+	isca_co_arm(co, can_ctrl, frame, timeout_us, ISCA_CO_W_RX);
+
+}
+
+/**
+ * @brief      Arm a TX await; use \ref ISCA_CO_SEND
+ * @param[in]  co         Coroutine
+ * @param[in]  can_ctrl   Controller
+ * @param[in]  frame      Frame, read when the TX buffer frees up
+ * @param[in]  timeout_us Time budget, \ref ISCA_CAN_WAIT_FOREVER for none
+ * @return     None
+ */
+void isca_co_send(isca_co_s *co, can_ctrl_s *can_ctrl, can_frame_s *frame, uint32_t timeout_us) {
+
+	isca_co_arm(co, can_ctrl, frame, timeout_us, ISCA_CO_W_TX);
+
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+static void isca_co_arm(isca_co_s *co, can_ctrl_s *can_ctrl, can_frame_s *frame,
+                        uint32_t timeout_us, uint8_t wait) {
+
+	co->can_ctrl = can_ctrl;
+	co->frame    = frame;
+	co->timed    = (timeout_us != ISCA_CAN_WAIT_FOREVER);
+	co->deadline = ISCA_TIME_Us() + timeout_us;
+	co->result   = ISCA_CAN_TIMEOUT;
+	co->wait     = wait;
+
+}
+
+/*Hand a received frame to the first coroutine awaiting it*/
+static void isca_co_deliver(isca_co_exec_s *exec, can_ctrl_s *can_ctrl, can_frame_s const *rx_frame) {
+
+	isca_co_s *co;
+
+	for ( co = exec->head; co != NULL; co = co->next ) {
+		if ( co->wait == ISCA_CO_W_RX && co->can_ctrl == can_ctrl &&
+		     (rx_frame->ID & co->mask) == co->id ) {
+			*co->frame = *rx_frame;
+			co->result = ISCA_CAN_OK;
+			co->wait   = ISCA_CO_W_NONE;
+			return;
+		}
+	}
+
+	if ( exec->stray != NULL ) {
+		exec->stray(can_ctrl, rx_frame, exec->stray_arg);
+	}
+	else {
+		exec->strays++;
+	}
+
+}
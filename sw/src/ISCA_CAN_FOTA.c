@@ -0,0 +1,752 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN firmware update streaming
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_FOTA.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_FOTA.c
+ *
+ * @brief Windowed firmware image streaming with per block CRC and
+ * selective retransmission
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note Either end owns its controller's RX queue when polled; frames of
+ * other IDs are dropped. Feed frames with \ref isca_fota_tx_input or
+ * \ref isca_fota_rx_input instead to share the controller.
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_FOTA.h"
+#include "ISCA_CAN_API.h"
+
+/******
+ * DEFINITIONS
+ ******/
+#define FOTA_STAGE_TOTAL      (FOTA_STAGES * FOTA_STAGE_SIZE) /*!<Staging memory*/
+
+/*CRC32 (IEEE 802.3, reflected), one nibble per lookup*/
+static const uint32_t fota_crc_tab[16] = {
+	0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+	0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+	0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+	0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static uint32_t isca_fota_blk_len(uint32_t len, uint32_t blk);
+static uint32_t isca_fota_frame_data(uint8_t ide);
+static uint32_t isca_fota_be32(uint8_t const *p);
+static void isca_fota_put_be32(uint8_t *p, uint32_t v);
+static void isca_fota_frame(can_frame_s *frame, uint32_t id, uint8_t ide, uint16_t dlc);
+static void isca_fota_tx_open(isca_fota_tx_s *tx);
+static void isca_fota_tx_pump(isca_fota_tx_s *tx, uint32_t now);
+static void isca_fota_rx_rsp(isca_fota_rx_s *rx, uint8_t op, uint32_t blk, uint8_t first, uint8_t count);
+static void isca_fota_rx_block(isca_fota_rx_s *rx, uint32_t blk, uint8_t const *d);
+static int isca_fota_rx_advance(isca_fota_rx_s *rx);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      CRC32 (IEEE 802.3) of a buffer
+ * @param[in]  crc   CRC of the preceding data, 0 to start
+ * @param[in]  data  Data
+ * @param[in]  len   Data length
+ * @return     CRC32
+ */
+uint32_t isca_fota_crc32(uint32_t crc, uint8_t const *data, uint32_t len) {
+
+	uint32_t i;
+
+	crc = ~crc;
+	for ( i = 0U; i < len; i++ ) {
+		crc = fota_crc_tab[(crc ^ data[i]) & 0xFU] ^ (crc >> 4);
+		crc = fota_crc_tab[(crc ^ ((uint32_t)data[i] >> 4)) & 0xFU] ^ (crc >> 4);
+	}
+
+	return ~crc;
+}
+
+/*-----
+ * SENDER
+ *----*/
+/**
+ * @brief      Initialize an idle sender
+ * @param[out] tx        Sender
+ * @param[in]  can_ctrl  Controller, initialized with \ref lbr_isca_can_init
+ * @param[in]  tx_id     ID of the frames sent; \ref FOTA_EXT_MASK bits clear for \ref CAN_FRAME_EXT
+ * @param[in]  rx_id     ID of the receiver's responses
+ * @param[in]  ide       \ref CAN_FRAME_STD or \ref CAN_FRAME_EXT
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_CAN_INV_PARAM, tx_id sets \ref FOTA_EXT_MASK bits of an extended stream
+ */
+int isca_fota_tx_init(isca_fota_tx_s *tx, can_ctrl_s *can_ctrl, uint32_t tx_id, uint32_t rx_id, uint8_t ide) {
+
+	if ( ide == CAN_FRAME_EXT && (tx_id & FOTA_EXT_MASK) != 0U ) {
+		return ISCA_CAN_INV_PARAM;
+	} /*Data frame IDs would not match tx_id at the receiver*/
+
+	memset(tx, 0, sizeof(isca_fota_tx_s));
+	tx->can_ctrl = can_ctrl;
+	tx->tx_id    = tx_id;
+	tx->rx_id    = rx_id;
+	tx->ide      = ide;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Start streaming an image; \ref isca_fota_tx_poll carries it out
+ * @param[in]  tx    Sender
+ * @param[in]  img   Image, kept by the caller until the transfer is done
+ * @param[in]  len   Image length, at least 1 byte
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_FOTA_BUSY
+ * @return     \ref ISCA_CAN_INV_PARAM
+ */
+int isca_fota_tx_start(isca_fota_tx_s *tx, uint8_t const *img, uint32_t len) {
+
+	if ( tx->state == FOTA_START || tx->state == FOTA_STREAM ) {
+		return ISCA_FOTA_BUSY;
+	}
+
+	if ( len == 0U ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	tx->img      = img;
+	tx->len      = len;
+	tx->n_blk    = (len + FOTA_BLOCK_SIZE - 1U) / FOTA_BLOCK_SIZE;
+	tx->base     = 0U;
+	tx->next     = 0U;
+	tx->frames   = 0U;
+	tx->resent   = 0U;
+	tx->retries  = 0U;
+	tx->res      = ISCA_FOTA_RUN;
+	tx->deadline = ISCA_TIME_Us();
+	tx->state    = FOTA_START;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Process a receiver response; other frames are ignored
+ * @param[in]  tx        Sender
+ * @param[in]  rx_frame  Frame
+ * @return     None
+ */
+void isca_fota_tx_input(isca_fota_tx_s *tx, can_frame_s const *rx_frame) {
+
+	isca_fota_blk_s *b;
+	uint8_t const *d = rx_frame->DATA;
+	uint32_t blk;
+	uint32_t n;
+	uint32_t i;
+
+	if ( rx_frame->ID != tx->rx_id || rx_frame->IDE != tx->ide || rx_frame->DLC == 0U ) {
+		return;
+	}
+
+	/*16-bit block number, relative to the oldest block in flight*/
+	blk = tx->base + (uint32_t)(int32_t)(int16_t)(uint16_t)((((uint32_t)d[1] << 8) | d[2]) - tx->base);
+
+	switch ( d[0] ) {
+
+	case FOTA_RSP_READY:
+		if ( tx->state == FOTA_START ) {
+			tx->retries = 0U;
+			tx->state   = FOTA_STREAM;
+		}
+		break;
+
+	case FOTA_RSP_ACK:
+		if ( tx->state != FOTA_STREAM || rx_frame->DLC < 3U || blk - tx->base >= tx->next - tx->base ) {
+			break;
+		} /*Not in flight*/
+
+		tx->blk[blk & (FOTA_WINDOW - 1U)].acked = 1U;
+
+		while ( tx->base != tx->next && tx->blk[tx->base & (FOTA_WINDOW - 1U)].acked ) {
+			tx->base++;
+		} /*Slide the window*/
+
+		if ( tx->base == tx->n_blk ) {
+			tx->state = FOTA_DONE;
+			tx->res   = ISCA_CAN_OK;
+		}
+		break;
+
+	case FOTA_RSP_NACK:
+		if ( tx->state != FOTA_STREAM || rx_frame->DLC < 5U || blk - tx->base >= tx->next - tx->base ) {
+			break;
+		} /*Not in flight*/
+
+		b = &tx->blk[blk & (FOTA_WINDOW - 1U)];
+		if ( b->acked ) {
+			break;
+		}
+
+		n = (isca_fota_blk_len(tx->len, blk) + isca_fota_frame_data(tx->ide) - 1U) / isca_fota_frame_data(tx->ide);
+		if ( (uint32_t)d[3] + d[4] < n ) {
+			n = (uint32_t)d[3] + d[4];
+		}
+
+		for ( i = d[3]; i < n; i++ ) {
+			b->tx_map[i >> 5] |= (1UL << (i & 31U));
+			tx->resent++;
+		}
+		b->blk_pend = 1U;
+		break;
+
+	case FOTA_RSP_ERROR:
+		if ( tx->state == FOTA_START || tx->state == FOTA_STREAM ) {
+			tx->state = FOTA_FAIL;
+			tx->res   = ISCA_FOTA_ABORT;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+}
+
+/**
+ * @brief      Receive up to budget responses, then send while the TX buffer
+ *             takes frames
+ * @param[in]  tx      Sender
+ * @param[in]  budget  Most frames received
+ * @return     \ref ISCA_FOTA_RUN
+ * @return     \ref ISCA_CAN_OK, image sent
+ * @return     \ref ISCA_CAN_TIMEOUT, \ref ISCA_FOTA_ABORT
+ */
+int isca_fota_tx_poll(isca_fota_tx_s *tx, uint32_t budget) {
+
+	isca_fota_blk_s *b;
+	can_frame_s frame;
+	uint32_t now;
+	uint32_t blk;
+
+	while ( budget-- != 0U && lbr_isca_can_receive_pkt_tmo(tx->can_ctrl, &frame, 0U) == ISCA_CAN_OK ) {
+		isca_fota_tx_input(tx, &frame);
+	}
+
+	now = ISCA_TIME_Us();
+
+	if ( tx->state == FOTA_START && (int32_t)(now - tx->deadline) >= 0 ) {
+
+		if ( tx->retries > FOTA_RETRIES ) {
+			tx->state = FOTA_FAIL;
+			tx->res   = ISCA_CAN_TIMEOUT;
+			return tx->res;
+		}
+
+		isca_fota_frame(&frame, tx->tx_id, tx->ide, 6U);
+		frame.DATA[1] = FOTA_IDX_START;
+		isca_fota_put_be32(&frame.DATA[2], tx->len);
+
+		if ( isca_can_transmit_frame(tx->can_ctrl, &frame, CAN_REQ_NONBLOCKING) == ISCA_CAN_OK ) {
+			tx->frames++;
+			tx->retries++;
+			tx->deadline = now + FOTA_ACK_TMO_US;
+		}
+	} /*Handshake*/
+
+	if ( tx->state != FOTA_STREAM ) {
+		return tx->res;
+	}
+
+	isca_fota_tx_open(tx);
+
+	for ( blk = tx->base; blk != tx->next; blk++ ) {
+
+		b = &tx->blk[blk & (FOTA_WINDOW - 1U)];
+
+		if ( b->acked || b->blk_pend || (int32_t)(now - b->deadline) < 0 ) {
+			continue;
+		}
+
+		if ( ++b->retries > FOTA_RETRIES ) {
+			tx->state = FOTA_FAIL;
+			tx->res   = ISCA_CAN_TIMEOUT;
+			return tx->res;
+		}
+
+		b->blk_pend = 1U;
+	} /*Unacknowledged blocks: send the block frame again, a status request*/
+
+	isca_fota_tx_pump(tx, now);
+
+	return tx->res;
+}
+
+/*-----
+ * RECEIVER
+ *----*/
+/**
+ * @brief      Initialize a receiver, waiting for a start frame
+ * @param[out] rx        Receiver
+ * @param[in]  can_ctrl  Controller, initialized with \ref lbr_isca_can_init
+ * @param[in]  tx_id     ID of the sender's frames; \ref FOTA_EXT_MASK bits clear for \ref CAN_FRAME_EXT
+ * @param[in]  rx_id     ID of the responses sent
+ * @param[in]  ide       \ref CAN_FRAME_STD or \ref CAN_FRAME_EXT
+ * @param[in]  stage     Staging memory, \ref FOTA_STAGES * \ref FOTA_STAGE_SIZE bytes
+ * @param[in]  flush     Staging buffer flush, called in image order
+ * @param[in]  arg       Caller context
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_CAN_INV_PARAM, tx_id sets \ref FOTA_EXT_MASK bits of an extended stream
+ */
+int isca_fota_rx_init(isca_fota_rx_s *rx, can_ctrl_s *can_ctrl, uint32_t tx_id, uint32_t rx_id, uint8_t ide,
+                      uint8_t *stage, isca_fota_flush_t flush, void *arg) {
+
+	if ( ide == CAN_FRAME_EXT && (tx_id & FOTA_EXT_MASK) != 0U ) {
+		return ISCA_CAN_INV_PARAM;
+	} /*Data frame IDs would never match tx_id*/
+
+	memset(rx, 0, sizeof(isca_fota_rx_s));
+	rx->can_ctrl = can_ctrl;
+	rx->tx_id    = tx_id;
+	rx->rx_id    = rx_id;
+	rx->ide      = ide;
+	rx->stage    = stage;
+	rx->flush    = flush;
+	rx->arg      = arg;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Process a sender frame; other frames are ignored
+ * @param[in]  rx        Receiver
+ * @param[in]  rx_frame  Frame
+ * @return     None
+ */
+void isca_fota_rx_input(isca_fota_rx_s *rx, can_frame_s const *rx_frame) {
+
+	uint8_t const *d = rx_frame->DATA;
+	uint8_t const *data;
+	uint32_t fd = isca_fota_frame_data(rx->ide);
+	uint32_t dlen;
+	uint32_t blk;
+	uint32_t off;
+	uint32_t n;
+	uint8_t  blk8;
+	uint8_t  idx;
+
+	if ( rx_frame->IDE != rx->ide ) {
+		return;
+	}
+
+	if ( rx->ide == CAN_FRAME_EXT && (rx_frame->ID & ~FOTA_EXT_MASK) == rx->tx_id &&
+	     (rx_frame->ID & FOTA_EXT_DATA) != 0U ) {
+		blk8 = (uint8_t)(rx_frame->ID >> 8);
+		idx  = (uint8_t)rx_frame->ID;
+		data = d;
+		dlen = rx_frame->DLC;
+		if ( idx >= FOTA_IDX_START ) {
+			return;
+		}
+	} /*Extended data frame, block and frame index in the ID*/
+	else if ( rx_frame->ID == rx->tx_id && rx_frame->DLC >= 2U ) {
+		blk8 = d[0];
+		idx  = d[1];
+		data = &d[2];
+		dlen = rx_frame->DLC - 2U;
+		if ( rx->ide == CAN_FRAME_EXT && idx < FOTA_IDX_START ) {
+			return;
+		}
+	} /*Block, start or base data frame*/
+	else {
+		return;
+	}
+
+	if ( idx == FOTA_IDX_START ) {
+
+		if ( rx_frame->DLC < 6U ) {
+			return;
+		}
+
+		if ( rx->state != FOTA_STREAM || rx->len != isca_fota_be32(&d[2]) || rx->base != 0U || rx->done != 0U ) {
+			memset(rx->rx_map, 0, sizeof(rx->rx_map));
+			rx->len   = isca_fota_be32(&d[2]);
+			rx->n_blk = (rx->len + FOTA_BLOCK_SIZE - 1U) / FOTA_BLOCK_SIZE;
+			rx->base  = 0U;
+			rx->done  = 0U;
+			rx->res   = ISCA_FOTA_RUN;
+			rx->state = FOTA_STREAM;
+			if ( rx->n_blk == 0U ) {
+				rx->res   = ISCA_CAN_OK;
+				rx->state = FOTA_DONE;
+			}
+		} /*New transfer; a repeated start is only answered*/
+
+		isca_fota_rx_rsp(rx, FOTA_RSP_READY, 0U, 0U, 0U);
+		return;
+	}
+
+	if ( rx->state != FOTA_STREAM && rx->state != FOTA_DONE ) {
+		return;
+	}
+
+	/*8-bit block number, relative to the oldest block not received*/
+	blk = rx->base + (uint32_t)(int32_t)(int8_t)(uint8_t)(blk8 - rx->base);
+
+	if ( idx == FOTA_IDX_BLOCK ) {
+		if ( rx_frame->DLC == 8U ) {
+			isca_fota_rx_block(rx, blk, d);
+		}
+		return;
+	}
+
+	if ( rx->state != FOTA_STREAM || blk - rx->base >= FOTA_WINDOW || blk >= rx->n_blk ||
+	     (rx->done & (1UL << (blk - rx->base))) != 0U ) {
+		return;
+	} /*Outside the window, or received*/
+
+	off = (uint32_t)idx * fd;
+	n   = isca_fota_blk_len(rx->len, blk);
+	if ( off >= n ) {
+		return;
+	}
+
+	n -= off;
+	if ( n > fd ) {
+		n = fd;
+	}
+
+	if ( dlen < n ) {
+		return;
+	}
+
+	memcpy(&rx->stage[(blk * FOTA_BLOCK_SIZE) % FOTA_STAGE_TOTAL + off], data, n);
+	rx->rx_map[blk & (FOTA_WINDOW - 1U)][idx >> 5] |= (1UL << (idx & 31U));
+
+}
+
+/**
+ * @brief      Receive up to budget frames, then send the queued responses
+ *             while the TX buffer takes them
+ * @param[in]  rx      Receiver
+ * @param[in]  budget  Most frames received
+ * @return     \ref ISCA_FOTA_RUN, also before the start frame
+ * @return     \ref ISCA_CAN_OK, image received and flushed
+ * @return     \ref ISCA_FOTA_FLUSH
+ */
+int isca_fota_rx_poll(isca_fota_rx_s *rx, uint32_t budget) {
+
+	can_frame_s frame;
+
+	while ( budget-- != 0U && lbr_isca_can_receive_pkt_tmo(rx->can_ctrl, &frame, 0U) == ISCA_CAN_OK ) {
+		isca_fota_rx_input(rx, &frame);
+	}
+
+	while ( rx->rsp_head != rx->rsp_tail &&
+	        isca_can_transmit_frame(rx->can_ctrl, &rx->rsp[rx->rsp_tail & (FOTA_RSP_QUEUE - 1U)],
+	                                CAN_REQ_NONBLOCKING) == ISCA_CAN_OK ) {
+		rx->rsp_tail++;
+	}
+
+	return (rx->state == FOTA_IDLE) ? ISCA_FOTA_RUN : rx->res;
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Length of an image block*/
+static uint32_t isca_fota_blk_len(uint32_t len, uint32_t blk) {
+
+	len -= blk * FOTA_BLOCK_SIZE;
+
+	return (len < FOTA_BLOCK_SIZE) ? len : FOTA_BLOCK_SIZE;
+}
+
+/*Data bytes per data frame of a stream*/
+static uint32_t isca_fota_frame_data(uint8_t ide) {
+
+	return (ide == CAN_FRAME_EXT) ? FOTA_EXT_FRAME_DATA : FOTA_FRAME_DATA;
+
+}
+
+static uint32_t isca_fota_be32(uint8_t const *p) {
+
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+
+}
+
+static void isca_fota_put_be32(uint8_t *p, uint32_t v) {
+
+	p[0] = (uint8_t)(v >> 24);
+	p[1] = (uint8_t)(v >> 16);
+	p[2] = (uint8_t)(v >> 8);
+	p[3] = (uint8_t)v;
+
+}
+
+/*Blank frame*/
+static void isca_fota_frame(can_frame_s *frame, uint32_t id, uint8_t ide, uint16_t dlc) {
+
+	frame->ID  = id;
+	frame->IDE = ide;
+	frame->RTR = 0U;
+	frame->DLC = dlc;
+	memset(frame->DATA, 0, sizeof(frame->DATA));
+
+}
+
+/*Open image blocks while the window has room; all their frames to send*/
+static void isca_fota_tx_open(isca_fota_tx_s *tx) {
+
+	isca_fota_blk_s *b;
+	uint32_t len;
+	uint32_t n;
+	uint32_t i;
+
+	while ( tx->next != tx->n_blk && tx->next - tx->base < FOTA_WINDOW ) {
+
+		b   = &tx->blk[tx->next & (FOTA_WINDOW - 1U)];
+		len = isca_fota_blk_len(tx->len, tx->next);
+		n   = (len + isca_fota_frame_data(tx->ide) - 1U) / isca_fota_frame_data(tx->ide);
+
+		memset(b, 0, sizeof(isca_fota_blk_s));
+		for ( i = 0U; i < n / 32U; i++ ) {
+			b->tx_map[i] = 0xFFFFFFFFU;
+		}
+		if ( (n & 31U) != 0U ) {
+			b->tx_map[i] = (1UL << (n & 31U)) - 1U;
+		}
+
+		b->crc      = isca_fota_crc32(0U, &tx->img[tx->next * FOTA_BLOCK_SIZE], len);
+		b->blk_pend = 1U;
+		tx->next++;
+	}
+
+}
+
+/*Send, oldest block first, its frames to send then its block frame, until
+ *the TX buffer is busy*/
+static void isca_fota_tx_pump(isca_fota_tx_s *tx, uint32_t now) {
+
+	isca_fota_blk_s *b;
+	can_frame_s frame;
+	uint32_t fd = isca_fota_frame_data(tx->ide);
+	uint32_t blk;
+	uint32_t off;
+	uint32_t len;
+	uint32_t n;
+	uint32_t w;
+	uint32_t idx;
+
+	for ( blk = tx->base; blk != tx->next; blk++ ) {
+
+		b   = &tx->blk[blk & (FOTA_WINDOW - 1U)];
+		len = isca_fota_blk_len(tx->len, blk);
+
+		if ( b->acked ) {
+			continue;
+		}
+
+		for ( w = 0U; w < FOTA_MAP_WORDS; w++ ) {
+			while ( b->tx_map[w] != 0U ) {
+
+				idx = (w << 5) + (uint32_t)__builtin_ctz(b->tx_map[w]);
+				off = idx * fd;
+				n   = (len - off < fd) ? len - off : fd;
+
+				if ( tx->ide == CAN_FRAME_EXT ) {
+					isca_fota_frame(&frame, tx->tx_id | FOTA_EXT_DATA | ((blk & 0xFFU) << 8) | idx, tx->ide, (uint16_t)n);
+					memcpy(frame.DATA, &tx->img[blk * FOTA_BLOCK_SIZE + off], n);
+				} /*Block and frame index in the ID*/
+				else {
+					isca_fota_frame(&frame, tx->tx_id, tx->ide, (uint16_t)(n + 2U));
+					frame.DATA[0] = (uint8_t)blk;
+					frame.DATA[1] = (uint8_t)idx;
+					memcpy(&frame.DATA[2], &tx->img[blk * FOTA_BLOCK_SIZE + off], n);
+				}
+
+				if ( isca_can_transmit_frame(tx->can_ctrl, &frame, CAN_REQ_NONBLOCKING) != ISCA_CAN_OK ) {
+					return;
+				} /*Resumed on the next poll*/
+
+				b->tx_map[w] &= b->tx_map[w] - 1U;
+				tx->frames++;
+			}
+		}
+
+		if ( b->blk_pend ) {
+
+			isca_fota_frame(&frame, tx->tx_id, tx->ide, 8U);
+			frame.DATA[0] = (uint8_t)blk;
+			frame.DATA[1] = FOTA_IDX_BLOCK;
+			isca_fota_put_be32(&frame.DATA[2], b->crc);
+			frame.DATA[6] = (uint8_t)(len >> 8);
+			frame.DATA[7] = (uint8_t)len;
+
+			if ( isca_can_transmit_frame(tx->can_ctrl, &frame, CAN_REQ_NONBLOCKING) != ISCA_CAN_OK ) {
+				return;
+			}
+
+			b->blk_pend = 0U;
+			b->deadline = now + FOTA_ACK_TMO_US;
+			tx->frames++;
+		}
+	}
+
+}
+
+/*Queue a response; dropped if the queue is full, the sender asks again*/
+static void isca_fota_rx_rsp(isca_fota_rx_s *rx, uint8_t op, uint32_t blk, uint8_t first, uint8_t count) {
+
+	can_frame_s *frame;
+
+	if ( (uint8_t)(rx->rsp_head - rx->rsp_tail) >= FOTA_RSP_QUEUE ) {
+		return;
+	}
+
+	frame = &rx->rsp[rx->rsp_head & (FOTA_RSP_QUEUE - 1U)];
+	isca_fota_frame(frame, rx->rx_id, rx->ide, (op == FOTA_RSP_NACK) ? 5U : (op == FOTA_RSP_ACK) ? 3U : 1U);
+	frame->DATA[0] = op;
+	frame->DATA[1] = (uint8_t)(blk >> 8);
+	frame->DATA[2] = (uint8_t)blk;
+	frame->DATA[3] = first;
+	frame->DATA[4] = count;
+	rx->rsp_head++;
+
+}
+
+/*Block frame: acknowledge a complete block with a matching CRC, ask for the
+ *missing frames otherwise*/
+static void isca_fota_rx_block(isca_fota_rx_s *rx, uint32_t blk, uint8_t const *d) {
+
+	uint32_t *map;
+	uint32_t len;
+	uint32_t n;
+	uint32_t i;
+	uint32_t first;
+	int missing = 0;
+
+	if ( (int32_t)(blk - rx->base) < 0 || (rx->state == FOTA_STREAM && blk - rx->base < FOTA_WINDOW &&
+	     (rx->done & (1UL << (blk - rx->base))) != 0U) ) {
+		isca_fota_rx_rsp(rx, FOTA_RSP_ACK, blk, 0U, 0U);
+		return;
+	} /*Received already; the acknowledgement was lost*/
+
+	if ( rx->state != FOTA_STREAM || blk - rx->base >= FOTA_WINDOW || blk >= rx->n_blk ) {
+		return;
+	}
+
+	map = rx->rx_map[blk & (FOTA_WINDOW - 1U)];
+	len = isca_fota_blk_len(rx->len, blk);
+	n   = (len + isca_fota_frame_data(rx->ide) - 1U) / isca_fota_frame_data(rx->ide);
+
+	for ( i = 0U; i < n; i++ ) {
+		if ( (map[i >> 5] & (1UL << (i & 31U))) == 0U ) {
+			first = i;
+			while ( i < n && (map[i >> 5] & (1UL << (i & 31U))) == 0U ) {
+				i++;
+			}
+			isca_fota_rx_rsp(rx, FOTA_RSP_NACK, blk, (uint8_t)first, (uint8_t)(i - first));
+			missing = 1;
+		}
+	} /*One request per run of missing frames*/
+
+	if ( missing ) {
+		return;
+	}
+
+	if ( ((((uint32_t)d[6] << 8) | d[7]) != len) ||
+	     isca_fota_crc32(0U, &rx->stage[(blk * FOTA_BLOCK_SIZE) % FOTA_STAGE_TOTAL], len) != isca_fota_be32(&d[2]) ) {
+		rx->crc_errors++;
+		memset(map, 0, FOTA_MAP_WORDS * sizeof(uint32_t));
+		isca_fota_rx_rsp(rx, FOTA_RSP_NACK, blk, 0U, (uint8_t)n);
+		return;
+	} /*Corrupted; the whole block again*/
+
+	rx->done |= (1UL << (blk - rx->base));
+
+	if ( isca_fota_rx_advance(rx) != ISCA_CAN_OK ) {
+		isca_fota_rx_rsp(rx, FOTA_RSP_ERROR, 0U, 0U, 0U);
+		return;
+	}
+
+	isca_fota_rx_rsp(rx, FOTA_RSP_ACK, blk, 0U, 0U);
+
+}
+
+/*Slide the window over the received blocks, flushing each staging buffer
+ *they complete*/
+static int isca_fota_rx_advance(isca_fota_rx_s *rx) {
+
+	uint32_t off;
+	uint32_t len;
+
+	while ( (rx->done & 1U) != 0U ) {
+
+		memset(rx->rx_map[rx->base & (FOTA_WINDOW - 1U)], 0, FOTA_MAP_WORDS * sizeof(uint32_t));
+		rx->done >>= 1;
+		rx->base++;
+
+		if ( (rx->base % FOTA_STAGE_BLOCKS) != 0U && rx->base != rx->n_blk ) {
+			continue;
+		}
+
+		off = ((rx->base - 1U) / FOTA_STAGE_BLOCKS) * FOTA_STAGE_SIZE;
+		len = (rx->len - off < FOTA_STAGE_SIZE) ? rx->len - off : FOTA_STAGE_SIZE;
+
+		if ( rx->flush(rx, off, &rx->stage[off % FOTA_STAGE_TOTAL], len) != 0 ) {
+			rx->state = FOTA_FAIL;
+			rx->res   = ISCA_FOTA_FLUSH;
+			return ISCA_FOTA_FLUSH;
+		}
+
+		if ( rx->base == rx->n_blk ) {
+			rx->state = FOTA_DONE;
+			rx->res   = ISCA_CAN_OK;
+		}
+	}
+
+	return ISCA_CAN_OK;
+}
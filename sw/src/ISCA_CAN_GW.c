@@ -0,0 +1,353 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN-to-CAN gateway
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_GW.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_GW.c
+ *
+ * @brief CAN-to-CAN gateway routing engine
+ *
+ * Frames received by an attached controller are routed in its interrupt
+ * bottom half, through the controller's RX hook, straight into the
+ * destination TX queues. Each destination queue is served by its own
+ * controller's TX hook, from that controller's bottom half, whenever its
+ * TX buffer is released; the application is not involved.
+ *
+ * Rules, (source, ID/mask) to (destination set, optional ID rewrite), are
+ * compiled once into direct lookups: a 2048 entry table per source for
+ * 11-bit IDs, resolved to the first matching rule, and a hash of exact
+ * 29-bit IDs. Masked 29-bit rules are the only ones searched, and only
+ * those listed before the exact hit, if any, so the first matching rule
+ * wins for either ID length.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note TX queues are not thread safe; run the bottom halves of the source
+ * and destination controllers from a single context, e.g., one
+ * \ref ISCA_CAN_MGR.h reactor managing all of them, with their TX
+ * interrupt enabled
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_GW.h"
+#include <string.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#if (GW_EXT_SLOTS & (GW_EXT_SLOTS - 1U)) != 0
+#error "GW_EXT_SLOTS must be a power of two"
+#endif
+
+#define GW_STD_IDS      (2048U)
+#define GW_EXT_MASK     (0x1FFFFFFFU)
+#define GW_HASH(id, s)  ((((id) ^ ((uint32_t)(s) << 29U)) * 0x9E3779B1U) >> 16U)
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static int  gw_ext_insert(isca_gw_s *gw, uint8_t src, uint32_t id, uint8_t rule);
+static int  gw_ext_lookup(isca_gw_s const *gw, uint8_t src, uint32_t id);
+static void gw_forward(isca_gw_s *gw, uint8_t rule, can_frame_s const *rx_frame, uint32_t rx_ts);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize a gateway without sources or rules, and take the
+ *             TX hook of each destination's controller over to serve its
+ *             TX queue, see \ref isca_txq_tx_hook
+ * @param[out] gw    Gateway
+ * @param[in]  dst   Destination TX queues, one per controller; bit n of a
+ *                   rule's destination set refers to dst[n]
+ * @param[in]  n_dst Amount of destination TX queues, up to \ref GW_MAX_DST
+ * @return     None
+ */
+void isca_gw_init(isca_gw_s *gw, isca_txq_s * const *dst, uint8_t n_dst) {
+
+	uint8_t d;
+
+	memset(gw, 0, sizeof(isca_gw_s));
+
+	gw->n_dst = (n_dst < GW_MAX_DST) ? n_dst : GW_MAX_DST;
+	memcpy(gw->dst, dst, gw->n_dst * sizeof(isca_txq_s *));
+
+	for ( d = 0U; d < gw->n_dst; d++ ) {
+		gw->dst[d]->can_ctrl->tx_hook_arg = gw->dst[d];
+		gw->dst[d]->can_ctrl->tx_hook     = &isca_txq_tx_hook;
+	} /*Queued frames leave as the TX buffer frees up*/
+
+}
+
+/**
+ * @brief      Route the frames received by a controller
+ * @param[in]  gw       Gateway
+ * @param[in]  can_ctrl Source controller, initialized with \ref lbr_isca_can_init
+ * @return     Source index, for \ref isca_gw_rule_s.src
+ * @return     \ref ISCA_GW_FULL
+ */
+int isca_gw_attach(isca_gw_s *gw, can_ctrl_s *can_ctrl) {
+
+	isca_gw_src_s *src;
+
+	if ( gw->n_src >= GW_MAX_SRC ) {
+		return ISCA_GW_FULL;
+	}
+
+	src = &gw->src[gw->n_src];
+	src->gw  = gw;
+	src->idx = gw->n_src;
+
+	can_ctrl->rx_hook_arg = src;
+	can_ctrl->rx_hook     = &isca_gw_rx;
+
+	return (int)gw->n_src++;
+}
+
+/**
+ * @brief      Compile routing rules into the lookup tables, replacing the
+ *             ones compiled before; statistics restart
+ * @param[in]  gw      Gateway
+ * @param[in]  rules   Rules, in priority order; kept by reference
+ * @param[in]  n_rules Amount of rules, up to \ref GW_MAX_RULES
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_GW_FULL
+ * @return     \ref ISCA_GW_INV_RULE
+ * @note       Not atomic against routing; compile with the sources stopped
+ */
+int isca_gw_compile(isca_gw_s *gw, isca_gw_rule_s const *rules, uint8_t n_rules) {
+
+	isca_gw_rule_s const *r;
+	uint32_t id;
+	uint32_t bad_dst = (gw->n_dst == 32U) ? 0U : ~0UL << gw->n_dst;
+	uint8_t  i;
+	uint8_t  s;
+
+	if ( n_rules > GW_MAX_RULES ) {
+		return ISCA_GW_FULL;
+	}
+
+	for ( i = 0U; i < n_rules; i++ ) {
+		if ( rules[i].src >= gw->n_src || (rules[i].dst_set & bad_dst) != 0U ) {
+			return ISCA_GW_INV_RULE;
+		}
+	} /*Validate*/
+
+	for ( s = 0U; s < gw->n_src; s++ ) {
+		memset(gw->src[s].std_map, 0, GW_STD_IDS);
+	}
+	memset(gw->ext, 0, sizeof(gw->ext));
+	memset(gw->stats, 0, sizeof(gw->stats));
+	gw->n_masked = 0U;
+	gw->n_rules  = 0U;
+	gw->rules    = rules;
+
+	for ( i = 0U; i < n_rules; i++ ) {
+
+		r = &rules[i];
+
+		if ( r->ide == CAN_FRAME_STD ) {
+			for ( id = 0U; id < GW_STD_IDS; id++ ) {
+				if ( gw->src[r->src].std_map[id] == 0U && ((id ^ r->id) & r->mask & 0x7FFU) == 0U ) {
+					gw->src[r->src].std_map[id] = (uint8_t)(i + 1U);
+				}
+			}
+		} /*11-bit: resolve every ID to its first matching rule*/
+		else if ( (r->mask & GW_EXT_MASK) == GW_EXT_MASK ) {
+			if ( gw_ext_insert(gw, r->src, r->id & GW_EXT_MASK, (uint8_t)(i + 1U)) != ISCA_CAN_OK ) {
+				return ISCA_GW_FULL;
+			}
+		} /*29-bit exact*/
+		else {
+			gw->ext_masked[gw->n_masked++] = i;
+		} /*29-bit masked*/
+	}
+
+	gw->n_rules = n_rules;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Controller RX hook installed by \ref isca_gw_attach; routes a
+ *             received frame
+ * @param[in]  can_ctrl Source controller
+ * @param[in]  rx_frame Received frame
+ * @param[in]  rx_ts    Arrival time, \ref ISCA_TIME_Us
+ * @param[in]  arg      Gateway source
+ * @return     1 if routed and consumed, 0 to queue it locally
+ */
+int isca_gw_rx(can_ctrl_s *can_ctrl, can_frame_s const *rx_frame, uint32_t rx_ts, void *arg) {
+
+	isca_gw_src_s *src = (isca_gw_src_s *)arg;
+	isca_gw_s *gw = src->gw;
+	int rule;
+
+	(void)can_ctrl;
+
+	if ( rx_frame->IDE == CAN_FRAME_EXT ) {
+
+		uint8_t k;
+
+		rule = gw_ext_lookup(gw, src->idx, rx_frame->ID & GW_EXT_MASK);
+
+		for ( k = 0U; k < gw->n_masked && (rule < 0 || gw->ext_masked[k] < rule); k++ ) {
+			if ( gw->rules[gw->ext_masked[k]].src == src->idx &&
+			     ((rx_frame->ID ^ gw->rules[gw->ext_masked[k]].id) & gw->rules[gw->ext_masked[k]].mask) == 0U ) {
+				rule = gw->ext_masked[k];
+				break;
+			}
+		} /*Masked 29-bit rules, in order, that precede the exact hit*/
+
+	}
+	else {
+		rule = (int)src->std_map[rx_frame->ID & 0x7FFU] - 1;
+	}
+
+	if ( rule < 0 ) {
+		return 0;
+	} /*Not routed*/
+
+	gw_forward(gw, (uint8_t)rule, rx_frame, rx_ts);
+
+	return ((gw->rules[rule].flags & GW_RULE_LOCAL) != 0U) ? 0 : 1;
+}
+
+/**
+ * @brief      Rule statistics
+ * @param[in]  gw    Gateway
+ * @param[in]  rule  Rule index
+ * @retval     Statistics, NULL for an unknown rule
+ */
+isca_gw_stats_s const *isca_gw_stats(isca_gw_s const *gw, uint8_t rule) {
+
+	return (rule < gw->n_rules) ? &gw->stats[rule] : NULL;
+
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Queue a routed frame to every destination of its rule*/
+static void gw_forward(isca_gw_s *gw, uint8_t rule, can_frame_s const *rx_frame, uint32_t rx_ts) {
+
+	isca_gw_rule_s const *r = &gw->rules[rule];
+	isca_gw_stats_s *st = &gw->stats[rule];
+	can_frame_s tx_frame;
+	can_frame_s const *out = rx_frame;
+	uint32_t dst_set = r->dst_set;
+	uint32_t lat;
+	uint8_t  d;
+
+	st->matched++;
+
+	if ( (r->flags & GW_RULE_REWRITE) != 0U ) {
+		tx_frame    = *rx_frame;
+		tx_frame.ID = r->new_id;
+		out = &tx_frame;
+	}
+
+	while ( dst_set != 0U ) {
+		d = (uint8_t)__builtin_ctz(dst_set);
+		dst_set &= dst_set - 1U;
+
+		if ( isca_txq_push(gw->dst[d], out) == ISCA_CAN_OK ) {
+			st->forwarded++;
+		}
+		else {
+			st->dropped++;
+		}
+	} /*Every destination*/
+
+	lat = ISCA_TIME_Us() - rx_ts;
+	st->lat_last = lat;
+	if ( lat > st->lat_max ) {
+		st->lat_max = lat;
+	}
+
+}
+
+/*Exact 29-bit ID hash, linear probing; the first rule for an ID wins*/
+static int gw_ext_insert(isca_gw_s *gw, uint8_t src, uint32_t id, uint8_t rule) {
+
+	uint32_t h = GW_HASH(id, src);
+	uint32_t k;
+	isca_gw_ext_s *e;
+
+	for ( k = 0U; k < GW_EXT_SLOTS; k++ ) {
+		e = &gw->ext[(h + k) & (GW_EXT_SLOTS - 1U)];
+		if ( e->rule == 0U ) {
+			e->id   = id;
+			e->src  = src;
+			e->rule = rule;
+			return ISCA_CAN_OK;
+		}
+		if ( e->id == id && e->src == src ) {
+			return ISCA_CAN_OK;
+		} /*Shadowed by an earlier rule*/
+	}
+
+	return ISCA_GW_FULL;
+}
+
+static int gw_ext_lookup(isca_gw_s const *gw, uint8_t src, uint32_t id) {
+
+	uint32_t h = GW_HASH(id, src);
+	uint32_t k;
+	isca_gw_ext_s const *e;
+
+	for ( k = 0U; k < GW_EXT_SLOTS; k++ ) {
+		e = &gw->ext[(h + k) & (GW_EXT_SLOTS - 1U)];
+		if ( e->rule == 0U ) {
+			break;
+		}
+		if ( e->id == id && e->src == src ) {
+			return (int)e->rule - 1;
+		}
+	}
+
+	return -1;
+}
@@ -48,6 +48,14 @@
  *
  * @version 1.0
  *
+ * The interrupt is split in two halves. The top half, \ref ISCA_CAN_IntrHandler,
+ * only latches the IRQ status, copies the RX buffer registers of the
+ * received frames into the controller's staging ring and acknowledges the
+ * IRQ. Decoding, queueing under the overflow policy, error recovery and the
+ * TX complete hook run in the bottom half, \ref isca_can_bh_run, from a
+ * deferred worker woken by \ref __BH_SCHEDULE, or from the receivers
+ * themselves.
+ *
  * @pre Fill the "USER CODE" sections with device
  *  specific code, as described
  */
@@ -57,33 +65,33 @@
  ******/
 #include "ISCA_CAN_API.h"
 #include "ISCA_QUEUE_INDEXER.h"
-#include <stdio.h>
+#include "ISCA_CAN_LOG.h"
+#include "ISCA_CAN_REGS.h"
 
 /******
  * DEFINITIONS
  ******/
-#define CAN_IRQS_STATUS_REG   (12U) /*!<IRQs status register offset*/
-#define CAN_IRQ_CLEAR         (04U) /*!<IRQs clear register offset*/
-
 /*
  * IRQ type <-> register active bit
  */
-#if (CAN_MODE == CAN_2B)
-#define BUS_ERROR        (0x80U)  /*!<CAN_IRQS_STATUS_REG[7] -> bus_error_irq_en*/
-#define ARB_LOST         (0x40U)  /*!<CAN_IRQS_STATUS_REG[6] -> arbitration_lost_irq_en*/
-#define ERR_P_IRQ        (0x20U)  /*!<CAN_IRQS_STATUS_REG[5] -> error_passive_irq_en*/
-#endif // (CAN_MODE == CAN_2B)
+#define BUS_ERROR        (0x80U)  /*!<CAN_IRQS_STATUS_REG[7] -> bus_error_irq_en, 2B mode*/
+#define ARB_LOST         (0x40U)  /*!<CAN_IRQS_STATUS_REG[6] -> arbitration_lost_irq_en, 2B mode*/
+#define ERR_P_IRQ        (0x20U)  /*!<CAN_IRQS_STATUS_REG[5] -> error_passive_irq_en, 2B mode*/
 #define DATA_OVRRUN      (0x08U)  /*!<CAN_IRQS_STATUS_REG[3] -> data_overrun_irq_en_ext*/
 #define ERR_WARN         (0x04U)  /*!<CAN_IRQS_STATUS_REG[2] -> error_warning_irq_en_ext*/
 #define TX_OK            (0x02U)  /*!<CAN_IRQS_STATUS_REG[1] -> transmit_irq_en_ext*/
 #define RX_OK            (0x01U)  /*!<CAN_IRQS_STATUS_REG[0] -> receive_irq_en_ext*/
 
+#define STAGE_MASK       (CAN_STAGE_ENTRIES - 1U)
+
 /******
  * PRIVATE FUNCTIONS DECLARATION
  ******/
-int  isca_can_receive_pkt_irq(can_ctrl_s *can_ctrl);
+static void isca_can_stage_rx(can_ctrl_s *can_ctrl);
+static uint32_t isca_can_bh_rx(can_ctrl_s *can_ctrl, uint32_t budget);
+static void isca_can_bh_errors(can_ctrl_s *can_ctrl, uint8_t latch);
 inline uint8_t isca_can_ack_irq_generic(can_ctrl_s *can_ctrl) __attribute__ ((always_inline));
-inline void isca_can_ack_irq_reboot(can_ctrl_s *can_ctrl) __attribute__ ((always_inline));
+static void isca_can_reboot(can_ctrl_s *can_ctrl);
 
 /******
  * FUNCTIONS DEFINITION
@@ -91,13 +99,16 @@ inline void isca_can_ack_irq_reboot(can_ctrl_s *can_ctrl) __attribute__ ((always
 /**
  * @pre        Fill the "USER CODE" sections with device
  *             specific code, as described
- * @brief      CAN controller interrupt callback
+ * @brief      CAN controller interrupt callback; the top half
  * @param[in]  can_ctrl CAN controllers instance pointer
  * @return     None
  * */
 void ISCA_CAN_IntrHandler(void *can_ctrl) {
 
 	uint8_t irq_rd;
+	uint8_t errs;
+	uint8_t tx_done;
+	uint32_t staged;
 	can_ctrl_s *can_ctrl_l;
 
 	/* USER CODE
@@ -112,36 +123,30 @@ void ISCA_CAN_IntrHandler(void *can_ctrl) {
 	/* Reading the IRQ status register*/
 	irq_rd = ISCA_FPGA_Read8Bit(can_ctrl_l->addr+CAN_IRQS_STATUS_REG);
 
-	/*Check read register's every bit*/
+	staged = can_ctrl_l->rx_stage.head;
 	if ( (irq_rd&RX_OK) == RX_OK ) {
-		isca_can_receive_pkt_irq(can_ctrl_l);
+		isca_can_stage_rx(can_ctrl_l);
 	} /*IRQ: RX*/
-	else if ( (irq_rd&TX_OK) == TX_OK ) {
-		isca_can_ack_irq_generic(can_ctrl_l);
-	} /*IRQ: TX*/
-	else if ( (irq_rd&ERR_WARN) == ERR_WARN ) {
-		__COUT("\n\rError IRQ!\n\r");
-		isca_can_ack_irq_reboot(can_ctrl_l);
-	} /*IRQ: Error*/
-	else if ( (irq_rd&DATA_OVRRUN) == DATA_OVRRUN ) {
-		__COUT("\n\rRX FIFO overrun IRQ!\n\r");
-		/*Maybe start reading some frames out of RX FIFO*/
-		isca_can_ack_irq_generic(can_ctrl_l);
-	} /*IRQ: RX FIFO IRQ*/
-#if (CAN_MODE == CAN_2B)
-	else if ( (irq_rd&ERR_P_IRQ) == ERR_P_IRQ ) {
-		__COUT("\n\rError passive IRQ!\n\r");
-		isca_can_ack_irq_reboot(can_ctrl_l);
-	} /*IRQ: Error passive IRQ*/
-	else if ( (irq_rd&ARB_LOST) == ARB_LOST ) {
-		__COUT("\n\rArbitration lost IRQ!\n\r");
-		isca_can_ack_irq_reboot(can_ctrl_l);
-	} /*IRQ: Arbitration lost*/
-	else if ( (irq_rd&BUS_ERROR) == BUS_ERROR ) {
-		__COUT("\n\rBus error IRQ!\n\r");
-		isca_can_ack_irq_reboot(can_ctrl_l);
-	} /*IRQ: Bus error*/
-#endif // !(CAN_MODE == CAN_2A)
+
+	errs = (uint8_t)(irq_rd & ~(RX_OK|TX_OK));
+	if ( errs != 0U ) {
+		__atomic_fetch_or(&can_ctrl_l->irq_latch, errs, __ATOMIC_RELEASE);
+	} /*IRQ: Error, RX FIFO overrun; recovered by the bottom half*/
+
+	tx_done = (uint8_t)((can_ctrl_l->tx_hook != NULL) ? (irq_rd & TX_OK) : 0U);
+	if ( tx_done != 0U ) {
+		__atomic_fetch_or(&can_ctrl_l->irq_latch, tx_done, __ATOMIC_RELEASE);
+	} /*IRQ: TX; the bottom half runs the TX hook*/
+
+	/*Acknowledge the interrupt*/
+	isca_can_ack_irq_generic(can_ctrl_l);
+
+	if ( staged != can_ctrl_l->rx_stage.head || errs != 0U || tx_done != 0U ) {
+		if ( staged == __atomic_load_n(&can_ctrl_l->rx_stage.tail, __ATOMIC_ACQUIRE) || errs != 0U ) {
+			isca_wait_signal(&can_ctrl_l->rx_wait);
+		} /*Staging ring turned non-empty, or an error to recover; wake the receivers*/
+		__BH_SCHEDULE(can_ctrl_l);
+	} /*Bottom half work pending*/
 
 	/* USER CODE
 	 * Place code to apply the proper negotiations with the Interrupt controller
@@ -152,44 +157,192 @@ void ISCA_CAN_IntrHandler(void *can_ctrl) {
 
 }
 
+/**
+ * @brief      Interrupt bottom half: recover from latched errors, run the
+ *             TX hook after a transmit IRQ, decode the staged frames into
+ *             the RX queue under its overflow policy and resume the RX IRQ
+ *             if the staging ring had filled up
+ *
+ * Call from the deferred worker woken by \ref __BH_SCHEDULE; the receive
+ * functions of \ref ISCA_CAN_API.h call it as well, so a worker is optional.
+ * Concurrent calls are skipped, not serialised.
+ * @param[in]  can_ctrl CAN controllers instance pointer
+ * @param[in]  budget   Most staged frames to handle
+ * @return     Amount of staged frames handled, queued or dropped
+ * */
+uint32_t isca_can_bh_run(can_ctrl_s *can_ctrl, uint32_t budget) {
+
+	can_stage_s *stage = &can_ctrl->rx_stage;
+	uint32_t done;
+	uint8_t  latch;
+
+	if ( __atomic_test_and_set(&can_ctrl->bh_busy, __ATOMIC_ACQUIRE) ) {
+		return 0U;
+	} /*Already running*/
+
+	latch = __atomic_exchange_n(&can_ctrl->irq_latch, 0U, __ATOMIC_ACQ_REL);
+	if ( (latch & ~TX_OK) != 0U ) {
+		isca_can_bh_errors(can_ctrl, (uint8_t)(latch & ~TX_OK));
+	}
+
+	if ( (latch & TX_OK) != 0U && can_ctrl->tx_hook != NULL ) {
+		can_ctrl->tx_hook(can_ctrl, can_ctrl->tx_hook_arg);
+	} /*TX buffer released*/
+
+	done = isca_can_bh_rx(can_ctrl, budget);
+
+	if ( can_ctrl->rx_blocked && stage->head - stage->tail < CAN_STAGE_ENTRIES ) {
+		/*The RX IRQ is masked, so the top half is not a producer now*/
+		can_ctrl->rx_blocked = 0U;
+		isca_can_stage_rx(can_ctrl);
+		if ( !can_ctrl->rx_blocked ) {
+			isca_can_rx_irq_enable(can_ctrl, CAN_IRQ_ON);
+		}
+	} /*Resume the RX FIFO held back by a full staging ring*/
+
+	__atomic_clear(&can_ctrl->bh_busy, __ATOMIC_RELEASE);
+
+	return done;
+
+}
+
 /******
  * PRIVATE FUNCTIONS IMPLEMENTATION
  ******/
 
-/*RX interrupt routine*/
-int isca_can_receive_pkt_irq(can_ctrl_s *can_ctrl) {
+/*Top half RX: copy the RX FIFO frames, undecoded, into the staging ring;
+ *a full ring leaves them in the RX FIFO and masks the RX IRQ until the
+ *bottom half catches up*/
+static void isca_can_stage_rx(can_ctrl_s *can_ctrl) {
 
-	volatile uint8_t _ack;
-	uint8_t _cpy;
-	int remain_packets;
+	can_stage_s *stage = &can_ctrl->rx_stage;
+	uint32_t head = stage->head;
+	int remain = 1; /*Unknown until the first read*/
+
+	while ( remain > 0 ) {
+
+		if ( head - __atomic_load_n(&stage->tail, __ATOMIC_ACQUIRE) >= CAN_STAGE_ENTRIES ) {
+			can_ctrl->rx_blocked = 1U;
+			isca_can_rx_irq_enable(can_ctrl, CAN_IRQ_OFF);
+			__LOG_INFO(LOG_EV_RX_BLOCKED, remain, can_ctrl->addr);
+			break;
+		} /*Staging ring full*/
+
+		remain = isca_can_read_raw(can_ctrl, &stage->raw[head & STAGE_MASK]);
+		if ( remain == ISCA_CAN_RX_FIFO_EMPTY ) {
+			break;
+		}
+		stage->ts[head & STAGE_MASK] = ISCA_TIME_Us();
+		head++;
+	}
+
+	__atomic_store_n(&stage->head, head, __ATOMIC_RELEASE);
+
+}
+
+/*Bottom half RX: decode up to budget staged frames, offer each to the RX
+ *hook and move the rest straight into reserved queue slots, published at
+ *once; a full queue applies its overflow policy, a DQ_BLOCK queue leaves
+ *the frames staged*/
+static uint32_t isca_can_bh_rx(can_ctrl_s *can_ctrl, uint32_t budget) {
+
+	can_stage_s *stage = &can_ctrl->rx_stage;
+	isca_qspan_s span;
 	can_frame_s rx_frame;
-	uint8_t queue_wr_index;
+	uint32_t tail = stage->tail;
+	uint32_t staged;
+	uint32_t granted;
+	uint32_t n;
+	uint32_t got = 0U;
+	uint32_t dropped = 0U;
+	uint32_t slot;
 
-	int q_status;
+	staged = __atomic_load_n(&stage->head, __ATOMIC_ACQUIRE) - tail;
+	if ( budget > staged ) {
+		budget = staged;
+	}
 
-	/*Receive frame, this also releases the RX buffer*/
-	remain_packets = isca_can_receive_frame(can_ctrl, &rx_frame, CAN_REQ_NONBLOCKING);
+	if ( budget == 0U ) {
+		return 0U;
+	} /*Nothing staged*/
 
-	/*Acknowledge the interrupt*/
-	_ack = ISCA_FPGA_Read8Bit(can_ctrl->addr+CAN_IRQ_CLEAR);
-	/*prevent the compiler from removing the above line; the dummy way*/
-	memmove(&_cpy, (void *)&_ack, sizeof(uint8_t));
+	granted = isca_queue_reserve_n(can_ctrl->q_id, budget, &span);
+
+	for ( n = 0U; n < budget; n++ ) {
+
+		if ( got == granted && can_ctrl->q_policy == DQ_BLOCK ) {
+			break;
+		} /*Queue full; leave the rest staged*/
+
+		isca_can_decode_raw(can_ctrl, &stage->raw[(tail + n) & STAGE_MASK], &rx_frame);
+
+		if ( can_ctrl->rx_hook != NULL &&
+		     can_ctrl->rx_hook(can_ctrl, &rx_frame, stage->ts[(tail + n) & STAGE_MASK],
+		                       can_ctrl->rx_hook_arg) ) {
+			continue;
+		} /*Consumed by the hook, e.g., routed*/
+
+		if ( got == granted ) {
+			dropped++;
+			continue;
+		} /*Queue full; counted as dropped*/
 
-	if (remain_packets==ISCA_CAN_RX_FIFO_EMPTY) return 0;
+		slot = (got < span.len[0]) ? span.idx[0] + got : span.idx[1] + (got - span.len[0]);
+		isca_can_frame_pack(&can_ctrl->q_ptr[slot], &rx_frame);
+		got++;
+	}
 
-	/*Ask the queue for write pointer*/
-	q_status = isca_queue_wr_ptr(can_ctrl->q_id, &queue_wr_index);
+	if ( got != 0U ) {
+		isca_queue_commit_n(can_ctrl->q_id, got);
 
-	//if ( __builtin_expect(q_status==DQ_FULL, 0) ) {
-	if ( q_status==DQ_FULL ) {
-		__COUT("\n\rCan queue full, frame rejected");
-		return remain_packets;
-	} /*Queue is full*/
+		/*Wake the readers up on the empty to non-empty transition only*/
+		if ( isca_queue_count(can_ctrl->q_id) == got ) {
+			isca_wait_signal(&can_ctrl->rx_wait);
+		}
+	} /*Publish the burst*/
 
-	/*Write frame to the queue*/
-	memmove(&can_ctrl->q_ptr[queue_wr_index], &rx_frame, sizeof(can_frame_s));
+	if ( dropped != 0U ) {
+		isca_queue_drop_n(can_ctrl->q_id, dropped);
+		__LOG_WARN(LOG_EV_RX_DROP, dropped, can_ctrl->addr);
+	}
 
-	return remain_packets;
+	__atomic_store_n(&stage->tail, tail + n, __ATOMIC_RELEASE);
+
+	return n;
+
+}
+
+/*Bottom half errors: report and recover from the latched error IRQs*/
+static void isca_can_bh_errors(can_ctrl_s *can_ctrl, uint8_t latch) {
+
+	uint8_t reboot = 0U;
+
+	if ( (latch&ERR_WARN) == ERR_WARN ) {
+		__LOG_ERROR(LOG_EV_ERR_WARN, latch, can_ctrl->addr);
+		reboot = 1U;
+	} /*IRQ: Error*/
+	if ( (latch&DATA_OVRRUN) == DATA_OVRRUN ) {
+		__LOG_WARN(LOG_EV_RX_OVERRUN, latch, can_ctrl->addr);
+	} /*IRQ: RX FIFO overrun; the next RX buffer read clears it*/
+	if ( can_ctrl->can_mode != CAN_2B ) {
+		latch &= (uint8_t)~(BUS_ERROR | ARB_LOST | ERR_P_IRQ);
+	} /*Reserved status bits in 2A mode*/
+	if ( (latch&ERR_P_IRQ) == ERR_P_IRQ ) {
+		__LOG_ERROR(LOG_EV_ERR_PASSIVE, latch, can_ctrl->addr);
+		reboot = 1U;
+	} /*IRQ: Error passive IRQ*/
+	if ( (latch&ARB_LOST) == ARB_LOST ) {
+		__LOG_WARN(LOG_EV_ARB_LOST, latch, can_ctrl->addr);
+		reboot = 1U;
+	} /*IRQ: Arbitration lost*/
+	if ( (latch&BUS_ERROR) == BUS_ERROR ) {
+		__LOG_ERROR(LOG_EV_BUS_ERROR, latch, can_ctrl->addr);
+		reboot = 1U;
+	} /*IRQ: Bus error*/
+
+	if ( reboot ) {
+		isca_can_reboot(can_ctrl);
+	}
 
 }
 
@@ -205,14 +358,11 @@ uint8_t isca_can_ack_irq_generic(can_ctrl_s *can_ctrl) {
 
 }
 
-/*Errors interrupt routine*/
+/*Errors recovery routine*/
 /*!<@pre Fill the "USER CODE" sections with device
  * specific code, as described
  */
-void isca_can_ack_irq_reboot(can_ctrl_s *can_ctrl) {
-
-	// acknowledge IRQ.
-	isca_can_ack_irq_generic(can_ctrl);
+static void isca_can_reboot(can_ctrl_s *can_ctrl) {
 
 	// Soft reset CAN controller
 	isca_can_switch_mode(can_ctrl, ISCA_CAN_MODE_RESET_ON);
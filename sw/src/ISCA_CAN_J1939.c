@@ -0,0 +1,711 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN J1939 transport protocol
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_J1939.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_J1939.c
+ *
+ * @brief SAE J1939 addressing and transport protocol, BAM and RTS/CTS
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note A node owns its controller's RX queue when polled; feed frames with
+ * \ref isca_j1939_input instead to share the controller. Not thread safe,
+ * like the frame pool it allocates from.
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_J1939.h"
+#include "ISCA_CAN_API.h"
+#include "ISCA_FRAME_POOL.h"
+
+/******
+ * DEFINITIONS
+ ******/
+/*-----
+ * TP.CM CONTROL BYTES
+ *----*/
+#define J1939_CM_RTS          (16U)  /*!<Request to send*/
+#define J1939_CM_CTS          (17U)  /*!<Clear to send*/
+#define J1939_CM_EOMA         (19U)  /*!<End of message acknowledge*/
+#define J1939_CM_BAM          (32U)  /*!<Broadcast announce message*/
+#define J1939_CM_ABORT        (255U) /*!<Connection abort*/
+
+/*-----
+ * TP.CM ABORT REASONS
+ *----*/
+#define J1939_AB_BUSY         (1U)   /*!<Already in a session with this node*/
+#define J1939_AB_RESOURCES    (2U)   /*!<No resources*/
+#define J1939_AB_TIMEOUT      (3U)   /*!<Timeout*/
+#define J1939_AB_CTS          (4U)   /*!<CTS while transferring data*/
+#define J1939_AB_SEQ          (7U)   /*!<Bad sequence number*/
+
+/*-----
+ * SESSION STATES
+ *----*/
+#define J_FREE                (0U)   /*!<Unused*/
+#define J_RX_BAM              (1U)   /*!<Receiving a broadcast*/
+#define J_RX_RTS              (2U)   /*!<Receiving a connection mode message*/
+#define J_RX_EOMA             (3U)   /*!<Received; acknowledging*/
+#define J_TX_BAM              (4U)   /*!<Broadcasting*/
+#define J_TX_RTS              (5U)   /*!<Waiting for CTS*/
+#define J_TX_DT               (6U)   /*!<Sending the CTS window*/
+#define J_TX_EOMA             (7U)   /*!<Waiting for the end of message acknowledge*/
+#define J_CLOSE               (8U)   /*!<Aborting*/
+
+/*-----
+ * CONTROL FRAMES TO SEND
+ *----*/
+#define J_PEND_NONE           (0U)
+#define J_PEND_CTS            (1U)
+#define J_PEND_EOMA           (2U)
+#define J_PEND_ABORT          (3U)
+#define J_PEND_RTS            (4U)
+#define J_PEND_BAM            (5U)
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static uint32_t isca_j1939_hash(uint8_t sa, uint8_t da);
+static isca_j1939_sess_s *isca_j1939_find(isca_j1939_s *j, uint8_t sa, uint8_t da);
+static isca_j1939_sess_s *isca_j1939_open(isca_j1939_s *j, uint8_t sa, uint8_t da);
+static void isca_j1939_free(isca_j1939_s *j, isca_j1939_sess_s *s);
+static void isca_j1939_close(isca_j1939_s *j, isca_j1939_sess_s *s, int res);
+static void isca_j1939_abort(isca_j1939_s *j, isca_j1939_sess_s *s, uint8_t reason, int res);
+static int isca_j1939_cm(isca_j1939_s *j, uint8_t da, uint8_t ctrl, uint8_t b1, uint8_t b2, uint8_t b3,
+                         uint8_t b4, uint32_t pgn);
+static int isca_j1939_rx_open(isca_j1939_s *j, uint8_t sa, uint8_t da, uint8_t const *d, uint32_t now);
+static void isca_j1939_cm_input(isca_j1939_s *j, uint8_t sa, uint8_t da, uint8_t const *d, uint32_t now);
+static void isca_j1939_dt_input(isca_j1939_s *j, uint8_t sa, uint8_t da, uint8_t const *d, uint32_t now);
+static void isca_j1939_service(isca_j1939_s *j, isca_j1939_sess_s *s, uint32_t now);
+static int isca_j1939_send_pend(isca_j1939_s *j, isca_j1939_sess_s *s, uint32_t now);
+static int isca_j1939_send_dt(isca_j1939_s *j, isca_j1939_sess_s *s);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize a node with every session free
+ * @param[out] j         Node
+ * @param[in]  can_ctrl  2B controller, initialized with \ref lbr_isca_can_init
+ * @param[in]  addr      Own source address
+ * @param[in]  rx_cb     Message received callback, NULL if none
+ * @param[in]  tx_cb     Transport message sent callback, NULL if none
+ * @param[in]  arg       Caller context
+ * @return     None
+ */
+void isca_j1939_init(isca_j1939_s *j, can_ctrl_s *can_ctrl, uint8_t addr,
+                     isca_j1939_rx_t rx_cb, isca_j1939_tx_t tx_cb, void *arg) {
+
+	uint32_t i;
+
+	memset(j, 0, sizeof(isca_j1939_s));
+	j->can_ctrl = can_ctrl;
+	j->addr     = addr;
+	j->rx_cb    = rx_cb;
+	j->tx_cb    = tx_cb;
+	j->arg      = arg;
+
+	for ( i = J1939_MAX_SESS; i-- != 0U; ) {
+		j->sess[i].next = j->free;
+		j->free = &j->sess[i];
+	}
+
+}
+
+/**
+ * @brief      Send a message: a single frame up to 8 bytes, else a BAM
+ *             (da \ref J1939_GLOBAL) or RTS/CTS transport session carried
+ *             out by \ref isca_j1939_poll
+ * @param[in]  j     Node
+ * @param[in]  prio  Priority, 0 (highest) to 7
+ * @param[in]  pgn   Parameter group number
+ * @param[in]  da    Destination address
+ * @param[in]  data  Message; of a transport session, kept by the caller
+ *                   until the transport message sent callback
+ * @param[in]  len   Message length, up to \ref J1939_MAX_SIZE
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_CAN_BUSY, single frame: TX buffer occupied
+ * @return     \ref ISCA_J1939_BUSY, \ref ISCA_J1939_FULL
+ * @return     \ref ISCA_CAN_INV_PARAM
+ */
+int isca_j1939_send(isca_j1939_s *j, uint8_t prio, uint32_t pgn, uint8_t da, uint8_t const *data, uint32_t len) {
+
+	isca_j1939_sess_s *s;
+	can_frame_s frame;
+
+	if ( len > J1939_MAX_SIZE ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	if ( len <= 8U ) {
+		frame.ID  = isca_j1939_id(prio, pgn, j->addr, da);
+		frame.IDE = CAN_FRAME_EXT;
+		frame.RTR = 0U;
+		frame.DLC = (uint16_t)len;
+		memcpy(frame.DATA, data, len);
+		return isca_can_transmit_frame(j->can_ctrl, &frame, CAN_REQ_NONBLOCKING);
+	} /*Single frame*/
+
+	if ( isca_j1939_find(j, j->addr, da) != NULL ) {
+		return ISCA_J1939_BUSY;
+	}
+
+	s = isca_j1939_open(j, j->addr, da);
+	if ( s == NULL ) {
+		j->no_mem++;
+		return ISCA_J1939_FULL;
+	}
+
+	s->pgn     = pgn & 0x3FFFFU;
+	s->data    = data;
+	s->size    = (uint16_t)len;
+	s->packets = (uint8_t)((len + 6U) / 7U);
+	s->prio    = prio;
+	s->seq     = 1U;
+	s->state   = (da == J1939_GLOBAL) ? J_TX_BAM : J_TX_RTS;
+	s->pend    = (da == J1939_GLOBAL) ? J_PEND_BAM : J_PEND_RTS;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Process a received frame: single frame messages are handed to
+ *             the callback, transport frames to their session
+ * @param[in]  j         Node
+ * @param[in]  rx_frame  Frame; other nodes' and 11-bit frames are ignored
+ * @return     None
+ */
+void isca_j1939_input(isca_j1939_s *j, can_frame_s const *rx_frame) {
+
+	uint32_t pgn;
+	uint8_t  sa;
+	uint8_t  da;
+
+	if ( rx_frame->IDE != CAN_FRAME_EXT || rx_frame->RTR != 0U ) {
+		return;
+	}
+
+	pgn = isca_j1939_pgn(rx_frame->ID);
+	sa  = isca_j1939_sa(rx_frame->ID);
+	da  = isca_j1939_da(rx_frame->ID);
+
+	if ( sa == j->addr || (da != j->addr && da != J1939_GLOBAL) ) {
+		return;
+	}
+
+	if ( pgn == J1939_PGN_TP_CM ) {
+		if ( rx_frame->DLC == 8U ) {
+			isca_j1939_cm_input(j, sa, da, rx_frame->DATA, ISCA_TIME_Us());
+		}
+	}
+	else if ( pgn == J1939_PGN_TP_DT ) {
+		if ( rx_frame->DLC == 8U ) {
+			isca_j1939_dt_input(j, sa, da, rx_frame->DATA, ISCA_TIME_Us());
+		}
+	}
+	else if ( j->rx_cb != NULL ) {
+		j->rx_cb(j, pgn, sa, da, rx_frame->DATA, rx_frame->DLC);
+	}
+
+}
+
+/**
+ * @brief      Receive up to budget frames, then move every session on:
+ *             control frames, data packets and timeouts
+ * @param[in]  j       Node
+ * @param[in]  budget  Most frames received
+ * @return     Amount of frames received
+ */
+uint32_t isca_j1939_poll(isca_j1939_s *j, uint32_t budget) {
+
+	can_frame_s rx_frame;
+	uint32_t n;
+	uint32_t now;
+	uint32_t i;
+
+	for ( n = 0U; n < budget; n++ ) {
+		if ( lbr_isca_can_receive_pkt_tmo(j->can_ctrl, &rx_frame, 0U) < 0 ) {
+			break;
+		} /*Drained*/
+		isca_j1939_input(j, &rx_frame);
+	}
+
+	now = ISCA_TIME_Us();
+	for ( i = 0U; i < J1939_MAX_SESS; i++ ) {
+		if ( j->sess[i].state != J_FREE ) {
+			isca_j1939_service(j, &j->sess[i], now);
+		}
+	}
+
+	return n;
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Session lookup slot of an address pair*/
+static uint32_t isca_j1939_hash(uint8_t sa, uint8_t da) {
+
+	return ((uint32_t)sa * 37U + da) & (J1939_HASH_SLOTS - 1U);
+
+}
+
+static isca_j1939_sess_s *isca_j1939_find(isca_j1939_s *j, uint8_t sa, uint8_t da) {
+
+	isca_j1939_sess_s *s = j->hash[isca_j1939_hash(sa, da)];
+
+	while ( s != NULL && (s->sa != sa || s->da != da) ) {
+		s = s->next;
+	}
+
+	return s;
+}
+
+/*Take a free session and link it in*/
+static isca_j1939_sess_s *isca_j1939_open(isca_j1939_s *j, uint8_t sa, uint8_t da) {
+
+	isca_j1939_sess_s *s = j->free;
+	uint32_t h = isca_j1939_hash(sa, da);
+
+	if ( s == NULL ) {
+		return NULL;
+	}
+
+	j->free = s->next;
+	memset(s, 0, sizeof(isca_j1939_sess_s));
+	s->sa   = sa;
+	s->da   = da;
+	s->next = j->hash[h];
+	j->hash[h] = s;
+
+	return s;
+}
+
+/*Unlink a session, release its buffer and return it to the free list*/
+static void isca_j1939_free(isca_j1939_s *j, isca_j1939_sess_s *s) {
+
+	isca_j1939_sess_s **p = &j->hash[isca_j1939_hash(s->sa, s->da)];
+
+	while ( *p != s ) {
+		p = &(*p)->next;
+	}
+	*p = s->next;
+
+	isca_frame_pool_free((can_cframe_s *)(void *)s->buf);
+	s->buf   = NULL;
+	s->state = J_FREE;
+	s->next  = j->free;
+	j->free  = s;
+
+}
+
+/*End a session; the sender is told the result*/
+static void isca_j1939_close(isca_j1939_s *j, isca_j1939_sess_s *s, int res) {
+
+	uint32_t pgn = s->pgn;
+	uint8_t  da  = s->da;
+	uint8_t  tx  = (s->sa == j->addr);
+
+	if ( res != ISCA_CAN_OK ) {
+		j->aborts++;
+	}
+
+	isca_j1939_free(j, s);
+
+	if ( tx && j->tx_cb != NULL ) {
+		j->tx_cb(j, pgn, da, res);
+	} /*After the release; the callback may send again*/
+
+}
+
+/*Abort a session: connection mode peers get an abort frame first*/
+static void isca_j1939_abort(isca_j1939_s *j, isca_j1939_sess_s *s, uint8_t reason, int res) {
+
+	if ( s->da == J1939_GLOBAL ) {
+		isca_j1939_close(j, s, res);
+		return;
+	}
+
+	j->aborts++;
+
+	if ( s->sa == j->addr && j->tx_cb != NULL ) {
+		j->tx_cb(j, s->pgn, s->da, res);
+	}
+
+	isca_frame_pool_free((can_cframe_s *)(void *)s->buf);
+	s->buf    = NULL;
+	s->reason = reason;
+	s->pend   = J_PEND_ABORT;
+	s->state  = J_CLOSE;
+
+}
+
+/*Send a TP.CM frame*/
+static int isca_j1939_cm(isca_j1939_s *j, uint8_t da, uint8_t ctrl, uint8_t b1, uint8_t b2, uint8_t b3,
+                         uint8_t b4, uint32_t pgn) {
+
+	can_frame_s frame;
+
+	frame.ID  = isca_j1939_id(J1939_PRIO_TP, J1939_PGN_TP_CM, j->addr, da);
+	frame.IDE = CAN_FRAME_EXT;
+	frame.RTR = 0U;
+	frame.DLC = 8U;
+	frame.DATA[0] = ctrl;
+	frame.DATA[1] = b1;
+	frame.DATA[2] = b2;
+	frame.DATA[3] = b3;
+	frame.DATA[4] = b4;
+	frame.DATA[5] = (uint8_t)pgn;
+	frame.DATA[6] = (uint8_t)(pgn >> 8);
+	frame.DATA[7] = (uint8_t)(pgn >> 16);
+
+	return isca_can_transmit_frame(j->can_ctrl, &frame, CAN_REQ_NONBLOCKING);
+}
+
+/*BAM or RTS: open a receiving session with its reassembly buffer; a
+ *session of the same pair is replaced*/
+static int isca_j1939_rx_open(isca_j1939_s *j, uint8_t sa, uint8_t da, uint8_t const *d, uint32_t now) {
+
+	isca_j1939_sess_s *s;
+	uint32_t size = (uint32_t)d[1] | ((uint32_t)d[2] << 8);
+
+	if ( size <= 8U || size > J1939_MAX_SIZE || d[3] != (size + 6U) / 7U ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	s = isca_j1939_find(j, sa, da);
+	if ( s != NULL ) {
+		isca_j1939_close(j, s, ISCA_J1939_ABORTED);
+	}
+
+	s = isca_j1939_open(j, sa, da);
+	if ( s == NULL ) {
+		j->no_mem++;
+		return ISCA_J1939_FULL;
+	}
+
+	s->buf = (uint8_t *)isca_frame_pool_alloc((size + sizeof(can_cframe_s) - 1U) / sizeof(can_cframe_s));
+	if ( s->buf == NULL ) {
+		isca_j1939_free(j, s);
+		j->no_mem++;
+		return ISCA_CAN_NO_MEMORY;
+	}
+
+	s->pgn      = (uint32_t)d[5] | ((uint32_t)d[6] << 8) | ((uint32_t)d[7] << 16);
+	s->size     = (uint16_t)size;
+	s->packets  = d[3];
+	s->max_cts  = d[4];
+	s->seq      = 1U;
+	s->deadline = now + J1939_T1_US;
+	s->state    = (da == J1939_GLOBAL) ? J_RX_BAM : J_RX_RTS;
+	s->pend     = (da == J1939_GLOBAL) ? J_PEND_NONE : J_PEND_CTS;
+
+	return ISCA_CAN_OK;
+}
+
+/*TP.CM frames*/
+static void isca_j1939_cm_input(isca_j1939_s *j, uint8_t sa, uint8_t da, uint8_t const *d, uint32_t now) {
+
+	isca_j1939_sess_s *s;
+	uint32_t pgn = (uint32_t)d[5] | ((uint32_t)d[6] << 8) | ((uint32_t)d[7] << 16);
+	uint32_t last;
+	int ret;
+
+	if ( d[0] == J1939_CM_BAM ) {
+		if ( da == J1939_GLOBAL ) {
+			(void)isca_j1939_rx_open(j, sa, da, d, now);
+		}
+		return;
+	}
+
+	if ( da != j->addr ) {
+		return;
+	} /*Connection mode frames are addressed*/
+
+	switch ( d[0] ) {
+
+	case J1939_CM_RTS:
+		ret = isca_j1939_rx_open(j, sa, da, d, now);
+		if ( ret == ISCA_J1939_FULL || ret == ISCA_CAN_NO_MEMORY ) {
+			(void)isca_j1939_cm(j, sa, J1939_CM_ABORT, J1939_AB_RESOURCES, 0xFFU, 0xFFU, 0xFFU, pgn);
+		} /*Best effort; the sender times out otherwise*/
+		break;
+
+	case J1939_CM_CTS:
+		s = isca_j1939_find(j, j->addr, sa);
+		if ( s == NULL || s->pgn != pgn ) {
+			break;
+		}
+		if ( s->state == J_TX_DT ) {
+			isca_j1939_abort(j, s, J1939_AB_CTS, ISCA_J1939_ABORTED);
+			break;
+		}
+		if ( s->state != J_TX_RTS || s->pend != J_PEND_NONE ) {
+			break;
+		}
+		if ( d[1] == 0U ) {
+			s->deadline = now + J1939_T4_US;
+			break;
+		} /*Hold the connection open*/
+		if ( d[2] == 0U || d[2] > s->packets ) {
+			break;
+		}
+		last = (uint32_t)d[2] + d[1] - 1U;
+		s->seq   = d[2];
+		s->last  = (uint16_t)((last < s->packets) ? last : s->packets);
+		s->state = J_TX_DT;
+		break;
+
+	case J1939_CM_EOMA:
+		s = isca_j1939_find(j, j->addr, sa);
+		if ( s != NULL && s->state == J_TX_EOMA && s->pgn == pgn ) {
+			isca_j1939_close(j, s, ISCA_CAN_OK);
+		}
+		break;
+
+	case J1939_CM_ABORT:
+		s = isca_j1939_find(j, j->addr, sa);
+		if ( s != NULL && s->pgn == pgn && s->state != J_CLOSE ) {
+			isca_j1939_close(j, s, ISCA_J1939_ABORTED);
+		} /*Sending*/
+		s = isca_j1939_find(j, sa, j->addr);
+		if ( s != NULL && s->pgn == pgn ) {
+			isca_j1939_close(j, s, ISCA_J1939_ABORTED);
+		} /*Receiving*/
+		break;
+
+	default:
+		break;
+	}
+
+}
+
+/*TP.DT frames: reassemble straight into the session buffer*/
+static void isca_j1939_dt_input(isca_j1939_s *j, uint8_t sa, uint8_t da, uint8_t const *d, uint32_t now) {
+
+	isca_j1939_sess_s *s = isca_j1939_find(j, sa, da);
+	uint32_t off;
+	uint32_t n;
+
+	if ( s == NULL || (s->state != J_RX_BAM && s->state != J_RX_RTS) ) {
+		return;
+	}
+
+	if ( d[0] != s->seq ) {
+		isca_j1939_abort(j, s, J1939_AB_SEQ, ISCA_J1939_ABORTED);
+		return;
+	}
+
+	off = (uint32_t)(s->seq - 1U) * 7U;
+	n   = s->size - off;
+	if ( n > 7U ) {
+		n = 7U;
+	}
+
+	memcpy(&s->buf[off], &d[1], n);
+	s->seq++;
+	s->deadline = now + J1939_T1_US;
+
+	if ( off + n == s->size ) {
+
+		if ( j->rx_cb != NULL ) {
+			j->rx_cb(j, s->pgn, sa, da, s->buf, s->size);
+		}
+
+		if ( s->state == J_RX_BAM ) {
+			isca_j1939_close(j, s, ISCA_CAN_OK);
+			return;
+		}
+
+		isca_frame_pool_free((can_cframe_s *)(void *)s->buf);
+		s->buf   = NULL;
+		s->state = J_RX_EOMA;
+		s->pend  = J_PEND_EOMA;
+	} /*Complete*/
+	else if ( s->state == J_RX_RTS && s->seq > s->last ) {
+		s->pend = J_PEND_CTS;
+	} /*Window complete*/
+
+}
+
+/*Pending control frame, data packets and timeouts of a session*/
+static void isca_j1939_service(isca_j1939_s *j, isca_j1939_sess_s *s, uint32_t now) {
+
+	if ( s->pend != J_PEND_NONE && isca_j1939_send_pend(j, s, now) != ISCA_CAN_OK ) {
+		return;
+	} /*Retried on the next poll*/
+
+	switch ( s->state ) {
+
+	case J_TX_BAM:
+		if ( (int32_t)(now - s->deadline) >= 0 && isca_j1939_send_dt(j, s) == ISCA_CAN_OK ) {
+			if ( s->seq > s->packets ) {
+				isca_j1939_close(j, s, ISCA_CAN_OK);
+			}
+			else {
+				s->deadline = now + J1939_BAM_GAP_US;
+			}
+		}
+		break;
+
+	case J_TX_DT:
+		while ( s->seq <= s->last && isca_j1939_send_dt(j, s) == ISCA_CAN_OK ) {
+		}
+		if ( s->seq > s->last ) {
+			s->state    = (s->seq > s->packets) ? J_TX_EOMA : J_TX_RTS;
+			s->deadline = now + J1939_T3_US;
+		} /*Window sent*/
+		break;
+
+	case J_RX_BAM:
+		if ( (int32_t)(now - s->deadline) >= 0 ) {
+			isca_j1939_close(j, s, ISCA_CAN_TIMEOUT);
+		}
+		break;
+
+	case J_RX_RTS:
+	case J_TX_RTS:
+	case J_TX_EOMA:
+		if ( (int32_t)(now - s->deadline) >= 0 ) {
+			isca_j1939_abort(j, s, J1939_AB_TIMEOUT, ISCA_CAN_TIMEOUT);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+}
+
+/*Send the session's pending control frame*/
+static int isca_j1939_send_pend(isca_j1939_s *j, isca_j1939_sess_s *s, uint32_t now) {
+
+	uint8_t peer = (s->sa == j->addr) ? s->da : s->sa;
+	uint32_t n = 0U;
+	int ret = ISCA_CAN_OK;
+
+	switch ( s->pend ) {
+
+	case J_PEND_CTS:
+		n = (uint32_t)s->packets - s->seq + 1U;
+		if ( n > s->max_cts ) {
+			n = s->max_cts;
+		}
+		if ( n > J1939_CTS_PACKETS ) {
+			n = J1939_CTS_PACKETS;
+		}
+		ret = isca_j1939_cm(j, peer, J1939_CM_CTS, (uint8_t)n, (uint8_t)s->seq, 0xFFU, 0xFFU, s->pgn);
+		if ( ret == ISCA_CAN_OK ) {
+			s->last     = (uint16_t)(s->seq + n - 1U);
+			s->deadline = now + J1939_T2_US;
+		}
+		break;
+
+	case J_PEND_EOMA:
+		ret = isca_j1939_cm(j, peer, J1939_CM_EOMA, (uint8_t)s->size, (uint8_t)(s->size >> 8),
+		                    s->packets, 0xFFU, s->pgn);
+		if ( ret == ISCA_CAN_OK ) {
+			isca_j1939_close(j, s, ISCA_CAN_OK);
+			return ret;
+		}
+		break;
+
+	case J_PEND_ABORT:
+		ret = isca_j1939_cm(j, peer, J1939_CM_ABORT, s->reason, 0xFFU, 0xFFU, 0xFFU, s->pgn);
+		if ( ret == ISCA_CAN_OK ) {
+			isca_j1939_free(j, s);
+			return ret;
+		}
+		break;
+
+	case J_PEND_RTS:
+	case J_PEND_BAM:
+		ret = isca_j1939_cm(j, (s->pend == J_PEND_BAM) ? J1939_GLOBAL : peer,
+		                    (s->pend == J_PEND_BAM) ? J1939_CM_BAM : J1939_CM_RTS,
+		                    (uint8_t)s->size, (uint8_t)(s->size >> 8), s->packets, 0xFFU, s->pgn);
+		if ( ret == ISCA_CAN_OK ) {
+			s->deadline = now + ((s->pend == J_PEND_BAM) ? J1939_BAM_GAP_US : J1939_T3_US);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if ( ret == ISCA_CAN_OK ) {
+		s->pend = J_PEND_NONE;
+	}
+
+	return ret;
+}
+
+/*Send the session's next data packet*/
+static int isca_j1939_send_dt(isca_j1939_s *j, isca_j1939_sess_s *s) {
+
+	can_frame_s frame;
+	uint32_t off = (uint32_t)(s->seq - 1U) * 7U;
+	uint32_t n = s->size - off;
+	int ret;
+
+	if ( n > 7U ) {
+		n = 7U;
+	}
+
+	frame.ID  = isca_j1939_id(J1939_PRIO_TP, J1939_PGN_TP_DT, j->addr, s->da);
+	frame.IDE = CAN_FRAME_EXT;
+	frame.RTR = 0U;
+	frame.DLC = 8U;
+	memset(frame.DATA, 0xFF, sizeof(frame.DATA));
+	frame.DATA[0] = (uint8_t)s->seq;
+	memcpy(&frame.DATA[1], &s->data[off], n);
+
+	ret = isca_can_transmit_frame(j->can_ctrl, &frame, CAN_REQ_NONBLOCKING);
+	if ( ret == ISCA_CAN_OK ) {
+		s->seq++;
+	}
+
+	return ret;
+}
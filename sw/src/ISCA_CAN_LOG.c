@@ -0,0 +1,205 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN event log
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_LOG.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_LOG.c
+ *
+ * @brief Binary event log, safe to write from interrupt context
+ *
+ * Interrupt handlers record fixed size binary events, i.e., id, timestamp
+ * and two arguments, instead of printing; a low priority task formats them
+ * with \ref isca_log_drain. Writers claim a record with a single
+ * compare-and-swap and publish it through the record's sequence number, so
+ * several interrupt sources, nested or on several cores, may log at once.
+ * A full ring never stalls a writer; the event is dropped and counted.
+ * Sequence numbers are stored relative to the record index, so the zeroed
+ * ring is ready before any initialization code runs.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_LOG.h"
+#include <stdio.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#if (LOG_ENTRIES & (LOG_ENTRIES - 1U)) != 0
+#error "LOG_ENTRIES must be a power of two"
+#endif
+
+#define LOG_MASK      (LOG_ENTRIES - 1U)
+
+/// Ring slot; seq + index tells writers and the reader whose turn it is
+typedef struct {
+	uint32_t seq;
+	isca_log_rec_s rec;
+} log_slot_s;
+
+/******
+ * VARIABLES
+ ******/
+static log_slot_s log_ring[LOG_ENTRIES];
+static uint32_t   log_wr;
+static uint32_t   log_rd;
+static uint32_t   log_lost;
+
+static char const * const log_ev_name[LOG_EV_COUNT] = {
+	"?",
+	"Error warning IRQ",
+	"RX FIFO overrun IRQ",
+	"Error passive IRQ",
+	"Arbitration lost IRQ",
+	"Bus error IRQ",
+	"RX queue full, frames dropped",
+	"RX queue full, RX IRQ masked",
+};
+
+static char const * const log_lvl_name[] = { "", "ERR", "WRN", "INF" };
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Record an event; never blocks, callable from interrupt context
+ * @note       Use the \ref __LOG_ERROR, \ref __LOG_WARN and \ref __LOG_INFO
+ *             macros, filtered at compile time by \ref LOG_LEVEL
+ * @param[in]  level Event level
+ * @param[in]  event Event id, e.g., \ref LOG_EV_ERR_WARN
+ * @param[in]  arg0  Event argument
+ * @param[in]  arg1  Event argument
+ * @return     None
+ */
+void isca_log_put(uint8_t level, uint16_t event, uint32_t arg0, uint32_t arg1) {
+
+	log_slot_s *slot;
+	uint32_t pos;
+	int32_t  dif;
+
+	pos = __atomic_load_n(&log_wr, __ATOMIC_RELAXED);
+	for (;;) {
+		slot = &log_ring[pos & LOG_MASK];
+		dif  = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) + (pos & LOG_MASK) - pos);
+
+		if ( dif == 0 ) {
+			if ( __atomic_compare_exchange_n(&log_wr, &pos, pos + 1U, 1,
+			                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) {
+				break;
+			}
+		} /*Record free; claim it, pos reloaded on failure*/
+		else if ( dif < 0 ) {
+			__atomic_fetch_add(&log_lost, 1U, __ATOMIC_RELAXED);
+			return;
+		} /*Ring full*/
+		else {
+			pos = __atomic_load_n(&log_wr, __ATOMIC_RELAXED);
+		} /*Another writer claimed it*/
+	}
+
+	slot->rec.ts    = ISCA_TIME_Us();
+	slot->rec.event = event;
+	slot->rec.level = level;
+	slot->rec.rsvd  = 0U;
+	slot->rec.arg0  = arg0;
+	slot->rec.arg1  = arg1;
+	__atomic_store_n(&slot->seq, pos + 1U - (pos & LOG_MASK), __ATOMIC_RELEASE);
+
+}
+
+/**
+ * @brief      Take the oldest event; single reader
+ * @param[out] rec Event record
+ * @retval     1 if an event was taken, 0 if the log is empty
+ */
+int isca_log_pop(isca_log_rec_s *rec) {
+
+	log_slot_s *slot = &log_ring[log_rd & LOG_MASK];
+	uint32_t   base  = log_rd - (log_rd & LOG_MASK);
+
+	if ( __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != base + 1U ) {
+		return 0;
+	} /*Empty, or the oldest record is still being written*/
+
+	*rec = slot->rec;
+	__atomic_store_n(&slot->seq, base + LOG_ENTRIES, __ATOMIC_RELEASE);
+	log_rd++;
+
+	return 1;
+}
+
+/**
+ * @brief      Format and print up to max events; call from a low priority task
+ * @param[in]  max Events budget
+ * @retval     Amount of events printed
+ */
+uint32_t isca_log_drain(uint32_t max) {
+
+	isca_log_rec_s rec;
+	uint32_t n;
+
+	for ( n = 0U; n < max && isca_log_pop(&rec); n++ ) {
+		__COUT("\n\r[%10lu] %s %s (0x%08lx, 0x%08lx)",
+		       (unsigned long)rec.ts,
+		       log_lvl_name[rec.level & 3U],
+		       log_ev_name[(rec.event < LOG_EV_COUNT) ? rec.event : 0U],
+		       (unsigned long)rec.arg0, (unsigned long)rec.arg1);
+	}
+
+	return n;
+}
+
+/**
+ * @brief      Events dropped on a full log
+ * @retval     Drop count
+ */
+uint32_t isca_log_lost(void) {
+
+	return __atomic_load_n(&log_lost, __ATOMIC_RELAXED);
+
+}
+
@@ -0,0 +1,219 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN multi-controller manager
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_MGR.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_MGR.c
+ *
+ * @brief Services several CAN controllers from a single reactor loop
+ *
+ * The manager owns the interrupt-mode controllers of a node, e.g., the
+ * axi_can instances of a gateway. The platform interrupt glue hands every
+ * CAN interrupt to \ref isca_can_mgr_irq, which runs the owning
+ * controller's top half and marks it pending. A single loop calling
+ * \ref isca_can_mgr_poll sleeps until a controller is pending and runs the
+ * bottom halves round robin, each for at most \ref CAN_MGR_QUANTUM frames
+ * per round, so a flooded bus can not starve the others.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_MGR.h"
+#include "ISCA_CAN_IRQ.h"
+#include "ISCA_CAN_API.h"
+#include <string.h>
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize an empty manager
+ * @param[out] mgr Manager
+ * @return     None
+ */
+void isca_can_mgr_init(isca_can_mgr_s *mgr) {
+
+	memset(mgr, 0, sizeof(isca_can_mgr_s));
+	isca_wait_init(&mgr->wait);
+
+}
+
+/**
+ * @brief      Take a controller under management
+ * @param[in]  mgr      Manager
+ * @param[in]  can_ctrl Controller, initialized with \ref lbr_isca_can_init
+ *                      in \ref CAN_IRQ_ON mode
+ * @param[in]  irq_src  Platform interrupt source of the controller, as
+ *                      passed to \ref isca_can_mgr_irq
+ * @return     Controller index in the manager
+ * @return     \ref ISCA_MGR_FULL
+ * @return     \ref ISCA_MGR_INV_CTRL
+ */
+int isca_can_mgr_add(isca_can_mgr_s *mgr, can_ctrl_s *can_ctrl, uint32_t irq_src) {
+
+	uint8_t i;
+
+	if ( can_ctrl->irq != CAN_IRQ_ON ) {
+		return ISCA_MGR_INV_CTRL;
+	} /*Polling mode controllers are served by their readers*/
+
+	for ( i = 0U; i < mgr->count; i++ ) {
+		if ( mgr->ctrl[i] == can_ctrl || mgr->irq_src[i] == irq_src ) {
+			return ISCA_MGR_INV_CTRL;
+		}
+	} /*Already managed*/
+
+	if ( mgr->count >= CAN_MGR_MAX ) {
+		return ISCA_MGR_FULL;
+	}
+
+	mgr->ctrl[i]    = can_ctrl;
+	mgr->irq_src[i] = irq_src;
+	memset(&mgr->stats[i], 0, sizeof(isca_can_mgr_stats_s));
+	mgr->count++;
+
+	return (int)i;
+}
+
+/**
+ * @brief      Dispatch a CAN interrupt to its controller's top half and
+ *             wake the reactor; call from the platform interrupt glue
+ * @param[in]  mgr     Manager
+ * @param[in]  irq_src Platform interrupt source
+ * @return     None
+ */
+void isca_can_mgr_irq(isca_can_mgr_s *mgr, uint32_t irq_src) {
+
+	uint8_t i;
+
+	for ( i = 0U; i < mgr->count; i++ ) {
+		if ( mgr->irq_src[i] == irq_src ) {
+			break;
+		}
+	}
+
+	if ( i == mgr->count ) {
+		return;
+	} /*Not ours*/
+
+	mgr->ctrl[i]->InterruptHandler(mgr->ctrl[i]);
+	mgr->stats[i].irqs++;
+
+	__atomic_fetch_or(&mgr->pending, 1UL << i, __ATOMIC_RELEASE);
+	isca_wait_signal(&mgr->wait);
+
+}
+
+/**
+ * @brief      Reactor step: wait up to a timeout for a pending controller,
+ *             then serve the pending ones round robin
+ * @param[in]  mgr        Manager
+ * @param[in]  budget     Most frames to handle in this step, over all controllers
+ * @param[in]  timeout_us Time budget in microseconds to wait for work, 0 to
+ *                        only check once, \ref ISCA_CAN_WAIT_FOREVER to block
+ * @return     Amount of frames handled
+ * @return     \ref ISCA_CAN_TIMEOUT
+ */
+int isca_can_mgr_poll(isca_can_mgr_s *mgr, uint32_t budget, uint32_t timeout_us) {
+
+	uint32_t deadline = ISCA_TIME_Us() + timeout_us;
+	uint32_t *deadline_p = (timeout_us == ISCA_CAN_WAIT_FOREVER) ? NULL : &deadline;
+	uint32_t pending;
+	uint32_t quantum;
+	uint32_t done;
+	uint32_t total = 0U;
+	uint32_t seq;
+	uint8_t  i;
+	uint8_t  k;
+
+	for (;;) {
+		seq = isca_wait_prepare(&mgr->wait);
+
+		pending = __atomic_exchange_n(&mgr->pending, 0U, __ATOMIC_ACQ_REL);
+		if ( pending != 0U ) {
+			break;
+		}
+
+		if ( isca_wait_block(&mgr->wait, seq, deadline_p) == WAIT_TIMEOUT ) {
+			return ISCA_CAN_TIMEOUT;
+		}
+	} /*Wait for a dispatched interrupt*/
+
+	while ( pending != 0U && total < budget ) {
+
+		for ( k = 0U; k < mgr->count && total < budget; k++ ) {
+
+			i = (uint8_t)((mgr->next + k) % mgr->count);
+			if ( (pending & (1UL << i)) == 0U ) {
+				continue;
+			}
+
+			quantum = budget - total;
+			quantum = (quantum < CAN_MGR_QUANTUM) ? quantum : CAN_MGR_QUANTUM;
+
+			done = isca_can_bh_run(mgr->ctrl[i], quantum);
+			total += done;
+			mgr->stats[i].rounds++;
+			mgr->stats[i].frames += done;
+
+			if ( done == quantum ) {
+				mgr->stats[i].quota_hits++;
+			} /*Possibly more staged; serve again next round*/
+			else {
+				pending &= ~(1UL << i);
+			} /*Drained*/
+		}
+
+		mgr->next = (uint8_t)((mgr->next + 1U) % mgr->count);
+	} /*Round robin over the pending controllers*/
+
+	if ( pending != 0U ) {
+		__atomic_fetch_or(&mgr->pending, pending, __ATOMIC_RELEASE);
+	} /*Budget spent; carry the rest over*/
+
+	return (int)total;
+}
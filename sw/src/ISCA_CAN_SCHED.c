@@ -0,0 +1,341 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA_CAN cyclic TX scheduler
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_SCHED.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_SCHED.c
+ *
+ * @brief Cyclic CAN frames TX scheduler, driven by a hierarchical timer wheel
+ *
+ * Every cyclic frame is pre-encoded once (see \ref isca_can_tx_img_compile)
+ * and linked to a slot of a \ref ISCA_SCHED_LEVELS level timer wheel.
+ * \ref isca_sched_run advances the wheel up to the given tick, releases the
+ * expired frames and writes them to the controller, oldest release first.
+ * Frames that find the TX buffer busy stay pending and are written by the
+ * next \ref isca_sched_run, or by \ref isca_sched_tx_done called from the
+ * TX complete interrupt.
+ *
+ * A tick is whatever unit the caller passes to \ref isca_sched_run, e.g.,
+ * a millisecond system tick.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note The scheduler is not reentrant; if \ref isca_sched_tx_done is called
+ * from interrupt context, mask the CAN interrupt around \ref isca_sched_run
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_SCHED.h"
+#include <string.h>
+
+/******
+ * PRIVATE FUNCTIONS DECLARATION
+ ******/
+static void isca_sched_link(isca_sched_s *sched, isca_sched_entry_s *entry);
+static void isca_sched_unlink(isca_sched_s *sched, isca_sched_entry_s *entry);
+static void isca_sched_cascade(isca_sched_s *sched, uint8_t level);
+static void isca_sched_release(isca_sched_s *sched, isca_sched_entry_s *entry);
+static int  isca_sched_flush(isca_sched_s *sched, uint32_t now);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize a cyclic TX scheduler
+ * @param[out] sched    Scheduler instance pointer
+ * @param[in]  can_ctrl Initialized CAN controller frames are sent from
+ * @param[in]  now      Current tick
+ * @return     None
+ */
+void isca_sched_init(isca_sched_s *sched, can_ctrl_s *can_ctrl, uint32_t now) {
+
+	memset(sched, 0, sizeof(isca_sched_s));
+	sched->can_ctrl = can_ctrl;
+	sched->now      = now;
+
+}
+
+/**
+ * @brief      Register a cyclic frame
+ *
+ * The first release happens \p offset ticks after the scheduler's current
+ * tick; spread the offsets of frames sharing a period to spread bus load.
+ * @param[in,out] sched  Scheduler instance pointer
+ * @param[out] entry     Caller provided entry storage
+ * @param[in]  frame     Frame to send
+ * @param[in]  period    Release period in ticks, 0 < period < \ref ISCA_SCHED_HORIZON
+ * @param[in]  offset    Phase offset in ticks, offset < \ref ISCA_SCHED_HORIZON
+ * @return     \ref ISCA_CAN_INV_PARAM
+ * @return     \ref ISCA_CAN_INV_DLC
+ * @return     \ref ISCA_CAN_OK
+ */
+int isca_sched_add(isca_sched_s *sched, isca_sched_entry_s *entry,
+                   can_frame_s const *frame, uint32_t period, uint32_t offset) {
+
+	int ret_val;
+
+	if ( period == 0U || period >= ISCA_SCHED_HORIZON || offset >= ISCA_SCHED_HORIZON ) {
+		return ISCA_CAN_INV_PARAM;
+	} /*Out of the wheel's horizon*/
+
+	memset(entry, 0, sizeof(isca_sched_entry_s));
+
+	ret_val = isca_can_tx_img_compile(sched->can_ctrl, &entry->img, frame);
+	if ( ret_val != ISCA_CAN_OK ) {
+		return ret_val;
+	} /*Frame can not be encoded*/
+
+	entry->period = period;
+	entry->due    = sched->now + offset;
+	isca_sched_link(sched, entry);
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Unregister a cyclic frame
+ * @param[in,out] sched  Scheduler instance pointer
+ * @param[in]  entry     Registered entry
+ * @return     \ref ISCA_CAN_OK
+ */
+int isca_sched_remove(isca_sched_s *sched, isca_sched_entry_s *entry) {
+
+	isca_sched_entry_s **pp;
+	isca_sched_entry_s *prev = NULL;
+
+	isca_sched_unlink(sched, entry);
+
+	if ( entry->pending ) {
+		for ( pp = &sched->pend_head; *pp != NULL; prev = *pp, pp = &(*pp)->pnext ) {
+			if ( *pp == entry ) {
+				*pp = entry->pnext;
+				if ( sched->pend_tail == entry ) {
+					sched->pend_tail = prev;
+				}
+				break;
+			}
+		}
+		entry->pending = 0U;
+	} /*Drop the pending release*/
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Update the payload of a cyclic frame
+ * @param[in,out] entry  Registered entry
+ * @param[in]  data      New payload bytes
+ * @param[in]  len       Amount of bytes, up to the registered frame's DLC
+ * @return     \ref ISCA_CAN_INV_DLC
+ * @return     \ref ISCA_CAN_OK
+ */
+int isca_sched_update(isca_sched_entry_s *entry, uint8_t const *data, uint8_t len) {
+
+	return isca_can_tx_img_payload(&entry->img, data, len);
+
+}
+
+/**
+ * @brief      Advance the timer wheel and send the released frames
+ * @param[in,out] sched  Scheduler instance pointer
+ * @param[in]  now       Current tick
+ * @return     Amount of frames written to the TX buffer
+ */
+int isca_sched_run(isca_sched_s *sched, uint32_t now) {
+
+	uint8_t idx;
+	isca_sched_entry_s *entry;
+
+	while ( (int32_t)(now - sched->now) >= 0 ) {
+
+		idx = (uint8_t)(sched->now & ISCA_SCHED_WHEEL_MASK);
+
+		if ( idx == 0U ) {
+			if ( ((sched->now >> ISCA_SCHED_WHEEL_BITS) & ISCA_SCHED_WHEEL_MASK) == 0U ) {
+				isca_sched_cascade(sched, 2U);
+			}
+			isca_sched_cascade(sched, 1U);
+		} /*Level 0 wrapped; bring the next block of ticks down*/
+
+		entry = sched->wheel[0][idx];
+		sched->wheel[0][idx] = NULL;
+
+		while ( entry != NULL ) {
+			isca_sched_entry_s *next = entry->next;
+
+			isca_sched_release(sched, entry);
+			entry->due += entry->period;
+			isca_sched_link(sched, entry);
+
+			entry = next;
+		} /*Release expired frames and re-arm them*/
+
+		sched->now++;
+	}
+
+	return isca_sched_flush(sched, now);
+}
+
+/**
+ * @brief      Send pending frames; call it from the TX complete interrupt
+ * @param[in,out] sched  Scheduler instance pointer
+ * @param[in]  now       Current tick
+ * @return     Amount of frames written to the TX buffer
+ */
+int isca_sched_tx_done(isca_sched_s *sched, uint32_t now) {
+
+	return isca_sched_flush(sched, now);
+
+}
+
+/******
+ * PRIVATE FUNCTIONS DEFINITION
+ ******/
+/*Link the entry to the wheel slot its due tick falls in*/
+static void isca_sched_link(isca_sched_s *sched, isca_sched_entry_s *entry) {
+
+	uint32_t delta = entry->due - sched->now;
+	uint8_t  level;
+
+	for ( level = 0U; level < ISCA_SCHED_LEVELS - 1U; level++ ) {
+		if ( delta < (1UL << (ISCA_SCHED_WHEEL_BITS*(level+1U))) ) {
+			break;
+		}
+	} /*Lowest level covering the delay*/
+
+	entry->level = level;
+	entry->slot  = (uint8_t)((entry->due >> (ISCA_SCHED_WHEEL_BITS*level)) & ISCA_SCHED_WHEEL_MASK);
+	entry->next  = sched->wheel[level][entry->slot];
+	sched->wheel[level][entry->slot] = entry;
+
+}
+
+/*Unlink the entry from its wheel slot*/
+static void isca_sched_unlink(isca_sched_s *sched, isca_sched_entry_s *entry) {
+
+	isca_sched_entry_s **pp = &sched->wheel[entry->level][entry->slot];
+
+	while ( *pp != NULL ) {
+		if ( *pp == entry ) {
+			*pp = entry->next;
+			break;
+		}
+		pp = &(*pp)->next;
+	}
+
+	entry->next = NULL;
+
+}
+
+/*Re-link the entries of the current slot of a higher level*/
+static void isca_sched_cascade(isca_sched_s *sched, uint8_t level) {
+
+	uint8_t idx = (uint8_t)((sched->now >> (ISCA_SCHED_WHEEL_BITS*level)) & ISCA_SCHED_WHEEL_MASK);
+	isca_sched_entry_s *entry = sched->wheel[level][idx];
+
+	sched->wheel[level][idx] = NULL;
+
+	while ( entry != NULL ) {
+		isca_sched_entry_s *next = entry->next;
+		isca_sched_link(sched, entry);
+		entry = next;
+	}
+
+}
+
+/*Append a released frame to the pending list*/
+static void isca_sched_release(isca_sched_s *sched, isca_sched_entry_s *entry) {
+
+	if ( entry->pending ) {
+		entry->stats.misses++;
+		entry->released = entry->due;
+		return;
+	} /*Previous release not sent yet; the newer one replaces it*/
+
+	entry->pending  = 1U;
+	entry->released = entry->due;
+	entry->pnext    = NULL;
+
+	if ( sched->pend_tail != NULL ) {
+		sched->pend_tail->pnext = entry;
+	}
+	else {
+		sched->pend_head = entry;
+	}
+	sched->pend_tail = entry;
+
+}
+
+/*Write pending frames until the TX buffer is found busy*/
+static int isca_sched_flush(isca_sched_s *sched, uint32_t now) {
+
+	int sent = 0;
+	uint32_t jitter;
+	isca_sched_entry_s *entry;
+
+	while ( (entry = sched->pend_head) != NULL ) {
+
+		if ( isca_can_transmit_img(sched->can_ctrl, &entry->img, CAN_REQ_NONBLOCKING) != ISCA_CAN_OK ) {
+			break;
+		} /*TX buffer busy; retry on TX done or next run*/
+
+		sched->pend_head = entry->pnext;
+		if ( sched->pend_head == NULL ) {
+			sched->pend_tail = NULL;
+		}
+		entry->pending = 0U;
+
+		jitter = now - entry->released;
+		entry->stats.jitter_last = jitter;
+		if ( jitter > entry->stats.jitter_max ) {
+			entry->stats.jitter_max = jitter;
+		}
+		entry->stats.sent++;
+		sent++;
+	}
+
+	return sent;
+}
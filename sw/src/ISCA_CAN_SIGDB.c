@@ -0,0 +1,590 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN compiled signal database
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_SIGDB.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_SIGDB.c
+ *
+ * @brief Signal database: DBC-style signal descriptions compiled into per
+ * message extraction plans, decoded in batches
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note Load and compile at startup; decoding only reads the database,
+ * besides the short frame counter
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_SIGDB.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#define SIGDB_NO_MSG          (0xFFU)        /*!<Frame of no message*/
+#define SIGDB_DBC_NO_MSG      (0xC0000000UL) /*!<DBC pseudo message of unassigned signals*/
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static uint32_t isca_sigdb_hdr(uint32_t id, uint8_t ide);
+static uint8_t isca_sigdb_lookup(isca_sigdb_s const *db, uint32_t hdr);
+static int isca_sigdb_layout(isca_sig_def_s const *def, uint8_t *shift, uint8_t *bytes);
+static uint64_t isca_sigdb_word(uint8_t const *data);
+static SIGDB_VALUE isca_sigdb_extract(isca_sig_s const *sg, uint64_t w);
+static void isca_sigdb_run(isca_sig_s const *sg, uint64_t const * restrict w, uint32_t n, SIGDB_VALUE * restrict out);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize an empty signal database
+ * @param[out] db  Signal database
+ * @return     None
+ */
+void isca_sigdb_init(isca_sigdb_s *db) {
+
+	memset(db, 0, sizeof(isca_sigdb_s));
+
+}
+
+/**
+ * @brief      Add a signal description; takes effect on \ref isca_sigdb_compile
+ * @param[in]  db   Signal database
+ * @param[in]  def  Description
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_SIGDB_FULL
+ * @return     \ref ISCA_CAN_INV_PARAM, signal outside the 8-byte payload
+ */
+int isca_sigdb_add(isca_sigdb_s *db, isca_sig_def_s const *def) {
+
+	uint8_t shift;
+	uint8_t bytes;
+
+	if ( db->n_def >= SIGDB_MAX_SIGS ) {
+		return ISCA_SIGDB_FULL;
+	}
+
+	if ( isca_sigdb_layout(def, &shift, &bytes) != ISCA_CAN_OK ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	db->def[db->n_def] = *def;
+	db->def[db->n_def].name[SIGDB_NAME_LEN - 1U] = '\0';
+	db->n_def++;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Add the signals of a DBC text: BO_ and SG_ lines, others are
+ *             skipped, and so are multiplexed signals
+ * @param[in]  db    Signal database
+ * @param[in]  text  DBC file contents, NUL terminated
+ * @return     Amount of signals added
+ * @return     \ref ISCA_SIGDB_SYNTAX, line in db->err_line
+ * @return     \ref ISCA_SIGDB_FULL
+ */
+int isca_sigdb_load_dbc(isca_sigdb_s *db, char const *text) {
+
+	isca_sig_def_s def;
+	char const *p = text;
+	char const *eol;
+	unsigned long id;
+	unsigned start;
+	unsigned len;
+	char order;
+	char sign;
+	char *end;
+	uint32_t line = 0U;
+	uint32_t k;
+	int have_msg = 0;
+	int added = 0;
+	int ret;
+
+	memset(&def, 0, sizeof(def));
+
+	for ( ; *p != '\0'; p = (*eol != '\0') ? eol + 1 : eol ) {
+
+		line++;
+		eol = strchr(p, '\n');
+		if ( eol == NULL ) {
+			eol = p + strlen(p);
+		}
+
+		while ( *p == ' ' || *p == '\t' ) {
+			p++;
+		}
+
+		if ( strncmp(p, "BO_ ", 4U) == 0 ) {
+
+			id = strtoul(p + 4, &end, 10);
+			if ( end == p + 4 ) {
+				db->err_line = line;
+				return ISCA_SIGDB_SYNTAX;
+			}
+
+			have_msg = (id != SIGDB_DBC_NO_MSG);
+			def.id   = (uint32_t)id & CAN_CF_ID_MSK;
+			def.ide  = ((id & 0x80000000UL) != 0U) ? CAN_FRAME_EXT : CAN_FRAME_STD;
+			continue;
+		} /*Message: ID, bit 31 set for 29-bit IDs*/
+
+		if ( strncmp(p, "SG_ ", 4U) != 0 ) {
+			continue;
+		}
+
+		if ( !have_msg ) {
+			continue;
+		} /*Signal of no message*/
+
+		p += 4;
+		while ( *p == ' ' ) {
+			p++;
+		}
+
+		for ( k = 0U; p < eol && *p != ' ' && *p != ':'; p++ ) {
+			if ( k < SIGDB_NAME_LEN - 1U ) {
+				def.name[k++] = *p;
+			}
+		}
+		def.name[k] = '\0';
+
+		while ( *p == ' ' ) {
+			p++;
+		}
+
+		if ( *p == 'm' ) {
+			continue;
+		} /*Multiplexed signal*/
+
+		if ( *p == 'M' ) {
+			p++;
+			while ( *p == ' ' ) {
+				p++;
+			}
+		} /*Multiplexer, a plain signal*/
+
+		if ( k == 0U || *p != ':' ||
+		     sscanf(p + 1, " %u|%u@%c%c (%lf,%lf)", &start, &len, &order, &sign, &def.scale, &def.offset) != 6 ||
+		     start > 63U || (order != '0' && order != '1') || (sign != '+' && sign != '-') ) {
+			db->err_line = line;
+			return ISCA_SIGDB_SYNTAX;
+		}
+
+		def.start      = (uint8_t)start;
+		def.len        = (uint8_t)((len <= 64U) ? len : 0U);
+		def.big_endian = (order == '0');
+		def.is_signed  = (sign == '-');
+
+		ret = isca_sigdb_add(db, &def);
+		if ( ret == ISCA_CAN_INV_PARAM ) {
+			db->err_line = line;
+			return ISCA_SIGDB_SYNTAX;
+		}
+		if ( ret != ISCA_CAN_OK ) {
+			return ret;
+		}
+
+		added++;
+	}
+
+	return added;
+}
+
+/**
+ * @brief      Compile the added signals: extraction plans grouped by message
+ *             and the message lookup
+ * @param[in]  db  Signal database
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_SIGDB_FULL, more than \ref SIGDB_MAX_MSGS messages
+ */
+int isca_sigdb_compile(isca_sigdb_s *db) {
+
+	isca_sig_def_s const *def;
+	isca_sig_msg_s *msg;
+	isca_sig_s *sg;
+	uint16_t fill[SIGDB_MAX_MSGS];
+	uint8_t  m_of[SIGDB_MAX_SIGS];
+	uint32_t hdr;
+	uint32_t h;
+	uint16_t first = 0U;
+	uint16_t i;
+	uint8_t  m;
+	uint8_t  bytes;
+
+	memset(db->hash, 0, sizeof(db->hash));
+	db->n_msg = 0U;
+	db->n_sig = 0U;
+
+	for ( i = 0U; i < db->n_def; i++ ) {
+
+		hdr = isca_sigdb_hdr(db->def[i].id, db->def[i].ide);
+		m   = isca_sigdb_lookup(db, hdr);
+
+		if ( m == SIGDB_NO_MSG ) {
+
+			if ( db->n_msg >= SIGDB_MAX_MSGS ) {
+				return ISCA_SIGDB_FULL;
+			}
+
+			m   = (uint8_t)db->n_msg++;
+			msg = &db->msg[m];
+			memset(msg, 0, sizeof(isca_sig_msg_s));
+			msg->hdr = hdr;
+
+			for ( h = hdr ^ (hdr >> 11) ^ (hdr >> 22); db->hash[h & (SIGDB_HASH_SLOTS - 1U)] != 0U; h++ ) {
+			}
+			db->hash[h & (SIGDB_HASH_SLOTS - 1U)] = (uint8_t)(m + 1U);
+		} /*New message*/
+
+		m_of[i] = m;
+		db->msg[m].n_sig++;
+	} /*Messages, in order of appearance*/
+
+	for ( m = 0U; m < db->n_msg; m++ ) {
+		db->msg[m].first = first;
+		fill[m] = first;
+		first   = (uint16_t)(first + db->msg[m].n_sig);
+	}
+
+	for ( i = 0U; i < db->n_def; i++ ) {
+
+		def = &db->def[i];
+		msg = &db->msg[m_of[i]];
+		sg  = &db->sig[fill[m_of[i]]++];
+
+		memset(sg, 0, sizeof(isca_sig_s));
+		(void)isca_sigdb_layout(def, &sg->shift, &bytes);
+		sg->def        = i;
+		sg->len        = def->len;
+		sg->big_endian = def->big_endian;
+		sg->is_signed  = def->is_signed;
+		sg->scale      = (SIGDB_VALUE)def->scale;
+		sg->offset     = (SIGDB_VALUE)def->offset;
+		sg->mask       = (def->len == 64U) ? ~(uint64_t)0U : (((uint64_t)1U << def->len) - 1U);
+		sg->kind       = SIG_K_GENERIC;
+
+		if ( (sg->shift & 7U) == 0U ) {
+			switch ( def->len ) {
+			case 8U:  sg->kind = def->is_signed ? SIG_K_I8  : SIG_K_U8;  break;
+			case 16U: sg->kind = def->is_signed ? SIG_K_I16 : SIG_K_U16; break;
+			case 32U: sg->kind = def->is_signed ? SIG_K_I32 : SIG_K_U32; break;
+			default: break;
+			}
+		} /*Byte aligned fast paths*/
+
+		if ( bytes > msg->dlc ) {
+			msg->dlc = bytes;
+		}
+		msg->big_endian |= def->big_endian;
+	}
+
+	db->n_sig = db->n_def;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Column index of a signal, valid after \ref isca_sigdb_compile
+ * @param[in]  db    Signal database
+ * @param[in]  name  Signal name
+ * @return     Column index, first signal of the name
+ * @return     \ref ISCA_SIGDB_NONE
+ */
+int isca_sigdb_find(isca_sigdb_s const *db, char const *name) {
+
+	uint16_t k;
+
+	for ( k = 0U; k < db->n_sig; k++ ) {
+		if ( strncmp(db->def[db->sig[k].def].name, name, SIGDB_NAME_LEN) == 0 ) {
+			return (int)k;
+		}
+	}
+
+	return ISCA_SIGDB_NONE;
+}
+
+/**
+ * @brief      Physical value of one signal in one frame
+ * @param[in]  db     Signal database
+ * @param[in]  sig    Column index, see \ref isca_sigdb_find
+ * @param[in]  frame  Frame of the signal's message
+ * @return     Physical value
+ */
+SIGDB_VALUE isca_sigdb_get(isca_sigdb_s const *db, uint16_t sig, can_cframe_s const *frame) {
+
+	uint64_t w = isca_sigdb_word(frame->data);
+	isca_sig_s const *sg = &db->sig[sig];
+
+	return isca_sigdb_extract(sg, sg->big_endian ? __builtin_bswap64(w) : w);
+}
+
+/**
+ * @brief      Decode a batch of frames into the signal columns; frames of
+ *             no message are skipped
+ * @param[in]  db      Signal database, compiled
+ * @param[in]  frames  Frames, e.g., from \ref lbr_isca_can_receive_burst
+ * @param[in]  n       Amount of frames
+ * @param[out] cols    One column per compiled signal, db->n_sig, each with
+ *                     room for the frames of its message
+ * @return     Amount of frames decoded
+ */
+uint32_t isca_sigdb_decode(isca_sigdb_s *db, can_cframe_s const *frames, uint32_t n, isca_sig_col_s *cols) {
+
+	isca_sig_msg_s const *msg;
+	isca_sig_col_s *col;
+	uint64_t w[SIGDB_CHUNK];
+	uint64_t wb[SIGDB_CHUNK];
+	uint32_t row[SIGDB_CHUNK];
+	uint8_t  mi[SIGDB_CHUNK];
+	uint16_t cnt[SIGDB_MAX_MSGS];
+	uint16_t pos[SIGDB_MAX_MSGS];
+	uint32_t base;
+	uint32_t c;
+	uint32_t i;
+	uint32_t k;
+	uint32_t decoded = 0U;
+	uint16_t s;
+	uint8_t  m;
+
+	for ( base = 0U; base < n; base += c ) {
+
+		c = (n - base < SIGDB_CHUNK) ? n - base : SIGDB_CHUNK;
+		memset(cnt, 0, db->n_msg * sizeof(uint16_t));
+
+		for ( i = 0U; i < c; i++ ) {
+			m = isca_sigdb_lookup(db, frames[base + i].hdr & (CAN_CF_ID_MSK | CAN_CF_IDE));
+			if ( m != SIGDB_NO_MSG && frames[base + i].dlc < db->msg[m].dlc ) {
+				db->short_frames++;
+				m = SIGDB_NO_MSG;
+			}
+			mi[i] = m;
+			if ( m != SIGDB_NO_MSG ) {
+				cnt[m]++;
+			}
+		} /*Classify*/
+
+		for ( k = 0U, m = 0U; m < db->n_msg; m++ ) {
+			pos[m] = (uint16_t)k;
+			k += cnt[m];
+		}
+		decoded += k;
+
+		for ( i = 0U; i < c; i++ ) {
+			if ( mi[i] != SIGDB_NO_MSG ) {
+				k      = pos[mi[i]]++;
+				w[k]   = isca_sigdb_word(frames[base + i].data);
+				row[k] = base + i;
+			}
+		} /*Payload words, sorted by message*/
+
+		for ( m = 0U; m < db->n_msg; m++ ) {
+
+			if ( cnt[m] == 0U ) {
+				continue;
+			}
+
+			msg = &db->msg[m];
+			k   = (uint32_t)pos[m] - cnt[m];
+
+			if ( msg->big_endian ) {
+				for ( i = 0U; i < cnt[m]; i++ ) {
+					wb[k + i] = __builtin_bswap64(w[k + i]);
+				}
+			}
+
+			for ( s = msg->first; s < msg->first + msg->n_sig; s++ ) {
+				col = &cols[s];
+				isca_sigdb_run(&db->sig[s], db->sig[s].big_endian ? &wb[k] : &w[k], cnt[m], &col->val[col->n]);
+				if ( col->row != NULL ) {
+					memcpy(&col->row[col->n], &row[k], cnt[m] * sizeof(uint32_t));
+				}
+				col->n += cnt[m];
+			}
+		} /*Each signal over its message's payloads*/
+	}
+
+	return decoded;
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*can_cframe_s hdr of a message*/
+static uint32_t isca_sigdb_hdr(uint32_t id, uint8_t ide) {
+
+	return (id & CAN_CF_ID_MSK) | ((ide == CAN_FRAME_EXT) ? CAN_CF_IDE : 0U);
+
+}
+
+/*Message index of a hdr, SIGDB_NO_MSG if none*/
+static uint8_t isca_sigdb_lookup(isca_sigdb_s const *db, uint32_t hdr) {
+
+	uint32_t h = hdr ^ (hdr >> 11) ^ (hdr >> 22);
+	uint8_t  e;
+
+	while ( (e = db->hash[h & (SIGDB_HASH_SLOTS - 1U)]) != 0U ) {
+		if ( db->msg[e - 1U].hdr == hdr ) {
+			return (uint8_t)(e - 1U);
+		}
+		h++;
+	}
+
+	return SIGDB_NO_MSG;
+}
+
+/*Raw value LSB in the payload word, read little endian for Intel and big
+ *endian for Motorola signals, and the payload bytes the signal needs*/
+static int isca_sigdb_layout(isca_sig_def_s const *def, uint8_t *shift, uint8_t *bytes) {
+
+	uint32_t msb;
+
+	if ( def->len == 0U || def->len > 64U || def->start > 63U ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	if ( !def->big_endian ) {
+		if ( (uint32_t)def->start + def->len > 64U ) {
+			return ISCA_CAN_INV_PARAM;
+		}
+		*shift = def->start;
+		*bytes = (uint8_t)((def->start + def->len + 7U) / 8U);
+		return ISCA_CAN_OK;
+	}
+
+	/*DBC Motorola start bit: the MSB, numbered LSB first within its byte*/
+	msb = (uint32_t)(def->start & ~7U) + (7U - (def->start & 7U));
+	if ( msb + def->len > 64U ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	*shift = (uint8_t)(64U - (msb + def->len));
+	*bytes = (uint8_t)((msb + def->len + 7U) / 8U);
+
+	return ISCA_CAN_OK;
+}
+
+/*Payload as one little endian word*/
+static uint64_t isca_sigdb_word(uint8_t const *data) {
+
+	uint64_t w;
+
+	memcpy(&w, data, sizeof(w));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	w = __builtin_bswap64(w);
+#endif
+
+	return w;
+}
+
+/*Generic extraction of one signal*/
+static SIGDB_VALUE isca_sigdb_extract(isca_sig_s const *sg, uint64_t w) {
+
+	uint64_t raw = (w >> sg->shift) & sg->mask;
+	uint8_t  up = (uint8_t)(64U - sg->len);
+
+	if ( sg->is_signed ) {
+		return (SIGDB_VALUE)((int64_t)(raw << up) >> up) * sg->scale + sg->offset;
+	}
+
+	return (SIGDB_VALUE)raw * sg->scale + sg->offset;
+}
+
+/*One signal over n payload words; byte aligned signals take plain loads*/
+static void isca_sigdb_run(isca_sig_s const *sg, uint64_t const * restrict w, uint32_t n, SIGDB_VALUE * restrict out) {
+
+	SIGDB_VALUE const k = sg->scale;
+	SIGDB_VALUE const o = sg->offset;
+	uint8_t const sh = sg->shift;
+	uint32_t i;
+
+	switch ( sg->kind ) {
+
+	case SIG_K_U8:
+		for ( i = 0U; i < n; i++ ) {
+			out[i] = (SIGDB_VALUE)(uint8_t)(w[i] >> sh) * k + o;
+		}
+		break;
+
+	case SIG_K_I8:
+		for ( i = 0U; i < n; i++ ) {
+			out[i] = (SIGDB_VALUE)(int8_t)(w[i] >> sh) * k + o;
+		}
+		break;
+
+	case SIG_K_U16:
+		for ( i = 0U; i < n; i++ ) {
+			out[i] = (SIGDB_VALUE)(uint16_t)(w[i] >> sh) * k + o;
+		}
+		break;
+
+	case SIG_K_I16:
+		for ( i = 0U; i < n; i++ ) {
+			out[i] = (SIGDB_VALUE)(int16_t)(w[i] >> sh) * k + o;
+		}
+		break;
+
+	case SIG_K_U32:
+		for ( i = 0U; i < n; i++ ) {
+			out[i] = (SIGDB_VALUE)(uint32_t)(w[i] >> sh) * k + o;
+		}
+		break;
+
+	case SIG_K_I32:
+		for ( i = 0U; i < n; i++ ) {
+			out[i] = (SIGDB_VALUE)(int32_t)(w[i] >> sh) * k + o;
+		}
+		break;
+
+	default:
+		for ( i = 0U; i < n; i++ ) {
+			out[i] = isca_sigdb_extract(sg, w[i]);
+		}
+		break;
+	}
+
+}
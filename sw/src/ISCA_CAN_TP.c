@@ -0,0 +1,590 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN ISO-TP transport layer
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_TP.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_TP.c
+ *
+ * @brief ISO 15765-2 (ISO-TP) transport layer, normal addressing
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note An endpoint owns its controller's RX queue when polled; frames for
+ * no session are counted as strays. Feed frames with \ref isca_tp_input
+ * instead to share the controller with other consumers.
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_TP.h"
+#include "ISCA_CAN_API.h"
+
+/******
+ * DEFINITIONS
+ ******/
+/*-----
+ * ISO-TP SESSION STATES
+ *----*/
+#define TP_IDLE               (0U) /*!<No transfer*/
+#define TP_TX_FIRST           (1U) /*!<Single or first frame to send*/
+#define TP_TX_WAIT_FC         (2U) /*!<Waiting for flow control*/
+#define TP_TX_CF              (3U) /*!<Sending consecutive frames*/
+#define TP_RX_CF              (1U) /*!<Receiving consecutive frames*/
+
+#define TP_FF_DL_MAX          (0xFFFU) /*!<Longest message with a 12-bit first frame length*/
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static uint32_t isca_tp_hash(uint32_t id);
+static void isca_tp_frame(isca_tp_sess_s const *sess, can_frame_s *frame);
+static uint32_t isca_tp_stmin_us(uint8_t stmin);
+static void isca_tp_tx_done(isca_tp_sess_s *sess, int res);
+static void isca_tp_rx_done(isca_tp_sess_s *sess, int res);
+static void isca_tp_rx_frame(isca_tp_s *tp, isca_tp_sess_s *sess, can_frame_s const *rx_frame, uint32_t now);
+static void isca_tp_fc_frame(isca_tp_sess_s *sess, can_frame_s const *rx_frame, uint32_t now);
+static void isca_tp_service(isca_tp_s *tp, isca_tp_sess_s *sess, uint32_t now);
+static void isca_tp_tx_first(isca_tp_s *tp, isca_tp_sess_s *sess, uint32_t now);
+static void isca_tp_tx_cf(isca_tp_s *tp, isca_tp_sess_s *sess, uint32_t now);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize an endpoint without sessions
+ * @param[out] tp        Endpoint
+ * @param[in]  can_ctrl  Controller, initialized with \ref lbr_isca_can_init
+ * @return     None
+ */
+void isca_tp_init(isca_tp_s *tp, can_ctrl_s *can_ctrl) {
+
+	memset(tp, 0, sizeof(isca_tp_s));
+	tp->can_ctrl = can_ctrl;
+
+}
+
+/**
+ * @brief      Initialize an idle session; no block size limit, STmin 0
+ * @param[out] sess   Session; set bs and stmin to pace the sender
+ * @param[in]  tx_id  ID of the frames sent
+ * @param[in]  rx_id  ID of the frames received
+ * @param[in]  ide    \ref CAN_FRAME_STD or \ref CAN_FRAME_EXT
+ * @param[in]  cb     Transfer done callback
+ * @param[in]  arg    Caller context
+ * @return     None
+ */
+void isca_tp_sess_init(isca_tp_sess_s *sess, uint32_t tx_id, uint32_t rx_id, uint8_t ide,
+                       isca_tp_cb_t cb, void *arg) {
+
+	memset(sess, 0, sizeof(isca_tp_sess_s));
+	sess->tx_id = tx_id;
+	sess->rx_id = rx_id;
+	sess->ide   = ide;
+	sess->cb    = cb;
+	sess->arg   = arg;
+
+}
+
+/**
+ * @brief      Serve a session
+ * @param[in]  tp    Endpoint
+ * @param[in]  sess  Session, initialized with \ref isca_tp_sess_init; its
+ *                   rx_id must be unique on the endpoint
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_TP_FULL
+ */
+int isca_tp_open(isca_tp_s *tp, isca_tp_sess_s *sess) {
+
+	uint32_t h = isca_tp_hash(sess->rx_id);
+
+	if ( tp->n_sess >= TP_MAX_SESS ) {
+		return ISCA_TP_FULL;
+	}
+
+	sess->next  = tp->hash[h];
+	tp->hash[h] = sess;
+	tp->sess[tp->n_sess++] = sess;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Start sending a message; \ref isca_tp_poll carries it out
+ * @param[in]  sess  Session
+ * @param[in]  buf   Message, kept by the caller until \ref ISCA_TP_EV_TX_DONE
+ * @param[in]  len   Message length, at least 1 byte
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_TP_BUSY
+ * @return     \ref ISCA_CAN_INV_PARAM
+ */
+int isca_tp_send(isca_tp_sess_s *sess, uint8_t const *buf, uint32_t len) {
+
+	if ( sess->tx_state != TP_IDLE ) {
+		return ISCA_TP_BUSY;
+	}
+
+	if ( len == 0U ) {
+		return ISCA_CAN_INV_PARAM;
+	}
+
+	sess->tx_buf   = buf;
+	sess->tx_len   = len;
+	sess->tx_off   = 0U;
+	sess->tx_wft   = 0U;
+	sess->tx_state = TP_TX_FIRST;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      Arm the buffer the next message is reassembled into; disarmed
+ *             on \ref ISCA_TP_EV_RX_DONE success, kept armed on failure
+ * @param[in]  sess  Session
+ * @param[in]  buf   Buffer, NULL to refuse messages
+ * @param[in]  cap   Buffer capacity; longer messages are refused
+ * @return     None
+ */
+void isca_tp_recv(isca_tp_sess_s *sess, uint8_t *buf, uint32_t cap) {
+
+	sess->rx_buf = buf;
+	sess->rx_cap = cap;
+
+}
+
+/**
+ * @brief      Process a received frame; frames for no session are counted
+ *             in tp->strays
+ * @param[in]  tp        Endpoint
+ * @param[in]  rx_frame  Frame
+ * @return     None
+ */
+void isca_tp_input(isca_tp_s *tp, can_frame_s const *rx_frame) {
+
+	isca_tp_sess_s *sess = tp->hash[isca_tp_hash(rx_frame->ID)];
+
+	while ( sess != NULL && (sess->rx_id != rx_frame->ID || sess->ide != rx_frame->IDE) ) {
+		sess = sess->next;
+	}
+
+	if ( sess == NULL || rx_frame->RTR != 0U || rx_frame->DLC == 0U ) {
+		tp->strays++;
+		return;
+	}
+
+	if ( (rx_frame->DATA[0] >> 4) == TP_PCI_FC ) {
+		isca_tp_fc_frame(sess, rx_frame, ISCA_TIME_Us());
+	}
+	else {
+		isca_tp_rx_frame(tp, sess, rx_frame, ISCA_TIME_Us());
+	}
+
+}
+
+/**
+ * @brief      Receive up to budget frames, then move every session on:
+ *             flow control, segmentation and timeouts
+ * @param[in]  tp      Endpoint
+ * @param[in]  budget  Most frames received
+ * @return     Amount of frames received
+ */
+uint32_t isca_tp_poll(isca_tp_s *tp, uint32_t budget) {
+
+	can_frame_s rx_frame;
+	uint32_t n;
+	uint32_t now;
+	uint8_t  i;
+
+	for ( n = 0U; n < budget; n++ ) {
+		if ( lbr_isca_can_receive_pkt_tmo(tp->can_ctrl, &rx_frame, 0U) < 0 ) {
+			break;
+		} /*Drained*/
+		isca_tp_input(tp, &rx_frame);
+	}
+
+	now = ISCA_TIME_Us();
+	for ( i = 0U; i < tp->n_sess; i++ ) {
+		isca_tp_service(tp, tp->sess[i], now);
+	}
+
+	return n;
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Session lookup slot of an ID*/
+static uint32_t isca_tp_hash(uint32_t id) {
+
+	return (id ^ (id >> 7) ^ (id >> 14) ^ (id >> 21)) & (TP_HASH_SLOTS - 1U);
+
+}
+
+/*Padded frame of a session*/
+static void isca_tp_frame(isca_tp_sess_s const *sess, can_frame_s *frame) {
+
+	frame->ID  = sess->tx_id;
+	frame->IDE = sess->ide;
+	frame->RTR = 0U;
+	frame->DLC = 8U;
+	memset(frame->DATA, TP_PAD, sizeof(frame->DATA));
+
+}
+
+/*ISO-TP STmin to microseconds; reserved values mean the longest one*/
+static uint32_t isca_tp_stmin_us(uint8_t stmin) {
+
+	if ( stmin <= 0x7FU ) {
+		return (uint32_t)stmin * 1000U;
+	}
+
+	if ( stmin >= 0xF1U && stmin <= 0xF9U ) {
+		return (uint32_t)(stmin - 0xF0U) * 100U;
+	}
+
+	return 127000U;
+}
+
+/*Finish the transmission; the callback may start the next one*/
+static void isca_tp_tx_done(isca_tp_sess_s *sess, int res) {
+
+	sess->tx_state = TP_IDLE;
+	sess->tx_buf   = NULL;
+
+	if ( sess->cb != NULL ) {
+		sess->cb(sess, ISCA_TP_EV_TX_DONE, res, sess->tx_off < sess->tx_len ? sess->tx_off : sess->tx_len);
+	}
+
+}
+
+/*Finish the reception; the buffer is disarmed on success only*/
+static void isca_tp_rx_done(isca_tp_sess_s *sess, int res) {
+
+	sess->rx_state = TP_IDLE;
+	sess->rx_left  = 0U;
+
+	if ( res == ISCA_CAN_OK ) {
+		sess->rx_buf = NULL;
+	}
+
+	if ( sess->cb != NULL ) {
+		sess->cb(sess, ISCA_TP_EV_RX_DONE, res, res == ISCA_CAN_OK ? sess->rx_len : sess->rx_off);
+	}
+
+}
+
+/*Single, first and consecutive frames*/
+static void isca_tp_rx_frame(isca_tp_s *tp, isca_tp_sess_s *sess, can_frame_s const *rx_frame, uint32_t now) {
+
+	uint8_t const *d = rx_frame->DATA;
+	uint32_t len;
+	uint32_t n;
+
+	switch ( d[0] >> 4 ) {
+
+	case TP_PCI_SF:
+
+		len = d[0] & 0xFU;
+		if ( len == 0U || len >= rx_frame->DLC ) {
+			return;
+		} /*Malformed*/
+
+		sess->rx_state = TP_IDLE; /*Aborts a reception in progress*/
+
+		if ( sess->rx_buf == NULL || len > sess->rx_cap ) {
+			tp->rx_drops++;
+			return;
+		}
+
+		memcpy(sess->rx_buf, &d[1], len);
+		sess->rx_len = len;
+		sess->rx_off = len;
+		isca_tp_rx_done(sess, ISCA_CAN_OK);
+		break;
+
+	case TP_PCI_FF:
+
+		if ( rx_frame->DLC != 8U ) {
+			return;
+		} /*Malformed*/
+
+		len = ((uint32_t)(d[0] & 0xFU) << 8) | d[1];
+		n   = 6U;
+		if ( len == 0U ) {
+			len = ((uint32_t)d[2] << 24) | ((uint32_t)d[3] << 16) | ((uint32_t)d[4] << 8) | d[5];
+			n   = 2U;
+		} /*32-bit length escape*/
+
+		sess->rx_state = TP_IDLE; /*A new first frame restarts the reception*/
+
+		if ( len <= 7U ) {
+			return;
+		} /*Malformed*/
+
+		if ( sess->rx_buf == NULL || len > sess->rx_cap ) {
+			tp->rx_drops++;
+			sess->fc_pend = TP_FC_OVFLW + 1U;
+			return;
+		}
+
+		memcpy(sess->rx_buf, &d[8U - n], n);
+		sess->rx_len   = len;
+		sess->rx_off   = n;
+		sess->rx_sn    = 1U;
+		sess->rx_left  = sess->bs;
+		sess->rx_state = TP_RX_CF;
+		sess->fc_pend  = TP_FC_CTS + 1U;
+		sess->rx_deadline = now + TP_N_CR_US;
+		break;
+
+	case TP_PCI_CF:
+
+		if ( sess->rx_state != TP_RX_CF ) {
+			return;
+		} /*Not expected*/
+
+		if ( (d[0] & 0xFU) != sess->rx_sn ) {
+			isca_tp_rx_done(sess, ISCA_TP_SEQ);
+			return;
+		}
+
+		n = sess->rx_len - sess->rx_off;
+		if ( n > 7U ) {
+			n = 7U;
+		}
+
+		if ( rx_frame->DLC < n + 1U ) {
+			return;
+		} /*Malformed*/
+
+		memcpy(&sess->rx_buf[sess->rx_off], &d[1], n);
+		sess->rx_off += n;
+		sess->rx_sn   = (sess->rx_sn + 1U) & 0xFU;
+		sess->rx_deadline = now + TP_N_CR_US;
+
+		if ( sess->rx_off == sess->rx_len ) {
+			isca_tp_rx_done(sess, ISCA_CAN_OK);
+		}
+		else if ( sess->bs != 0U && --sess->rx_left == 0U ) {
+			sess->rx_left = sess->bs;
+			sess->fc_pend = TP_FC_CTS + 1U;
+		} /*Block complete*/
+		break;
+
+	default:
+		break;
+	}
+
+}
+
+/*Flow control frames, while waiting for one*/
+static void isca_tp_fc_frame(isca_tp_sess_s *sess, can_frame_s const *rx_frame, uint32_t now) {
+
+	uint8_t const *d = rx_frame->DATA;
+
+	if ( sess->tx_state != TP_TX_WAIT_FC || rx_frame->DLC < 3U ) {
+		return;
+	}
+
+	switch ( d[0] & 0xFU ) {
+
+	case TP_FC_CTS:
+		sess->tx_bs       = d[1];
+		sess->tx_left     = d[1];
+		sess->tx_stmin_us = isca_tp_stmin_us(d[2]);
+		sess->tx_wft      = 0U;
+		sess->tx_time     = now;
+		sess->tx_state    = TP_TX_CF;
+		break;
+
+	case TP_FC_WAIT:
+		if ( ++sess->tx_wft > TP_WFT_MAX ) {
+			isca_tp_tx_done(sess, ISCA_TP_WFT);
+		}
+		else {
+			sess->tx_time = now + TP_N_BS_US;
+		}
+		break;
+
+	case TP_FC_OVFLW:
+		isca_tp_tx_done(sess, ISCA_TP_OVFLW);
+		break;
+
+	default:
+		break;
+	}
+
+}
+
+/*Pending flow control, reception timeout, segmentation*/
+static void isca_tp_service(isca_tp_s *tp, isca_tp_sess_s *sess, uint32_t now) {
+
+	can_frame_s frame;
+
+	if ( sess->fc_pend != 0U ) {
+
+		isca_tp_frame(sess, &frame);
+		frame.DATA[0] = (uint8_t)((TP_PCI_FC << 4) | (sess->fc_pend - 1U));
+		frame.DATA[1] = sess->bs;
+		frame.DATA[2] = sess->stmin;
+
+		if ( isca_can_transmit_frame(tp->can_ctrl, &frame, CAN_REQ_NONBLOCKING) == ISCA_CAN_OK ) {
+			sess->fc_pend     = 0U;
+			sess->rx_deadline = now + TP_N_CR_US;
+		}
+	} /*Flow control first, the sender waits for it*/
+	else if ( sess->rx_state == TP_RX_CF && (int32_t)(now - sess->rx_deadline) >= 0 ) {
+		isca_tp_rx_done(sess, ISCA_CAN_TIMEOUT);
+	}
+
+	switch ( sess->tx_state ) {
+
+	case TP_TX_FIRST:
+		isca_tp_tx_first(tp, sess, now);
+		break;
+
+	case TP_TX_CF:
+		isca_tp_tx_cf(tp, sess, now);
+		break;
+
+	case TP_TX_WAIT_FC:
+		if ( (int32_t)(now - sess->tx_time) >= 0 ) {
+			isca_tp_tx_done(sess, ISCA_CAN_TIMEOUT);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+}
+
+/*Single or first frame; the first frame waits for flow control*/
+static void isca_tp_tx_first(isca_tp_s *tp, isca_tp_sess_s *sess, uint32_t now) {
+
+	can_frame_s frame;
+	uint32_t len = sess->tx_len;
+	uint32_t n;
+	uint8_t *d = frame.DATA;
+
+	isca_tp_frame(sess, &frame);
+
+	if ( len <= 7U ) {
+		d[0] = (uint8_t)((TP_PCI_SF << 4) | len);
+		n    = len;
+		memcpy(&d[1], sess->tx_buf, n);
+	}
+	else if ( len <= TP_FF_DL_MAX ) {
+		d[0] = (uint8_t)((TP_PCI_FF << 4) | (len >> 8));
+		d[1] = (uint8_t)len;
+		n    = 6U;
+		memcpy(&d[2], sess->tx_buf, n);
+	}
+	else {
+		d[0] = (uint8_t)(TP_PCI_FF << 4);
+		d[1] = 0U;
+		d[2] = (uint8_t)(len >> 24);
+		d[3] = (uint8_t)(len >> 16);
+		d[4] = (uint8_t)(len >> 8);
+		d[5] = (uint8_t)len;
+		n    = 2U;
+		memcpy(&d[6], sess->tx_buf, n);
+	} /*32-bit length escape*/
+
+	if ( isca_can_transmit_frame(tp->can_ctrl, &frame, CAN_REQ_NONBLOCKING) != ISCA_CAN_OK ) {
+		return;
+	} /*Retried on the next poll*/
+
+	sess->tx_off = n;
+
+	if ( len <= 7U ) {
+		isca_tp_tx_done(sess, ISCA_CAN_OK);
+	}
+	else {
+		sess->tx_sn    = 1U;
+		sess->tx_time  = now + TP_N_BS_US;
+		sess->tx_state = TP_TX_WAIT_FC;
+	}
+
+}
+
+/*Consecutive frames, while the TX buffer takes them, STmin and the block
+ *size allow*/
+static void isca_tp_tx_cf(isca_tp_s *tp, isca_tp_sess_s *sess, uint32_t now) {
+
+	can_frame_s frame;
+	uint32_t n;
+
+	while ( (int32_t)(now - sess->tx_time) >= 0 ) {
+
+		n = sess->tx_len - sess->tx_off;
+		if ( n > 7U ) {
+			n = 7U;
+		}
+
+		isca_tp_frame(sess, &frame);
+		frame.DATA[0] = (uint8_t)((TP_PCI_CF << 4) | sess->tx_sn);
+		memcpy(&frame.DATA[1], &sess->tx_buf[sess->tx_off], n);
+
+		if ( isca_can_transmit_frame(tp->can_ctrl, &frame, CAN_REQ_NONBLOCKING) != ISCA_CAN_OK ) {
+			break;
+		} /*Retried on the next poll*/
+
+		sess->tx_off += n;
+		sess->tx_sn   = (sess->tx_sn + 1U) & 0xFU;
+
+		if ( sess->tx_off == sess->tx_len ) {
+			isca_tp_tx_done(sess, ISCA_CAN_OK);
+			break;
+		}
+
+		if ( sess->tx_bs != 0U && --sess->tx_left == 0U ) {
+			sess->tx_time  = now + TP_N_BS_US;
+			sess->tx_state = TP_TX_WAIT_FC;
+			break;
+		} /*Block sent; wait for flow control*/
+
+		sess->tx_time = now + sess->tx_stmin_us;
+	}
+
+}
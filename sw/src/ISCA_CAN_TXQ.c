@@ -0,0 +1,331 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA_CAN arbitration ordered TX queue
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_TXQ.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_CAN_TXQ.c
+ *
+ * @brief Software TX queue served in CAN arbitration order
+ *
+ * Frames wait in a binary min-heap keyed on their arbitration field, so
+ * the frame that would win arbitration on the bus is always the next one
+ * written to the single TX buffer; frames with the same key leave in
+ * enqueue order. When preemption is enabled, pushing a frame that beats the
+ * one sitting in the TX buffer aborts the latter, which is requeued by
+ * \ref isca_txq_service once the controller releases the buffer.
+ *
+ * Frames pushed with a deadline are dropped once it passes, whether still
+ * queued or waiting in the TX buffer.
+ *
+ * Call \ref isca_txq_service from the TX complete interrupt, e.g., by
+ * installing \ref isca_txq_tx_hook as the controller's TX hook, or
+ * periodically when TX interrupts are off.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note The queue is not reentrant; if \ref isca_txq_service is called from
+ * interrupt context, mask the CAN interrupt around \ref isca_txq_push
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_TXQ.h"
+#include <string.h>
+
+/******
+ * PRIVATE FUNCTIONS DECLARATION
+ ******/
+static int  isca_txq_push_item(isca_txq_s *txq, can_frame_s const *tx_frame,
+                               uint32_t deadline, uint8_t dl_valid);
+static int  isca_txq_expired(isca_txq_item_s const *item, uint32_t now);
+static int  isca_txq_before(isca_txq_item_s const *a, isca_txq_item_s const *b);
+static void isca_txq_heap_push(isca_txq_s *txq, isca_txq_item_s const *item);
+static void isca_txq_heap_pop(isca_txq_s *txq, isca_txq_item_s *item);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize an arbitration ordered TX queue
+ * @param[out] txq      TX queue instance pointer
+ * @param[in]  can_ctrl Initialized CAN controller frames are sent from
+ * @param[in]  items    Heap storage, \p size items
+ * @param[in]  size     Queue capacity in frames
+ * @param[in]  preempt  \ref ISCA_TXQ_PREEMPT_ON or \ref ISCA_TXQ_PREEMPT_OFF
+ * @return     None
+ */
+void isca_txq_init(isca_txq_s *txq, can_ctrl_s *can_ctrl, isca_txq_item_s *items,
+                   uint32_t size, uint8_t preempt) {
+
+	memset(txq, 0, sizeof(isca_txq_s));
+	txq->can_ctrl = can_ctrl;
+	txq->heap     = items;
+	txq->size     = size;
+	txq->preempt  = preempt;
+
+}
+
+/**
+ * @brief      Queue a frame for transmission
+ * @param[in,out] txq    TX queue instance pointer
+ * @param[in]  tx_frame  Frame to send; copied into the queue
+ * @return     \ref ISCA_CAN_BUSY queue full
+ * @return     \ref ISCA_CAN_INV_DLC
+ * @return     \ref ISCA_CAN_OK
+ */
+int isca_txq_push(isca_txq_s *txq, can_frame_s const *tx_frame) {
+
+	return isca_txq_push_item(txq, tx_frame, 0U, 0U);
+
+}
+
+/**
+ * @brief      Queue a frame that must be sent by a deadline
+ * @param[in,out] txq    TX queue instance pointer
+ * @param[in]  tx_frame  Frame to send; copied into the queue
+ * @param[in]  deadline  Absolute deadline, in \ref ISCA_TIME_Us ticks
+ * @return     \ref ISCA_CAN_BUSY queue full
+ * @return     \ref ISCA_CAN_INV_DLC
+ * @return     \ref ISCA_CAN_OK
+ */
+int isca_txq_push_dl(isca_txq_s *txq, can_frame_s const *tx_frame, uint32_t deadline) {
+
+	return isca_txq_push_item(txq, tx_frame, deadline, 1U);
+
+}
+
+/**
+ * @brief      Retire the frame in the TX buffer and write the next one
+ *
+ * A frame found aborted (buffer released but transmission not complete) is
+ * requeued with its original order, as is a frame the TX buffer refuses
+ * because another writer on the controller took it first.
+ * @param[in,out] txq    TX queue instance pointer
+ * @return     1 if a frame was written to the TX buffer, 0 otherwise
+ */
+int isca_txq_service(isca_txq_s *txq) {
+
+	uint8_t  tx_st = isca_can_tx_status(txq->can_ctrl);
+	uint32_t now   = ISCA_TIME_Us();
+
+	if ( !(tx_st & CAN_TX_ST_BUF_FREE) ) {
+		if ( txq->inflight_valid && !txq->abort_req && isca_txq_expired(&txq->inflight, now) ) {
+			isca_can_abort_tx(txq->can_ctrl);
+			txq->abort_req = 1U;
+		} /*Frame in the TX buffer went stale*/
+		return 0;
+	} /*Controller still owns the TX buffer*/
+
+	if ( txq->inflight_valid ) {
+		if ( tx_st & CAN_TX_ST_COMPLETE ) {
+			txq->stats.sent++;
+		}
+		else if ( isca_txq_expired(&txq->inflight, now) ) {
+			txq->stats.expired++;
+		}
+		else {
+			isca_txq_heap_push(txq, &txq->inflight);
+			txq->stats.preempted++;
+		} /*Aborted*/
+		txq->inflight_valid = 0U;
+		txq->abort_req      = 0U;
+	} /*Retire the previous frame*/
+
+	do {
+		if ( txq->count == 0U ) {
+			return 0;
+		} /*Nothing to send*/
+
+		isca_txq_heap_pop(txq, &txq->inflight);
+
+		if ( !isca_txq_expired(&txq->inflight, now) ) {
+			break;
+		}
+		txq->stats.expired++;
+	} while (1); /*Skip stale frames*/
+
+	if ( isca_can_transmit_frame(txq->can_ctrl, &txq->inflight.frame, CAN_REQ_NONBLOCKING) != ISCA_CAN_OK ) {
+		isca_txq_heap_push(txq, &txq->inflight);
+		return 0;
+	} /*Another writer, e.g., the scheduler, took the TX buffer first; its completion is not ours*/
+
+	txq->inflight_valid = 1U;
+
+	return 1;
+}
+
+/**
+ * @brief      Controller TX hook serving a TX queue; install it with
+ *             can_ctrl->tx_hook = &isca_txq_tx_hook and
+ *             can_ctrl->tx_hook_arg = txq
+ * @param[in]  can_ctrl Controller whose TX buffer was released
+ * @param[in]  arg      TX queue instance pointer
+ * @return     None
+ */
+void isca_txq_tx_hook(can_ctrl_s *can_ctrl, void *arg) {
+
+	(void)can_ctrl;
+	isca_txq_service((isca_txq_s *)arg);
+
+}
+
+/**
+ * @brief      Compute a frame's arbitration key
+ *
+ * The key orders frames the way the bus arbitrates them: base ID first, then
+ * RTR/SRR, then IDE (standard beats extended), then the ID extension, then
+ * RTR of extended frames. Lower keys win.
+ * @param[in]  frame  CAN frame struct pointer
+ * @return     Arbitration key
+ */
+uint32_t isca_txq_arb_key(can_frame_s const *frame) {
+
+	if ( frame->IDE == CAN_FRAME_EXT ) {
+		return (((frame->ID >> 18U) & 0x7FFU) << 21U) | /*base ID*/
+		       (1UL << 20U)                           | /*SRR, recessive*/
+		       (1UL << 19U)                           | /*IDE, recessive*/
+		       ((frame->ID & 0x3FFFFU) << 1U)         | /*ID extension*/
+		       (frame->RTR & 0x1U);
+	} /*29-bit ID*/
+
+	return ((frame->ID & 0x7FFU) << 21U) | ((uint32_t)(frame->RTR & 0x1U) << 20U);
+
+}
+
+/******
+ * PRIVATE FUNCTIONS DEFINITION
+ ******/
+/*Queue a frame; preempt the TX buffer if the new frame beats it*/
+static int isca_txq_push_item(isca_txq_s *txq, can_frame_s const *tx_frame,
+                              uint32_t deadline, uint8_t dl_valid) {
+
+	isca_txq_item_s item;
+
+	if ( tx_frame->DLC > 8U ) {
+		return ISCA_CAN_INV_DLC;
+	} /*Payload does not fit a frame*/
+
+	if ( txq->count + txq->inflight_valid >= txq->size ) {
+		txq->stats.rejected++;
+		return ISCA_CAN_BUSY;
+	} /*Queue full; a slot stays reserved for requeueing the TX buffer's frame*/
+
+	item.key = isca_txq_arb_key(tx_frame);
+	item.seq = txq->seq++;
+	item.deadline = deadline;
+	item.dl_valid = dl_valid;
+	memcpy(&item.frame, tx_frame, sizeof(can_frame_s));
+	isca_txq_heap_push(txq, &item);
+	txq->stats.queued++;
+
+	if ( txq->preempt == ISCA_TXQ_PREEMPT_ON && txq->inflight_valid &&
+	     !txq->abort_req && item.key < txq->inflight.key ) {
+		isca_can_abort_tx(txq->can_ctrl);
+		txq->abort_req = 1U;
+	} /*Higher priority frame waits behind the TX buffer; abort it*/
+
+	isca_txq_service(txq);
+
+	return ISCA_CAN_OK;
+}
+
+/*Deadline passed?*/
+static int isca_txq_expired(isca_txq_item_s const *item, uint32_t now) {
+
+	return item->dl_valid && (int32_t)(now - item->deadline) >= 0;
+
+}
+
+/*Heap order: arbitration key, then enqueue order*/
+static int isca_txq_before(isca_txq_item_s const *a, isca_txq_item_s const *b) {
+
+	if ( a->key != b->key ) {
+		return a->key < b->key;
+	}
+
+	return (int32_t)(a->seq - b->seq) < 0;
+}
+
+static void isca_txq_heap_push(isca_txq_s *txq, isca_txq_item_s const *item) {
+
+	uint32_t i = txq->count++;
+	uint32_t parent;
+
+	while ( i > 0U ) {
+		parent = (i - 1U) >> 1U;
+		if ( !isca_txq_before(item, &txq->heap[parent]) ) {
+			break;
+		}
+		txq->heap[i] = txq->heap[parent];
+		i = parent;
+	} /*Sift up*/
+
+	txq->heap[i] = *item;
+
+}
+
+static void isca_txq_heap_pop(isca_txq_s *txq, isca_txq_item_s *item) {
+
+	uint32_t i = 0U;
+	uint32_t child;
+	isca_txq_item_s last;
+
+	*item = txq->heap[0];
+	last  = txq->heap[--txq->count];
+
+	while ( (child = (i << 1U) + 1U) < txq->count ) {
+		if ( child + 1U < txq->count && isca_txq_before(&txq->heap[child+1U], &txq->heap[child]) ) {
+			child++;
+		}
+		if ( !isca_txq_before(&txq->heap[child], &last) ) {
+			break;
+		}
+		txq->heap[i] = txq->heap[child];
+		i = child;
+	} /*Sift down*/
+
+	txq->heap[i] = last;
+
+}
@@ -0,0 +1,394 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA CAN submission/completion rings
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_CAN_URING.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+/**
+ * @file ISCA_CAN_URING.c
+ *
+ * @brief Asynchronous CAN I/O through submission/completion ring pairs
+ *
+ * The server keeps a copy of every request in flight, so submission slots
+ * are recycled on intake. Each \ref isca_uring_service pass takes new
+ * submissions, tries the oldest pending TX request of every controller,
+ * drains the controllers' RX queues into the oldest matching RX requests,
+ * expires deadlines and posts the completed requests while their CQ has
+ * room; completions may so be posted out of submission order.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note The server owns the RX queues of the attached controllers, and is
+ * not thread safe; run it from one context, e.g., the daemon's poll loop
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_CAN_URING.h"
+#include "ISCA_CAN_API.h"
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static void isca_uring_intake(isca_uring_srv_s *srv, uint8_t r, uint32_t budget, uint32_t now);
+static void isca_uring_rx(isca_uring_srv_s *srv, uint8_t c, can_frame_s const *rx_frame, uint32_t now);
+static uint32_t isca_uring_post(isca_uring_srv_s *srv);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/*-----
+ * APPLICATION SIDE
+ *----*/
+/**
+ * @brief      Initialize an empty ring pair; done once by its creator
+ * @param[out] ring  Ring pair, e.g., in a shared memory segment
+ * @return     None
+ */
+void isca_uring_init(isca_uring_s *ring) {
+
+	memset(ring, 0, sizeof(isca_uring_s));
+
+}
+
+/**
+ * @brief      Submission entry to fill
+ * @param[in]  ring  Ring pair
+ * @param[in]  i     Entry index after the last submitted one; fill entries
+ *                   0 to n - 1, then \ref isca_uring_submit n
+ * @return     Submission entry, NULL if the submission ring is full
+ */
+isca_uring_sqe_s *isca_uring_get_sqe(isca_uring_s *ring, uint32_t i) {
+
+	uint32_t tail = ring->sq_tail;
+
+	if ( tail + i - __atomic_load_n(&ring->sq_head, __ATOMIC_ACQUIRE) >= URING_SQ_ENTRIES ) {
+		return NULL;
+	} /*Full*/
+
+	return &ring->sqes[(tail + i) & (URING_SQ_ENTRIES - 1U)];
+}
+
+/**
+ * @brief      Publish the filled submission entries
+ * @param[in]  ring  Ring pair
+ * @param[in]  n     Amount of entries filled through \ref isca_uring_get_sqe
+ * @return     None
+ */
+void isca_uring_submit(isca_uring_s *ring, uint32_t n) {
+
+	__atomic_store_n(&ring->sq_tail, ring->sq_tail + n, __ATOMIC_RELEASE);
+
+}
+
+/**
+ * @brief      Completions ready, read in place with \ref isca_uring_cqe_at
+ * @param[in]  ring  Ring pair
+ * @param[out] first Position of the oldest completion
+ * @return     Amount of completions ready
+ */
+uint32_t isca_uring_peek_cq(isca_uring_s *ring, uint32_t *first) {
+
+	*first = ring->cq_head;
+
+	return __atomic_load_n(&ring->cq_tail, __ATOMIC_ACQUIRE) - *first;
+}
+
+/**
+ * @brief      Recycle peeked completions
+ * @param[in]  ring  Ring pair
+ * @param[in]  n     Amount of completions consumed
+ * @return     None
+ */
+void isca_uring_cq_advance(isca_uring_s *ring, uint32_t n) {
+
+	__atomic_store_n(&ring->cq_head, ring->cq_head + n, __ATOMIC_RELEASE);
+
+}
+
+/**
+ * @brief      Copy out and recycle up to max completions
+ * @param[in]  ring  Ring pair
+ * @param[out] cqes  Completions
+ * @param[in]  max   Capacity of cqes
+ * @return     Amount of completions reaped
+ */
+uint32_t isca_uring_reap(isca_uring_s *ring, isca_uring_cqe_s *cqes, uint32_t max) {
+
+	uint32_t first;
+	uint32_t n = isca_uring_peek_cq(ring, &first);
+	uint32_t i;
+
+	if ( n > max ) {
+		n = max;
+	}
+
+	for ( i = 0U; i < n; i++ ) {
+		cqes[i] = *isca_uring_cqe_at(ring, first + i);
+	}
+
+	isca_uring_cq_advance(ring, n);
+
+	return n;
+}
+
+/*-----
+ * SERVER SIDE
+ *----*/
+/**
+ * @brief      Initialize a ring server without rings or controllers
+ * @param[out] srv   Ring server
+ * @return     None
+ */
+void isca_uring_srv_init(isca_uring_srv_s *srv) {
+
+	memset(srv, 0, sizeof(isca_uring_srv_s));
+
+}
+
+/**
+ * @brief      Serve a controller
+ * @param[in]  srv      Ring server
+ * @param[in]  can_ctrl Controller, initialized with \ref lbr_isca_can_init
+ * @return     Controller index, for \ref isca_uring_sqe_s.ctrl
+ * @return     \ref ISCA_URING_FULL
+ */
+int isca_uring_srv_attach(isca_uring_srv_s *srv, can_ctrl_s *can_ctrl) {
+
+	if ( srv->n_ctrl >= URING_MAX_CTRL ) {
+		return ISCA_URING_FULL;
+	}
+
+	srv->ctrl[srv->n_ctrl] = can_ctrl;
+
+	return (int)srv->n_ctrl++;
+}
+
+/**
+ * @brief      Serve a ring pair
+ * @param[in]  srv   Ring server
+ * @param[in]  ring  Ring pair, initialized with \ref isca_uring_init
+ * @return     \ref ISCA_CAN_OK
+ * @return     \ref ISCA_URING_FULL
+ */
+int isca_uring_srv_add_ring(isca_uring_srv_s *srv, isca_uring_s *ring) {
+
+	if ( srv->n_ring >= URING_MAX_RINGS ) {
+		return ISCA_URING_FULL;
+	}
+
+	srv->ring[srv->n_ring++] = ring;
+
+	return ISCA_CAN_OK;
+}
+
+/**
+ * @brief      One server pass: take submissions, transmit, receive, expire
+ *             and post completions
+ * @param[in]  srv     Ring server
+ * @param[in]  budget  Most submissions taken per ring and frames received
+ *                     per controller
+ * @return     Amount of completions posted
+ */
+uint32_t isca_uring_service(isca_uring_srv_s *srv, uint32_t budget) {
+
+	isca_uring_pend_s *p;
+	can_frame_s frame;
+	uint32_t now = ISCA_TIME_Us();
+	uint32_t tx_tried = 0U;
+	uint32_t i;
+	uint8_t  c;
+
+	for ( c = 0U; c < srv->n_ring; c++ ) {
+		isca_uring_intake(srv, c, budget, now);
+	} /*Submissions*/
+
+	for ( i = 0U; i < srv->n_pend; i++ ) {
+
+		p = &srv->pend[i];
+
+		if ( p->done || p->sqe.opcode != ISCA_URING_OP_TX || (tx_tried & (1UL << p->sqe.ctrl)) != 0U ) {
+			continue;
+		}
+
+		tx_tried |= (1UL << p->sqe.ctrl);
+		isca_can_frame_unpack(&frame, &p->sqe.frame);
+		if ( isca_can_transmit_frame(srv->ctrl[p->sqe.ctrl], &frame, CAN_REQ_NONBLOCKING) == ISCA_CAN_OK ) {
+			p->done = 1U;
+			p->res  = ISCA_CAN_OK;
+			p->ts   = ISCA_TIME_Us();
+		}
+	} /*Oldest TX request of every controller*/
+
+	for ( c = 0U; c < srv->n_ctrl; c++ ) {
+		for ( i = 0U; i < budget; i++ ) {
+			if ( lbr_isca_can_receive_pkt_tmo(srv->ctrl[c], &frame, 0U) < 0 ) {
+				break;
+			} /*Drained*/
+			isca_uring_rx(srv, c, &frame, ISCA_TIME_Us());
+		}
+	} /*RX requests*/
+
+	now = ISCA_TIME_Us();
+	for ( i = 0U; i < srv->n_pend; i++ ) {
+		p = &srv->pend[i];
+		if ( !p->done && p->sqe.timeout_us != ISCA_CAN_WAIT_FOREVER &&
+		     (int32_t)(now - p->deadline) >= 0 ) {
+			p->done = 1U;
+			p->res  = ISCA_CAN_TIMEOUT;
+			p->ts   = now;
+		}
+	} /*Deadlines*/
+
+	return isca_uring_post(srv);
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*Copy a ring's new submissions into the pending list, recycling their slots*/
+static void isca_uring_intake(isca_uring_srv_s *srv, uint8_t r, uint32_t budget, uint32_t now) {
+
+	isca_uring_s *ring = srv->ring[r];
+	isca_uring_pend_s *p;
+	uint32_t head = ring->sq_head;
+	uint32_t tail = __atomic_load_n(&ring->sq_tail, __ATOMIC_ACQUIRE);
+
+	while ( head != tail && budget-- != 0U && srv->n_pend < URING_PENDING ) {
+
+		p = &srv->pend[srv->n_pend++];
+		p->sqe      = ring->sqes[head & (URING_SQ_ENTRIES - 1U)];
+		p->ring     = r;
+		p->deadline = now + p->sqe.timeout_us;
+		p->done     = 0U;
+		p->held     = 0U;
+		p->ts       = now;
+		/*Only RX completions carry a frame; never leak an earlier request's, maybe another ring's*/
+		memset(&p->frame, 0, sizeof(can_cframe_s));
+
+		if ( p->sqe.opcode == ISCA_URING_OP_NOP ) {
+			p->done = 1U;
+			p->res  = ISCA_CAN_OK;
+		}
+		else if ( (p->sqe.opcode != ISCA_URING_OP_TX && p->sqe.opcode != ISCA_URING_OP_RX) ||
+		          p->sqe.ctrl >= srv->n_ctrl ) {
+			p->done = 1U;
+			p->res  = ISCA_CAN_INV_PARAM;
+		} /*Unknown request or controller*/
+		else if ( p->sqe.opcode == ISCA_URING_OP_RX ) {
+			p->sqe.id &= p->sqe.mask;
+		}
+
+		head++;
+	}
+
+	__atomic_store_n(&ring->sq_head, head, __ATOMIC_RELEASE);
+
+}
+
+/*Complete the oldest RX request matching a received frame*/
+static void isca_uring_rx(isca_uring_srv_s *srv, uint8_t c, can_frame_s const *rx_frame, uint32_t now) {
+
+	isca_uring_pend_s *p;
+	uint32_t i;
+
+	for ( i = 0U; i < srv->n_pend; i++ ) {
+		p = &srv->pend[i];
+		if ( !p->done && p->sqe.opcode == ISCA_URING_OP_RX && p->sqe.ctrl == c &&
+		     (rx_frame->ID & p->sqe.mask) == p->sqe.id ) {
+			isca_can_frame_pack(&p->frame, rx_frame);
+			p->done = 1U;
+			p->res  = ISCA_CAN_OK;
+			p->ts   = now;
+			return;
+		}
+	}
+
+	srv->strays++;
+
+}
+
+/*Post completed requests while their CQ has room; compacts the pending list*/
+static uint32_t isca_uring_post(isca_uring_srv_s *srv) {
+
+	isca_uring_pend_s *p;
+	isca_uring_s *ring;
+	isca_uring_cqe_s *cqe;
+	uint32_t posted = 0U;
+	uint32_t i;
+	uint32_t k = 0U;
+
+	for ( i = 0U; i < srv->n_pend; i++ ) {
+
+		p = &srv->pend[i];
+
+		if ( p->done ) {
+
+			ring = srv->ring[p->ring];
+
+			if ( ring->cq_tail - __atomic_load_n(&ring->cq_head, __ATOMIC_ACQUIRE) < URING_CQ_ENTRIES ) {
+				cqe = &ring->cqes[ring->cq_tail & (URING_CQ_ENTRIES - 1U)];
+				cqe->user_data = p->sqe.user_data;
+				cqe->res       = p->res;
+				cqe->ts        = p->ts;
+				cqe->frame     = p->frame;
+				__atomic_store_n(&ring->cq_tail, ring->cq_tail + 1U, __ATOMIC_RELEASE);
+				posted++;
+				continue;
+			} /*Posted, drop from the pending list*/
+
+			if ( !p->held ) {
+				p->held = 1U;
+				ring->cq_overflow++;
+			} /*Once per completion, not per pass*/
+		} /*Completed*/
+
+		if ( k != i ) {
+			srv->pend[k] = *p;
+		}
+		k++;
+	}
+
+	srv->n_pend = k;
+
+	return posted;
+}
@@ -0,0 +1,270 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA static frame pool
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_FRAME_POOL.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_FRAME_POOL.c
+ *
+ * @brief Static, compile-time sized storage pool for the RX queues
+ *
+ * The pool is a single cache line aligned array of \ref FRAME_POOL_FRAMES
+ * frames, managed as a buddy system: blocks are power of two frames long,
+ * matching the power of two queue capacities, and a released block is
+ * merged back with its free buddy. Allocation and release take at most
+ * log2(\ref FRAME_POOL_FRAMES) steps; no heap is used.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ * @note Not reentrant; allocate and release from thread context, e.g.,
+ * during controller initialization
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_FRAME_POOL.h"
+#include <string.h>
+
+/******
+ * DEFINITIONS
+ ******/
+#if (FRAME_POOL_FRAMES & (FRAME_POOL_FRAMES - 1U)) != 0
+#error "FRAME_POOL_FRAMES must be a power of two"
+#endif
+
+#define FP_MAX_ORDERS   (32U)          /*!<Free lists, one per block order*/
+#define FP_FREE         (0x80U)        /*!<Block state: free flag*/
+#define FP_NONE         (0xFFFFFFFFU)  /*!<Free list terminator*/
+
+/// Free block links, stored in the block's first frame
+typedef struct {
+	uint32_t prev;
+	uint32_t next;
+} fp_link_s;
+
+/******
+ * VARIABLES
+ ******/
+static can_cframe_s pool[FRAME_POOL_FRAMES] __attribute__ ((aligned (CACHE_LINE_SIZE)));
+/// Per frame block state; valid at block heads only: order | \ref FP_FREE
+static uint8_t  blk_state[FRAME_POOL_FRAMES];
+static uint32_t free_head[FP_MAX_ORDERS];
+static uint8_t  pool_order;
+static uint8_t  pool_ready = 0U;
+static isca_frame_pool_stats_s pool_stats;
+
+/******
+ * LOCAL FUNCTIONS DECLARATION
+ ******/
+static void fp_init(void);
+static void fp_push(uint32_t blk, uint8_t order);
+static void fp_remove(uint32_t blk, uint8_t order);
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Allocate a block of contiguous frames
+ * @param[in]  frames  Amount of frames; rounded up to a power of two
+ * @retval     Cache line aligned block, if at least 4 frames long
+ * @retval     NULL if the pool can not satisfy the request
+ */
+can_cframe_s *isca_frame_pool_alloc(uint32_t frames) {
+
+	uint8_t  order = 0U;
+	uint8_t  k;
+	uint32_t blk;
+
+	if ( !pool_ready ) {
+		fp_init();
+	}
+
+	while ( order <= pool_order && (1UL << order) < frames ) {
+		order++;
+	} /*Smallest order that fits*/
+
+	for ( k = order; k <= pool_order && free_head[k] == FP_NONE; k++ ) {
+	} /*Smallest free block that fits*/
+
+	if ( frames == 0U || k > pool_order ) {
+		pool_stats.failed++;
+		return NULL;
+	} /*Pool exhausted or fragmented*/
+
+	blk = free_head[k];
+	fp_remove(blk, k);
+
+	while ( k > order ) {
+		k--;
+		fp_push(blk + (1UL << k), k);
+	} /*Split, keep the lower half*/
+
+	blk_state[blk] = order;
+
+	pool_stats.in_use += (1UL << order);
+	if ( pool_stats.in_use > pool_stats.high_water ) {
+		pool_stats.high_water = pool_stats.in_use;
+	}
+
+	return &pool[blk];
+}
+
+/**
+ * @brief      Release a block returned by \ref isca_frame_pool_alloc
+ * @param[in]  block  Block pointer; NULL is ignored
+ * @return     None
+ */
+void isca_frame_pool_free(can_cframe_s *block) {
+
+	uint32_t blk;
+	uint32_t buddy;
+	uint8_t  order;
+
+	if ( block == NULL ) {
+		return;
+	}
+
+	blk   = (uint32_t)(block - pool);
+	order = blk_state[blk];
+	pool_stats.in_use -= (1UL << order);
+
+	while ( order < pool_order ) {
+		buddy = blk ^ (1UL << order);
+		if ( blk_state[buddy] != (FP_FREE | order) ) {
+			break;
+		}
+		fp_remove(buddy, order);
+		blk &= ~(1UL << order);
+		order++;
+	} /*Merge with free buddies*/
+
+	fp_push(blk, order);
+
+}
+
+/**
+ * @brief      Pool statistics; size the pool from the high water mark
+ * @param[out] stats  Statistics
+ * @return     None
+ */
+void isca_frame_pool_stats(isca_frame_pool_stats_s *stats) {
+
+	if ( !pool_ready ) {
+		fp_init();
+	}
+
+	memcpy(stats, &pool_stats, sizeof(isca_frame_pool_stats_s));
+
+}
+
+/******
+ * LOCAL FUNCTIONS DEFINITION
+ ******/
+/*The whole pool is a single free block*/
+static void fp_init(void) {
+
+	uint8_t k;
+
+	for ( k = 0U; k < FP_MAX_ORDERS; k++ ) {
+		free_head[k] = FP_NONE;
+	}
+
+	for ( pool_order = 0U; (1UL << pool_order) < FRAME_POOL_FRAMES; pool_order++ ) {
+	}
+
+	memset(&pool_stats, 0, sizeof(pool_stats));
+	pool_stats.size = FRAME_POOL_FRAMES;
+
+	fp_push(0U, pool_order);
+	pool_ready = 1U;
+
+}
+
+/*Link a free block at the head of its order's free list*/
+static void fp_push(uint32_t blk, uint8_t order) {
+
+	fp_link_s link;
+	fp_link_s next;
+
+	link.prev = FP_NONE;
+	link.next = free_head[order];
+
+	if ( link.next != FP_NONE ) {
+		memcpy(&next, &pool[link.next], sizeof(fp_link_s));
+		next.prev = blk;
+		memcpy(&pool[link.next], &next, sizeof(fp_link_s));
+	}
+
+	memcpy(&pool[blk], &link, sizeof(fp_link_s));
+	free_head[order] = blk;
+	blk_state[blk]   = FP_FREE | order;
+
+}
+
+/*Unlink a free block from its order's free list*/
+static void fp_remove(uint32_t blk, uint8_t order) {
+
+	fp_link_s link;
+	fp_link_s other;
+
+	memcpy(&link, &pool[blk], sizeof(fp_link_s));
+
+	if ( link.prev != FP_NONE ) {
+		memcpy(&other, &pool[link.prev], sizeof(fp_link_s));
+		other.next = link.next;
+		memcpy(&pool[link.prev], &other, sizeof(fp_link_s));
+	}
+	else {
+		free_head[order] = link.next;
+	}
+
+	if ( link.next != FP_NONE ) {
+		memcpy(&other, &pool[link.next], sizeof(fp_link_s));
+		other.prev = link.prev;
+		memcpy(&pool[link.next], &other, sizeof(fp_link_s));
+	}
+
+	blk_state[blk] = order;
+
+}
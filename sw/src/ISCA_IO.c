@@ -57,6 +57,10 @@
  ******/
 #include "ISCA_IO.h"
 
+#if defined(__linux__)
+#include <time.h>
+#endif
+
 /******
  * FUNCTIONS DEFINITION
  ******/
@@ -71,3 +75,27 @@ ISCA_FPGA_Read8Bit(size_t const address_ptr)
 {
 	return *((volatile uint8_t *)address_ptr);
 }
+
+/**
+ * @brief  Free running microseconds counter
+ *
+ * Time base of the TX/RX deadlines; it is expected to wrap around at
+ * 2^32 us
+ * @return Current time in microseconds
+ * */
+uint32_t ISCA_TIME_Us(void)
+{
+#if defined(__linux__)
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec*1000000U + (uint64_t)ts.tv_nsec/1000U);
+#else
+	/* USER CODE
+	 * Return your board's free running microseconds counter, e.g., a 1MHz
+	 * timer's counter register. Deadlines never expire while 0 is returned
+	 */
+	return 0U;
+	/* END USER CODE*/
+#endif
+}
@@ -0,0 +1,188 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA lock-free MPMC frame queue
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_MPMC_QUEUE.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_MPMC_QUEUE.c
+ *
+ * @brief Bounded lock-free multi-producer/multi-consumer frame queue
+ *
+ * An alternative to the single-producer/single-consumer queues of
+ * \ref ISCA_QUEUE_INDEXER.h, for worker pools: several decoder threads
+ * draining the RX stream, or several producers feeding one transmitter.
+ *
+ * Every cell carries a sequence number. A producer owns the cell at its
+ * position when the sequence equals the position, and hands it over by
+ * storing position + 1; a consumer owns it at position + 1 and hands it
+ * back by storing position + capacity. Producers and consumers only contend
+ * on their own counter, with a single compare-and-swap per operation, and
+ * never on each other's.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_MPMC_QUEUE.h"
+#include "ISCA_QUEUE_INDEXER.h"
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize a queue over caller provided cells
+ * @param[out] q     Queue
+ * @param[in]  cells Cells storage
+ * @param[in]  size  Amount of cells, a power of two, at least 2
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_OCCUPIED on invalid size
+ */
+int isca_mpmc_init(isca_mpmc_s *q, isca_mpmc_cell_s *cells, uint32_t size) {
+
+	uint32_t i;
+
+	if ( size < 2U || (size & (size - 1U)) != 0U ) {
+		return DQ_OCCUPIED;
+	} /*No such queue*/
+
+	for ( i = 0U; i < size; i++ ) {
+		cells[i].seq = i;
+	}
+
+	q->cells = cells;
+	q->mask  = size - 1U;
+	__atomic_store_n(&q->enq_pos, 0U, __ATOMIC_RELAXED);
+	__atomic_store_n(&q->deq_pos, 0U, __ATOMIC_RELEASE);
+
+	return DQ_OK;
+}
+
+/**
+ * @brief      Queue a frame; safe from any amount of producer threads
+ * @param[in]  q     Queue
+ * @param[in]  frame Frame
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_FULL
+ */
+int isca_mpmc_push(isca_mpmc_s *q, can_cframe_s const *frame) {
+
+	isca_mpmc_cell_s *cell;
+	uint32_t pos = __atomic_load_n(&q->enq_pos, __ATOMIC_RELAXED);
+	int32_t  dif;
+
+	for (;;) {
+		cell = &q->cells[pos & q->mask];
+		dif  = (int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - pos);
+
+		if ( dif == 0 ) {
+			if ( __atomic_compare_exchange_n(&q->enq_pos, &pos, pos + 1U, 1,
+			                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) {
+				break;
+			}
+		} /*Cell free; claim it, pos reloaded on failure*/
+		else if ( dif < 0 ) {
+			return DQ_FULL;
+		} /*Cell still holds the frame of the previous lap*/
+		else {
+			pos = __atomic_load_n(&q->enq_pos, __ATOMIC_RELAXED);
+		} /*Another producer claimed it*/
+	}
+
+	cell->frame = *frame;
+	__atomic_store_n(&cell->seq, pos + 1U, __ATOMIC_RELEASE);
+
+	return DQ_OK;
+}
+
+/**
+ * @brief      Take the oldest frame; safe from any amount of consumer threads
+ * @param[in]  q     Queue
+ * @param[out] frame Frame
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_EMPTY
+ */
+int isca_mpmc_pop(isca_mpmc_s *q, can_cframe_s *frame) {
+
+	isca_mpmc_cell_s *cell;
+	uint32_t pos = __atomic_load_n(&q->deq_pos, __ATOMIC_RELAXED);
+	int32_t  dif;
+
+	for (;;) {
+		cell = &q->cells[pos & q->mask];
+		dif  = (int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - (pos + 1U));
+
+		if ( dif == 0 ) {
+			if ( __atomic_compare_exchange_n(&q->deq_pos, &pos, pos + 1U, 1,
+			                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) {
+				break;
+			}
+		} /*Cell filled; claim it, pos reloaded on failure*/
+		else if ( dif < 0 ) {
+			return DQ_EMPTY;
+		} /*Cell not filled yet*/
+		else {
+			pos = __atomic_load_n(&q->deq_pos, __ATOMIC_RELAXED);
+		} /*Another consumer claimed it*/
+	}
+
+	*frame = cell->frame;
+	__atomic_store_n(&cell->seq, pos + q->mask + 1U, __ATOMIC_RELEASE);
+
+	return DQ_OK;
+}
+
+/**
+ * @brief      Queue occupancy; a snapshot while producers or consumers run
+ * @param[in]  q Queue
+ * @retval     Amount of claimed cells
+ */
+uint32_t isca_mpmc_count(isca_mpmc_s *q) {
+
+	uint32_t deq = __atomic_load_n(&q->deq_pos, __ATOMIC_ACQUIRE);
+	uint32_t enq = __atomic_load_n(&q->enq_pos, __ATOMIC_ACQUIRE);
+
+	return enq - deq;
+
+}
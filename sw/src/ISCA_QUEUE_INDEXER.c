@@ -49,7 +49,32 @@
  *
  * @version 1.0
  *
- * @todo Implement lock mechanisms for multi-threaded environments
+ * Queue capacities are rounded up to a power of two; read and write
+ * pointers are free running 32-bit counters, masked to index a slot, so
+ * every slot is usable and the occupancy is their difference.
+ *
+ * Queues are referred to by handles carrying the registry index and a
+ * generation counter; the generation moves on every release, so a stale
+ * handle is refused instead of touching a queue re-acquired by someone
+ * else. Free registry entries are kept in a free list, so acquire and
+ * release are O(1).
+ *
+ * Each queue has an overflow policy, \ref DQ_DROP_NEWEST, \ref DQ_DROP_OLDEST
+ * or \ref DQ_BLOCK. Dropping the oldest element advances the read counter from
+ * the producer side, so the read counter is only ever moved with a
+ * compare-and-swap; drops are counted atomically, so the counter may be read
+ * from any context.
+ *
+ * Batches are claimed as up to two contiguous spans, split at the wrap
+ * point: a producer reserves slots, fills them and commits them with a
+ * single counter update; a consumer peeks slots, copies them and releases
+ * them. Elements are published only after being written and recycled only
+ * after being read.
+ *
+ * Registry acquire and release are serialised by a spinlock, so queues may
+ * be acquired and released from several threads. Each queue has a single
+ * producer and a single consumer; worker pools with several producers or
+ * consumers use \ref ISCA_MPMC_QUEUE.h instead.
  *
  */
 
@@ -57,30 +82,42 @@
  * HEADERS
  ******/
 #include "ISCA_QUEUE_INDEXER.h"
+#include <stddef.h>
 
 /******
  * DEFINITIONS
  ******/
 typedef struct {
-	uint8_t rd_ptr;
-	uint8_t wr_ptr;
+	uint32_t rd_ptr;   /*!<Free running read counter*/
+	uint32_t wr_ptr;   /*!<Free running write counter*/
+	uint32_t mask;     /*!<Capacity - 1*/
+	uint32_t drops;    /*!<Elements lost to the overflow policy*/
+	uint8_t  policy;   /*!<Overflow policy, e.g., \ref DQ_DROP_NEWEST*/
+	uint16_t gen;      /*!<Generation of the handle currently valid*/
+	uint16_t next;     /*!<Next free entry, or \ref DQ_INUSE*/
 } isca_data_queue_indexer;
 
+#define DQ_MAX_SLOTS    (0x80000000UL) /*!<Largest power of two capacity*/
+#define DQ_NIL          (0xFFFFU)      /*!<Free list terminator*/
+#define DQ_INUSE        (0xFFFEU)      /*!<\ref isca_data_queue_indexer.next of acquired entries*/
+#define DQ_H_INDEX(h)   ((h) & 0xFFFFU)          /*!<Handle to registry index*/
+#define DQ_H_GEN(h)     ((uint16_t)((h) >> 16U)) /*!<Handle to generation*/
+
 /******
  * VARIABLES
  ******/
-//TODO: implement lock for multi-threaded environment
-static volatile uint32_t available_queues = 0U;
-//TODO: use it as mutex to access&modify available_queues
-//static volatile uint8_t queues_lock;
-static volatile uint8_t queue_slots[MAX_QUEUES];
 static volatile isca_data_queue_indexer queue[MAX_QUEUES];
+static uint16_t free_head;
+static uint8_t  registry_ready = 0U;
+static volatile uint8_t registry_lock = 0U;
 
 /******
  * LOCAL FUNCTIONS DECLARATION
  ******/
 void queue_lock_acquire();
 void queue_lock_release();
+static volatile isca_data_queue_indexer *queue_lookup(isca_qhandle_t q_handle);
+static void queue_span(volatile isca_data_queue_indexer *q, uint32_t pos, uint32_t n, isca_qspan_s *span);
 
 /******
  * FUNCTIONS DEFINITION
@@ -88,42 +125,85 @@ void queue_lock_release();
 /**
  * @brief      Generic queue (ring buffer) indexer
  * @note       The queue to store data is not allocated here; only queue indexing is provided
- * @param[in]  q_slots the amount of slots the new queue shall have
- * @retval     Acquired queue index
+ * @param[in]  q_slots the amount of slots the new queue shall have; rounded
+ *             up to a power of two, see \ref isca_queue_size
+ * @param[in]  q_policy Overflow policy, \ref DQ_DROP_NEWEST, \ref DQ_DROP_OLDEST
+ *             or \ref DQ_BLOCK
+ * @param[out] q_handle Acquired queue handle
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_OCCUPIED
  */
-int isca_queue_acquire(uint8_t const q_slots) {
-
-	int i;
-
-	//find an available queue indexer
-	for ( i = 0; i < MAX_QUEUES; i++ ) {
-		if ( ( ( available_queues >> i ) & 1U ) == 0U ) {
-			available_queues |= ( 1U << i ); //reserve the queue
-			/*Update acquired queue info*/
-			queue_slots[i]    = q_slots;
-			queue[i].rd_ptr   = 0U;
-			queue[i].wr_ptr   = 0U;
-			return i;
-		} /*queue occupied*/
-	}
+int isca_queue_acquire(uint32_t const q_slots, uint8_t const q_policy, isca_qhandle_t *q_handle) {
+
+	uint16_t i;
+	uint32_t slots = 1U;
+
+	if ( q_slots == 0U || q_slots > DQ_MAX_SLOTS || q_policy > DQ_BLOCK ) {
+		return DQ_OCCUPIED;
+	} /*No such queue*/
 
-	//TODO: return a hash of the queue and match it internally with the queue's index
-	//      in this way only
-	/*return the acquired queue*/
-	return DQ_OCCUPIED;
+	while ( slots < q_slots ) {
+		slots <<= 1U;
+	} /*Round up to a power of two*/
+
+	queue_lock_acquire();
+
+	if ( !registry_ready ) {
+		for ( i = 0U; i < MAX_QUEUES; i++ ) {
+			queue[i].gen  = 1U;
+			queue[i].next = (i + 1U < MAX_QUEUES) ? (uint16_t)(i + 1U) : DQ_NIL;
+		}
+		free_head = 0U;
+		registry_ready = 1U;
+	} /*First use; chain all entries*/
+
+	i = free_head;
+	if ( i == DQ_NIL ) {
+		queue_lock_release();
+		return DQ_OCCUPIED;
+	} /*Registry exhausted*/
+
+	free_head = queue[i].next;
+
+	/*Update acquired queue info*/
+	queue[i].mask   = slots - 1U;
+	queue[i].rd_ptr = 0U;
+	queue[i].wr_ptr = 0U;
+	queue[i].drops  = 0U;
+	queue[i].policy = q_policy;
+	queue[i].next   = DQ_INUSE;
+	*q_handle = ((isca_qhandle_t)queue[i].gen << 16U) | i;
+
+	queue_lock_release();
+
+	return DQ_OK;
 }
 
-int isca_queue_release(uint8_t queue_index) {
+/**
+ * @brief      Release a queue; its handle turns stale
+ * @param[in]  q_handle Queue handle
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_STALE
+ */
+int isca_queue_release(isca_qhandle_t q_handle) {
+
+	uint16_t i = (uint16_t)DQ_H_INDEX(q_handle);
+
+	queue_lock_acquire();
 
-	if ( ( available_queues >> queue_index ) & 1U ) {
-		queue_slots[queue_index] = 0U;
-		queue[queue_index].rd_ptr = 0U;
-		queue[queue_index].wr_ptr = 0U;
-		available_queues ^= ((uint32_t) 1U << queue_index); //release queue
-	} /*queue occupied*/
-	else {
-		return DQ_AVAILABLE;
-	} /*queue is not occupied*/
+	if ( queue_lookup(q_handle) == NULL ) {
+		queue_lock_release();
+		return DQ_STALE;
+	} /*Not acquired, or already released*/
+
+	queue[i].mask   = 0U;
+	queue[i].rd_ptr = 0U;
+	queue[i].wr_ptr = 0U;
+	queue[i].gen    = (queue[i].gen == 0xFFFFU) ? 1U : (uint16_t)(queue[i].gen + 1U);
+	queue[i].next   = free_head;
+	free_head = i;
+
+	queue_lock_release();
 
 	return DQ_OK;
 }
@@ -131,32 +211,267 @@ int isca_queue_release(uint8_t queue_index) {
 /**
  * <@bug When asking from RX queue with \ref isca_queue_rd_ptr the library advances
  * the read pointer; it is possible that the slot (read pointer) might be overwritten
- * by a newly arrived frame.
+ * by a newly arrived frame. Use \ref isca_queue_peek_n and \ref isca_queue_release_n
+ * instead.
  * */
-int isca_queue_rd_ptr(uint8_t q_index, uint8_t *queue_rd_ptr) {
+int isca_queue_rd_ptr(isca_qhandle_t q_handle, uint32_t *queue_rd_ptr) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+	uint32_t rd;
+
+	if ( q == NULL ) {
+		return DQ_STALE;
+	} /*Invalid handle*/
 
-	if ( queue[q_index].rd_ptr == queue[q_index].wr_ptr ) {
-		return DQ_EMPTY;
-	} /*Queue empty*/
+	do {
+		rd = q->rd_ptr;
+		if ( rd == q->wr_ptr ) {
+			return DQ_EMPTY;
+		} /*Queue empty*/
+	} while ( !__atomic_compare_exchange_n(&q->rd_ptr, &rd, rd + 1U, 0,
+	                                       __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) );
 
-	*queue_rd_ptr = (uint8_t) queue[q_index].rd_ptr;
-	queue[q_index].rd_ptr = (queue[q_index].rd_ptr + 1) % queue_slots[q_index];
+	*queue_rd_ptr = rd & q->mask;
 
 	return DQ_OK;
 }
 
-int isca_queue_wr_ptr(uint8_t q_index, uint8_t *queue_wr_index) {
+/**
+ * @brief      Claim the next write slot, applying the overflow policy on a full queue
+ * @note       The slot is published before being written; producers racing a
+ *             consumer should use \ref isca_queue_reserve_n and \ref isca_queue_commit_n
+ * @param[in]  q_handle Queue handle
+ * @param[out] queue_wr_index Slot index
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_FULL, for \ref DQ_DROP_NEWEST and \ref DQ_BLOCK queues
+ * @retval     \ref DQ_STALE
+ */
+int isca_queue_wr_ptr(isca_qhandle_t q_handle, uint32_t *queue_wr_index) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+	uint32_t wr;
+	uint32_t rd;
+
+	if ( q == NULL ) {
+		return DQ_STALE;
+	} /*Invalid handle*/
 
-	uint8_t next_wr_index;
+	wr = q->wr_ptr;
+	rd = q->rd_ptr;
+	if ( wr - rd > q->mask ) {
 
-	next_wr_index = (queue[q_index].wr_ptr + 1) % queue_slots[q_index];
+		if ( q->policy != DQ_DROP_OLDEST ) {
+			if ( q->policy == DQ_DROP_NEWEST ) {
+				__atomic_fetch_add(&q->drops, 1U, __ATOMIC_RELAXED);
+			}
+			return DQ_FULL;
+		} /*Refuse the new element*/
+
+		/*Evict the oldest; losing the race means the consumer freed it*/
+		if ( __atomic_compare_exchange_n(&q->rd_ptr, &rd, rd + 1U, 0,
+		                                 __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) ) {
+			__atomic_fetch_add(&q->drops, 1U, __ATOMIC_RELAXED);
+		}
 
-	if ( next_wr_index == queue[q_index].rd_ptr ) {
-		return DQ_FULL;
 	} /*Queue full*/
 
-	*queue_wr_index = (uint8_t) (queue[q_index].wr_ptr);
-	queue[q_index].wr_ptr = next_wr_index;
+	*queue_wr_index = wr & q->mask;
+	q->wr_ptr = wr + 1U;
+
+	return DQ_OK;
+}
+
+/**
+ * @brief      Queue occupancy
+ * @param[in]  q_handle Queue handle
+ * @retval     Amount of occupied slots, 0 for a stale handle
+ */
+uint32_t isca_queue_count(isca_qhandle_t q_handle) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+
+	return (q == NULL) ? 0U : q->wr_ptr - q->rd_ptr;
+
+}
+
+/**
+ * @brief      Queue capacity
+ * @param[in]  q_handle Queue handle
+ * @retval     Amount of slots, a power of two; 0 for a stale handle
+ */
+uint32_t isca_queue_size(isca_qhandle_t q_handle) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+
+	return (q == NULL) ? 0U : q->mask + 1U;
+
+}
+
+/**
+ * @brief      Queue overflow policy
+ * @param[in]  q_handle Queue handle
+ * @retval     \ref DQ_DROP_NEWEST, \ref DQ_DROP_OLDEST or \ref DQ_BLOCK
+ * @retval     \ref DQ_STALE
+ */
+int isca_queue_policy(isca_qhandle_t q_handle) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+
+	return (q == NULL) ? DQ_STALE : (int)q->policy;
+
+}
+
+/**
+ * @brief      Elements lost to the overflow policy since acquired
+ * @param[in]  q_handle Queue handle
+ * @retval     Drop count, 0 for a stale handle
+ */
+uint32_t isca_queue_drops(isca_qhandle_t q_handle) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+
+	return (q == NULL) ? 0U : __atomic_load_n(&q->drops, __ATOMIC_RELAXED);
+
+}
+
+/**
+ * @brief      Account elements refused by the producer, e.g., when draining
+ *             a source into a full \ref DQ_DROP_NEWEST queue
+ * @param[in]  q_handle Queue handle
+ * @param[in]  n        Amount of elements
+ * @return     None
+ */
+void isca_queue_drop_n(isca_qhandle_t q_handle, uint32_t n) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+
+	if ( q != NULL ) {
+		__atomic_fetch_add(&q->drops, n, __ATOMIC_RELAXED);
+	}
+
+}
+
+/**
+ * @brief      Reserve up to n slots for writing, without publishing them
+ *
+ * A \ref DQ_DROP_OLDEST queue makes room by evicting its oldest elements,
+ * counted as drops; other queues grant only the free slots.
+ * @param[in]  q_handle Queue handle
+ * @param[in]  n        Slots wanted
+ * @param[out] span     Reserved slots
+ * @retval     Amount of slots reserved, 0 if full or stale
+ */
+uint32_t isca_queue_reserve_n(isca_qhandle_t q_handle, uint32_t n, isca_qspan_s *span) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+	uint32_t wr;
+	uint32_t rd;
+	uint32_t room;
+
+	if ( q == NULL ) {
+		return 0U;
+	} /*Invalid handle*/
+
+	if ( n > q->mask + 1U ) {
+		n = q->mask + 1U;
+	}
+
+	wr   = q->wr_ptr;
+	rd   = __atomic_load_n(&q->rd_ptr, __ATOMIC_ACQUIRE);
+	room = (q->mask + 1U) - (wr - rd);
+
+	while ( room < n && q->policy == DQ_DROP_OLDEST ) {
+		if ( __atomic_compare_exchange_n(&q->rd_ptr, &rd, rd + (n - room), 0,
+		                                 __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) {
+			__atomic_fetch_add(&q->drops, n - room, __ATOMIC_RELAXED);
+			room = n;
+		}
+		else {
+			room = (q->mask + 1U) - (wr - rd);
+		} /*Consumer moved; rd reloaded*/
+	} /*Evict the oldest*/
+
+	if ( n > room ) {
+		n = room;
+	}
+
+	queue_span(q, wr, n, span);
+
+	return n;
+}
+
+/**
+ * @brief      Publish n written slots of the last \ref isca_queue_reserve_n
+ * @param[in]  q_handle Queue handle
+ * @param[in]  n        Slots written, up to the reserved amount
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_STALE
+ */
+int isca_queue_commit_n(isca_qhandle_t q_handle, uint32_t n) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+
+	if ( q == NULL ) {
+		return DQ_STALE;
+	} /*Invalid handle*/
+
+	__atomic_store_n(&q->wr_ptr, q->wr_ptr + n, __ATOMIC_RELEASE);
+
+	return DQ_OK;
+}
+
+/**
+ * @brief      Peek up to n elements for reading, without recycling them
+ * @param[in]  q_handle Queue handle
+ * @param[in]  n        Elements wanted
+ * @param[out] span     Peeked slots
+ * @retval     Amount of elements peeked, 0 if empty or stale
+ */
+uint32_t isca_queue_peek_n(isca_qhandle_t q_handle, uint32_t n, isca_qspan_s *span) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+	uint32_t rd;
+	uint32_t avail;
+
+	if ( q == NULL ) {
+		return 0U;
+	} /*Invalid handle*/
+
+	rd    = __atomic_load_n(&q->rd_ptr, __ATOMIC_ACQUIRE);
+	avail = __atomic_load_n(&q->wr_ptr, __ATOMIC_ACQUIRE) - rd;
+
+	if ( n > avail ) {
+		n = avail;
+	}
+
+	queue_span(q, rd, n, span);
+
+	return n;
+}
+
+/**
+ * @brief      Recycle n elements of a \ref isca_queue_peek_n batch, once copied
+ * @param[in]  q_handle Queue handle
+ * @param[in]  span     Peeked slots
+ * @param[in]  n        Elements consumed, up to the peeked amount
+ * @retval     \ref DQ_OK
+ * @retval     \ref DQ_LOST, the batch was evicted while being read; discard
+ *             the copies and peek again
+ * @retval     \ref DQ_STALE
+ */
+int isca_queue_release_n(isca_qhandle_t q_handle, isca_qspan_s const *span, uint32_t n) {
+
+	volatile isca_data_queue_indexer *q = queue_lookup(q_handle);
+	uint32_t rd = span->pos;
+
+	if ( q == NULL ) {
+		return DQ_STALE;
+	} /*Invalid handle*/
+
+	if ( !__atomic_compare_exchange_n(&q->rd_ptr, &rd, rd + n, 0,
+	                                  __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) ) {
+		return DQ_LOST;
+	} /*Producer evicted the batch*/
 
 	return DQ_OK;
 }
@@ -165,7 +480,42 @@ int isca_queue_wr_ptr(uint8_t q_index, uint8_t *queue_wr_index) {
  * LOCAL FUNCTIONS DEFINITION
  ******/
 void queue_lock_acquire() {
+
+	while ( __atomic_test_and_set(&registry_lock, __ATOMIC_ACQUIRE) ) {
+		while ( __atomic_load_n(&registry_lock, __ATOMIC_RELAXED) ) {
+		} /*Spin on a plain load, not on the bus locking exchange*/
+	}
+
 }
 
 void queue_lock_release() {
+
+	__atomic_clear(&registry_lock, __ATOMIC_RELEASE);
+
+}
+
+/*Handle to registry entry; NULL if out of range or stale*/
+static volatile isca_data_queue_indexer *queue_lookup(isca_qhandle_t q_handle) {
+
+	uint32_t i = DQ_H_INDEX(q_handle);
+
+	if ( i >= MAX_QUEUES || queue[i].gen != DQ_H_GEN(q_handle) || queue[i].next != DQ_INUSE ) {
+		return NULL;
+	}
+
+	return &queue[i];
+}
+
+/*Split n slots from counter pos into spans at the wrap point*/
+static void queue_span(volatile isca_data_queue_indexer *q, uint32_t pos, uint32_t n, isca_qspan_s *span) {
+
+	uint32_t idx = pos & q->mask;
+	uint32_t end = q->mask + 1U - idx;
+
+	span->pos    = pos;
+	span->idx[0] = idx;
+	span->len[0] = (n < end) ? n : end;
+	span->idx[1] = 0U;
+	span->len[1] = n - span->len[0];
+
 }
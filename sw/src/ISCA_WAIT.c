@@ -0,0 +1,202 @@
+/*  ******************************************************************************\
+ * /------------------------------------------------------------------------------/
+ * |-- Title      : ISCA wait primitive
+ * |-- Project    : CAN-bus Controller
+ * |#----------------------------------------------------------------------------#
+ * |-- File       : ISCA_WAIT.c
+ * |-- Author     : Othon Tomoutzoglou  <otto_sta@hotmail.com>
+ * |-- Company    : Hellenic Mediterranean University, department of
+ * |--              Electrical & Computer Engineering, ISCA-lab
+ * |-- URL        : http://isca.hmu.gr/
+ * |-- Created    : 2026-10-19
+ * |-- Last update: 2026-10-19
+ * |-- License    :
+ * |--   This program is free software: you can redistribute it and/or modify
+ * |--   it under the terms of the GNU General Public License as published by
+ * |--   the Free Software Foundation, either version 3 of the License, or
+ * |--   (at your option) any later version.
+ * |--
+ * |--   This program is distributed in the hope that it will be useful,
+ * |--   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * |--   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * |--   GNU General Public License for more details.
+ * |--
+ * |--   You should have received a copy of the GNU General Public License
+ * |--   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * |-- 
+ * |-- Platform   :
+ * |-- Standard   :
+ * |#----------------------------------------------------------------------------#
+ * |-- Description:
+ * |#----------------------------------------------------------------------------#
+ * |-- Copyright (c) 2026
+ * |#----------------------------------------------------------------------------#
+ * |-- Revisions  :
+ * |-- Date        Version  Author  Description
+ * |-- 2026-10-19  1.0      Otto    Created
+ * \#-----------------------------------------------------------------------------\
+ * *******************************************************************************/
+
+
+/**
+ * @file ISCA_WAIT.c
+ *
+ * @brief Event wait primitive used by the blocking receive requests
+ *
+ * A waiter takes a snapshot of the event counter with
+ * \ref isca_wait_prepare, re-checks its condition (e.g., queue empty) and
+ * blocks with \ref isca_wait_block until the counter moves; an event
+ * signalled between the snapshot and the block is never lost. The backend
+ * is selected by \ref WAIT_MODE.
+ *
+ * @author Othon Tomoutzoglou
+ *
+ * Contact: <otto_sta@hotmail.com>
+ *
+ * @version 1.0
+ *
+ */
+
+/******
+ * HEADERS
+ ******/
+#include "ISCA_WAIT.h"
+#include "ISCA_IO.h"
+
+#if (WAIT_MODE == WAIT_PTHREAD)
+#include <time.h>
+#endif // (WAIT_MODE == WAIT_PTHREAD)
+
+/******
+ * FUNCTIONS DEFINITION
+ ******/
+/**
+ * @brief      Initialize a wait object
+ * @param[out] wait  Wait object pointer
+ * @return     None
+ */
+void isca_wait_init(isca_wait_s *wait) {
+
+#if (WAIT_MODE == WAIT_PTHREAD)
+	pthread_condattr_t attr;
+
+	pthread_mutex_init(&wait->lock, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&wait->cond, &attr);
+	pthread_condattr_destroy(&attr);
+#endif // (WAIT_MODE == WAIT_PTHREAD)
+
+	wait->seq = 0U;
+
+}
+
+/**
+ * @brief      Snapshot the event counter before checking the wait condition
+ * @param[in]  wait  Wait object pointer
+ * @return     Event counter snapshot, to pass to \ref isca_wait_block
+ */
+uint32_t isca_wait_prepare(isca_wait_s *wait) {
+
+	return __atomic_load_n(&wait->seq, __ATOMIC_ACQUIRE);
+
+}
+
+/**
+ * @brief      Block until an event is signalled after the snapshot
+ * @param[in]  wait      Wait object pointer
+ * @param[in]  seq       Snapshot returned by \ref isca_wait_prepare
+ * @param[in]  deadline  Absolute deadline in \ref ISCA_TIME_Us ticks,
+ *                       NULL to wait forever
+ * @return     \ref WAIT_OK
+ * @return     \ref WAIT_TIMEOUT
+ */
+int isca_wait_block(isca_wait_s *wait, uint32_t seq, uint32_t const *deadline) {
+
+#if (WAIT_MODE == WAIT_PTHREAD)
+	int32_t remain;
+	struct timespec ts;
+	int ret_val = WAIT_OK;
+
+	pthread_mutex_lock(&wait->lock);
+
+	while ( __atomic_load_n(&wait->seq, __ATOMIC_ACQUIRE) == seq ) {
+
+		if ( deadline == NULL ) {
+			pthread_cond_wait(&wait->cond, &wait->lock);
+			continue;
+		} /*No deadline*/
+
+		remain = (int32_t)(*deadline - ISCA_TIME_Us());
+		if ( remain <= 0 ) {
+			ret_val = WAIT_TIMEOUT;
+			break;
+		} /*Deadline passed*/
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		ts.tv_sec  += remain / 1000000;
+		ts.tv_nsec += (long)(remain % 1000000) * 1000L;
+		if ( ts.tv_nsec >= 1000000000L ) {
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000L;
+		}
+		pthread_cond_timedwait(&wait->cond, &wait->lock, &ts);
+	}
+
+	pthread_mutex_unlock(&wait->lock);
+
+	return ret_val;
+#else
+	while ( __atomic_load_n(&wait->seq, __ATOMIC_ACQUIRE) == seq ) {
+
+		if ( deadline != NULL && (int32_t)(ISCA_TIME_Us() - *deadline) >= 0 ) {
+			return WAIT_TIMEOUT;
+		} /*Deadline passed*/
+
+#if (WAIT_MODE == WAIT_HOOK)
+		__WAIT_IDLE();
+#endif // (WAIT_MODE == WAIT_HOOK)
+	}
+
+	return WAIT_OK;
+#endif // (WAIT_MODE == WAIT_PTHREAD)
+
+}
+
+/**
+ * @brief      Signal an event, waking up all the waiters
+ * @param[in]  wait  Wait object pointer
+ * @return     None
+ */
+void isca_wait_signal(isca_wait_s *wait) {
+
+	__atomic_add_fetch(&wait->seq, 1U, __ATOMIC_RELEASE);
+
+#if (WAIT_MODE == WAIT_PTHREAD)
+	pthread_mutex_lock(&wait->lock);
+	pthread_cond_broadcast(&wait->cond);
+	pthread_mutex_unlock(&wait->lock);
+#elif (WAIT_MODE == WAIT_HOOK)
+	__WAIT_WAKE();
+#endif // (WAIT_MODE == WAIT_PTHREAD)
+
+}
+
+/**
+ * @brief      Yield the CPU between two polls of the controller
+ *
+ * Sleeps \ref POLL_PERIOD_US in \ref WAIT_PTHREAD mode; returns at once
+ * otherwise, as no interrupt is expected to wake the CPU up in polling mode
+ * @return     None
+ */
+void isca_wait_relax(void) {
+
+#if (WAIT_MODE == WAIT_PTHREAD)
+	struct timespec ts;
+
+	ts.tv_sec  = POLL_PERIOD_US / 1000000U;
+	ts.tv_nsec = (long)(POLL_PERIOD_US % 1000000U) * 1000L;
+	nanosleep(&ts, NULL);
+#endif // (WAIT_MODE == WAIT_PTHREAD)
+
+}
@@ -34,6 +34,8 @@
  * |                Available Options List:
  * |                 - APPRISE_MODE: APP_POLL(0) / APP_IRQ(1), poll or irq mode
  * |                 - CAN_MODE: CAN_2A(0) / CAN_2B(1), basic or extended mode
+ * |                   of the example's controller; other controllers of the
+ * |                   same build may run either mode
  * |                 - RX_QUEUE_SIZE: Integer, SW RX CAN frames queue size
  * |                                  attached to the controller instance
  * |                 - CAN0_BASEADDR: Integer, CAN controller's physical address
@@ -129,27 +131,29 @@ int config_can(can_ctrl_s *CanInstancePtr) {
 	 *  - Enable extended frame format (29-bit header) if CAN_MODE=CAN_2B
 	 **/
 	CanInstancePtr->addr          = CAN0_BASEADDR;
+	CanInstancePtr->can_mode      = CAN_MODE;
 	CanInstancePtr->brp           = 9U;
 	CanInstancePtr->tseg1         = 1U;
 	CanInstancePtr->tseg2         = 1U;
 	CanInstancePtr->sjw           = 1U;
 	CanInstancePtr->irqs_en.rx    = CAN_IRQ_ON;  /// Enable RX interrupt
 	CanInstancePtr->irqs_en.tx    = CAN_IRQ_OFF; /// Disable TX interrupt
-#if !(CAN_MODE == CAN_2B)
-	CanInstancePtr->mask          = 0x3FF;
-	CanInstancePtr->code          = 0x400;
-	CanInstancePtr->irqs_en.err0  = IRQ_ON; /// Enable RX FIFO overrun interrupt
-	CanInstancePtr->irqs_en.err1  = IRQ_ON; /// Enable Error interrupt
-#else
-	CanInstancePtr->frm_md        = CAN_FRAME_EXT;
-	CanInstancePtr->mask          = 0x0FFFFFFF;  // check only ID[28]
-	CanInstancePtr->code          = 0x10000000;  // check if ID[28]='1'
-	CanInstancePtr->irqs_en.err0  = CAN_IRQ_ON; /// Enable Error warning interrupt
-	CanInstancePtr->irqs_en.err1  = CAN_IRQ_ON; /// Enable RX FIFO overrun interrupt
-	CanInstancePtr->irqs_en.err2  = CAN_IRQ_ON; /// Enable Error passive IRQ interrupt
-	CanInstancePtr->irqs_en.err3  = CAN_IRQ_ON; /// Enable Arbitration lost interrupt
-	CanInstancePtr->irqs_en.err4  = CAN_IRQ_ON; /// Enable Bus error interrupt
-#endif // !(CAN_MODE == CAN_2B)
+	if ( CanInstancePtr->can_mode == CAN_2A ) {
+		CanInstancePtr->mask          = 0x3FF;
+		CanInstancePtr->code          = 0x400;
+		CanInstancePtr->irqs_en.err0  = CAN_IRQ_ON; /// Enable RX FIFO overrun interrupt
+		CanInstancePtr->irqs_en.err1  = CAN_IRQ_ON; /// Enable Error interrupt
+	}
+	else {
+		CanInstancePtr->frm_md        = CAN_FRAME_EXT;
+		CanInstancePtr->mask          = 0x0FFFFFFF;  // check only ID[28]
+		CanInstancePtr->code          = 0x10000000;  // check if ID[28]='1'
+		CanInstancePtr->irqs_en.err0  = CAN_IRQ_ON; /// Enable Error warning interrupt
+		CanInstancePtr->irqs_en.err1  = CAN_IRQ_ON; /// Enable RX FIFO overrun interrupt
+		CanInstancePtr->irqs_en.err2  = CAN_IRQ_ON; /// Enable Error passive IRQ interrupt
+		CanInstancePtr->irqs_en.err3  = CAN_IRQ_ON; /// Enable Arbitration lost interrupt
+		CanInstancePtr->irqs_en.err4  = CAN_IRQ_ON; /// Enable Bus error interrupt
+	}
 
 #if !(APPRISE_MODE==APP_IRQ)
 	CanInstancePtr->irq         = CAN_IRQ_OFF;
@@ -166,9 +170,7 @@ void can_example(can_ctrl_s *CanInstancePtr, can_frame_s *CanFrm) {
 #if !(CAN0_ROLE==CAN_RX)
 	/*TX*/
 	CanFrm->ID      = 0x10AB0003;
-#if (CAN_MODE == CAN_2B)
-	CanFrm->IDE     = CAN_FRAME_EXT;
-#endif // (CAN_MODE == CAN_2B)
+	CanFrm->IDE     = (CanInstancePtr->can_mode == CAN_2B) ? CAN_FRAME_EXT : CAN_FRAME_STD;
 	CanFrm->DLC     = 2U;
 	CanFrm->DATA[0] = 0xAA;
 	CanFrm->DATA[1] = 0xBB;